@@ -0,0 +1,53 @@
+#include <memory>
+#include "../src/elem_tuple.h"
+#include "../src/ndarray.h"
+#include "../src/ndarray_view_cast.h"
+#include "support/benchmark.h"
+#include "support/elem.h"
+
+using namespace tlz;
+using namespace tlz::bench;
+
+// ndarray_view_cast from elem_tuple view to view of one member, and access through the casted view
+
+namespace {
+
+template<typename Tuple, typename Member>
+void add_cast_cases(const ndsize<2>& shp, const std::string& tuple_name) {
+	using array_type = ndarray<2, Tuple>;
+	using array_ptr = std::shared_ptr<array_type>;
+	using member_view_type = ndarray_view<2, Member>;
+	benchmark_case cas;
+	cas.params = { {"tuple", tuple_name}, {"shape", shape_string(shp)}, {"elem_size", elem_size_param<Member>()} };
+
+	cas.name = "cast/elem_tuple";
+	cas.items = 1;
+	cas.setup = [shp]() -> operation {
+		array_ptr arr = std::make_shared<array_type>(shp);
+		return [arr]() { do_not_optimize(ndarray_view_cast<member_view_type>(arr->view()).start()); };
+	};
+	add(cas);
+
+	cas.name = "cast/elem_tuple_member_assign";
+	cas.items = shp.product();
+	cas.bytes = cas.items * sizeof(Member) + cas.items * sizeof(Member);
+	cas.setup = [shp]() -> operation {
+		array_ptr arr = std::make_shared<array_type>(shp);
+		auto values = std::make_shared<ndarray<2, Member>>(shp);
+		std::size_t i = 0;
+		for(Member& x : values->view()) x = sample_value<Member>(i++);
+		return [arr, values]() { ndarray_view_cast<member_view_type>(arr->view()).assign(values->cview()); };
+	};
+	add(cas);
+}
+
+
+registrar reg([] {
+	for(const ndsize<2>& shp : { make_ndsize(64, 64), make_ndsize(512, 512) }) {
+		add_cast_cases<elem_tuple<float, int>, float>(shp, "float,int");
+		add_cast_cases<elem_tuple<std::uint8_t, double>, double>(shp, "uint8,double");
+		add_cast_cases<elem_tuple<vec3_elem, float>, vec3_elem>(shp, "vec3,float");
+	}
+});
+
+}
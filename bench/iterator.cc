@@ -0,0 +1,73 @@
+#include <memory>
+#include "../src/ndarray.h"
+#include "../src/ndarray_view_operations.h"
+#include "support/benchmark.h"
+#include "support/elem.h"
+
+using namespace tlz;
+using namespace tlz::bench;
+
+// ndarray_iterator increment and index_to_coordinates, for each dimension, element size and shape
+
+namespace {
+
+template<typename T, std::size_t Dim>
+void add_iterator_cases(const ndsize<Dim>& shp) {
+	using array_type = ndarray<Dim, T>;
+	using array_ptr = std::shared_ptr<array_type>;
+	benchmark_case cas;
+	cas.items = shp.product();
+
+	cas.name = "iterator/increment";
+	cas.params = { {"layout", "dense"}, {"shape", shape_string(shp)}, {"elem_size", elem_size_param<T>()} };
+	cas.bytes = cas.items * sizeof(T);
+	cas.setup = [shp]() -> operation {
+		array_ptr arr = std::make_shared<array_type>(shp);
+		return [arr]() {
+			for(auto it = arr->view().begin(), end = arr->view().end(); it != end; ++it) do_not_optimize(*it);
+		};
+	};
+	add(cas);
+
+	cas.name = "iterator/increment";
+	cas.params[0].second = "reversed";
+	cas.setup = [shp]() -> operation {
+		array_ptr arr = std::make_shared<array_type>(shp);
+		return [arr]() {
+			auto vw = reverse_all(arr->view());
+			for(auto it = vw.begin(), end = vw.end(); it != end; ++it) do_not_optimize(*it);
+		};
+	};
+	add(cas);
+
+	cas.name = "iterator/index_to_coordinates";
+	cas.params = { {"shape", shape_string(shp)}, {"elem_size", elem_size_param<T>()} };
+	cas.bytes = 0;
+	cas.setup = [shp]() -> operation {
+		array_ptr arr = std::make_shared<array_type>(shp);
+		return [arr]() {
+			auto vw = arr->view();
+			std::ptrdiff_t n = vw.size();
+			for(std::ptrdiff_t i = 0; i < n; ++i) do_not_optimize(vw.index_to_coordinates(i));
+		};
+	};
+	add(cas);
+}
+
+
+template<typename T>
+void add_elem_cases() {
+	add_iterator_cases<T>(make_ndsize(1 << 16));
+	add_iterator_cases<T>(make_ndsize(256, 256));
+	add_iterator_cases<T>(make_ndsize(4096, 16));
+	add_iterator_cases<T>(make_ndsize(32, 32, 64));
+}
+
+
+registrar reg([] {
+	add_elem_cases<std::uint8_t>();
+	add_elem_cases<float>();
+	add_elem_cases<vec3_elem>();
+});
+
+}
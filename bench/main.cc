@@ -0,0 +1,74 @@
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <exception>
+#include <string>
+#include <vector>
+#include "support/benchmark.h"
+
+using namespace tlz::bench;
+
+namespace {
+
+void print_usage(const char* program) {
+	std::printf(
+		"usage: %s [options]\n"
+		"  --filter STR     only run benchmarks whose name or parameters contain STR\n"
+		"  --json PATH      write results as JSON to PATH\n"
+		"  --samples N      number of timed samples (default 15)\n"
+		"  --sample-ms MS   minimal duration of one sample (default 10)\n"
+		"  --warmup-ms MS   warm-up duration (default 50)\n"
+		"  --list           list benchmarks without running them\n",
+		program);
+}
+
+std::string case_label(const benchmark_case& cas) {
+	std::string label = cas.name;
+	for(const auto& param : cas.params) label += " " + param.first + "=" + param.second;
+	return label;
+}
+
+}
+
+
+int main(int argc, char* argv[]) {
+	benchmark_settings settings;
+	std::string json_path;
+	bool list = false;
+
+	for(int i = 1; i < argc; ++i) {
+		std::string arg = argv[i];
+		bool has_value = (i + 1 < argc);
+		if(arg == "--filter" && has_value) settings.filter = argv[++i];
+		else if(arg == "--json" && has_value) json_path = argv[++i];
+		else if(arg == "--samples" && has_value) settings.samples = std::max(1, std::atoi(argv[++i]));
+		else if(arg == "--sample-ms" && has_value) settings.sample_seconds = std::atof(argv[++i]) / 1000.0;
+		else if(arg == "--warmup-ms" && has_value) settings.warmup_seconds = std::atof(argv[++i]) / 1000.0;
+		else if(arg == "--list") list = true;
+		else { print_usage(argv[0]); return (arg == "--help") ? EXIT_SUCCESS : EXIT_FAILURE; }
+	}
+
+	std::vector<benchmark_result> results;
+	try {
+		if(! list)
+			std::printf("%-64s %12s %12s %12s %10s %10s\n", "benchmark", "median ns", "p10 ns", "p90 ns", "ns/item", "GB/s");
+		for(const benchmark_case& cas : registered_cases()) {
+			std::string label = case_label(cas);
+			if(label.find(settings.filter) == std::string::npos) continue;
+			if(list) { std::printf("%s\n", label.c_str()); continue; }
+
+			benchmark_result res = run(cas, settings);
+			double gbps = (cas.bytes > 0) ? cas.bytes / res.median_ns : 0.0;
+			std::printf("%-64s %12.1f %12.1f %12.1f %10.3f %10.2f\n",
+				label.c_str(), res.median_ns, res.p10_ns, res.p90_ns, res.median_ns / cas.items, gbps);
+			std::fflush(stdout);
+			results.push_back(res);
+		}
+		if(! json_path.empty()) write_json(json_path, settings, results);
+	} catch(const std::exception& ex) {
+		std::fprintf(stderr, "error: %s\n", ex.what());
+		return EXIT_FAILURE;
+	}
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,60 @@
+#include <cstring>
+#include <memory>
+#include "../src/opaque/ndarray_opaque.h"
+#include "../src/opaque_format/ndarray.h"
+#include "support/benchmark.h"
+#include "support/elem.h"
+
+using namespace tlz;
+using namespace tlz::bench;
+
+// copies of opaque frames, one by one and as whole view, with contiguous and padded frame formats
+
+namespace {
+
+void add_opaque_cases(std::size_t frames, const ndsize<2>& frame_shp, std::size_t elem_size, bool padded) {
+	using array_type = ndarray_opaque<1, opaque_ndarray_format>;
+	using array_ptr = std::shared_ptr<array_type>;
+	std::size_t elem_stride = padded ? 2 * elem_size : elem_size;
+	opaque_ndarray_format frm(elem_size, elem_size, elem_stride, true, frame_shp);
+
+	benchmark_case cas;
+	cas.params = {
+		{"frames", std::to_string(frames)}, {"frame_shape", shape_string(frame_shp)},
+		{"elem_size", std::to_string(elem_size)}, {"frame_layout", padded ? "padded" : "contiguous"}
+	};
+	cas.items = frames;
+	cas.bytes = 2 * frames * frame_shp.product() * elem_size;
+
+	auto make_array = [frames, frm]() {
+		array_ptr arr = std::make_shared<array_type>(make_ndsize(frames), frm);
+		std::memset(arr->start(), 1, frames * arr->strides().front());
+		return arr;
+	};
+
+	cas.name = "opaque/frame_copy";
+	cas.setup = [make_array, frames]() -> operation {
+		array_ptr a = make_array(), b = make_array();
+		return [a, b, frames]() {
+			for(std::ptrdiff_t i = 0; i < frames; ++i) a->view()[i] = b->cview()[i];
+		};
+	};
+	add(cas);
+
+	cas.name = "opaque/view_copy";
+	cas.setup = [make_array]() -> operation {
+		array_ptr a = make_array(), b = make_array();
+		return [a, b]() { a->view().assign(b->cview()); };
+	};
+	add(cas);
+}
+
+
+registrar reg([] {
+	for(std::size_t elem_size : { 1, 4, 8 }) for(bool padded : { false, true }) {
+		add_opaque_cases(1024, make_ndsize(4, 4), elem_size, padded);
+		add_opaque_cases(64, make_ndsize(64, 64), elem_size, padded);
+	}
+});
+
+}
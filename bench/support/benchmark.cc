@@ -0,0 +1,130 @@
+#include "benchmark.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <fstream>
+#include <numeric>
+#include <stdexcept>
+
+namespace tlz { namespace bench {
+
+namespace {
+
+using clock_type = std::chrono::steady_clock;
+
+double seconds_since(clock_type::time_point start) {
+	return std::chrono::duration<double>(clock_type::now() - start).count();
+}
+
+/// Run \a op \a n times, and return duration in seconds.
+double time_operations(const operation& op, std::size_t n) {
+	auto start = clock_type::now();
+	for(std::size_t i = 0; i < n; ++i) op();
+	clobber_memory();
+	return seconds_since(start);
+}
+
+/// Percentile \a p (0 to 1) of sorted \a values, with linear interpolation.
+double percentile(const std::vector<double>& values, double p) {
+	double pos = p * (values.size() - 1);
+	std::size_t i = static_cast<std::size_t>(pos);
+	if(i + 1 >= values.size()) return values.back();
+	double frac = pos - i;
+	return values[i] * (1.0 - frac) + values[i + 1] * frac;
+}
+
+std::string json_string(const std::string& str) {
+	std::string out = "\"";
+	for(char c : str) {
+		if(c == '"' || c == '\\') out += '\\';
+		out += c;
+	}
+	return out + "\"";
+}
+
+std::string json_number(double x) {
+	if(! std::isfinite(x)) return "null";
+	return std::to_string(x);
+}
+
+}
+
+
+std::vector<benchmark_case>& registered_cases() {
+	static std::vector<benchmark_case> cases;
+	return cases;
+}
+
+
+void add(const benchmark_case& cas) {
+	registered_cases().push_back(cas);
+}
+
+
+benchmark_result run(const benchmark_case& cas, const benchmark_settings& settings) {
+	benchmark_result res;
+	res.cas = &cas;
+	operation op = cas.setup();
+
+	// warm-up, and calibrate number of operations per sample, doubling it until one sample takes long enough
+	std::size_t n = 1;
+	auto warmup_start = clock_type::now();
+	for(;;) {
+		double t = time_operations(op, n);
+		if(t >= settings.sample_seconds) {
+			if(seconds_since(warmup_start) >= settings.warmup_seconds) break;
+		} else {
+			n *= 2;
+		}
+	}
+	res.operations_per_sample = n;
+
+	for(std::size_t s = 0; s < settings.samples; ++s) {
+		double t = time_operations(op, n);
+		res.sample_ns.push_back(t * 1.0e9 / n);
+	}
+
+	std::vector<double> sorted = res.sample_ns;
+	std::sort(sorted.begin(), sorted.end());
+	res.min_ns = sorted.front();
+	res.max_ns = sorted.back();
+	res.median_ns = percentile(sorted, 0.5);
+	res.p10_ns = percentile(sorted, 0.1);
+	res.p90_ns = percentile(sorted, 0.9);
+	res.mean_ns = std::accumulate(sorted.begin(), sorted.end(), 0.0) / sorted.size();
+	return res;
+}
+
+
+void write_json(const std::string& path, const benchmark_settings& settings, const std::vector<benchmark_result>& results) {
+	std::ofstream out(path);
+	if(! out) throw std::runtime_error("cannot open " + path);
+
+	out << "{\n";
+	out << "  \"settings\": {\"warmup_seconds\": " << json_number(settings.warmup_seconds)
+	    << ", \"sample_seconds\": " << json_number(settings.sample_seconds)
+	    << ", \"samples\": " << settings.samples << "},\n";
+	out << "  \"benchmarks\": [";
+	for(std::size_t i = 0; i < results.size(); ++i) {
+		const benchmark_result& res = results[i];
+		const benchmark_case& cas = *res.cas;
+		out << (i > 0 ? "," : "") << "\n    {\"name\": " << json_string(cas.name) << ", \"params\": {";
+		for(std::size_t j = 0; j < cas.params.size(); ++j)
+			out << (j > 0 ? ", " : "") << json_string(cas.params[j].first) << ": " << json_string(cas.params[j].second);
+		out << "}, \"items\": " << cas.items << ", \"bytes\": " << cas.bytes
+		    << ", \"operations_per_sample\": " << res.operations_per_sample
+		    << ", \"min_ns\": " << json_number(res.min_ns)
+		    << ", \"p10_ns\": " << json_number(res.p10_ns)
+		    << ", \"median_ns\": " << json_number(res.median_ns)
+		    << ", \"p90_ns\": " << json_number(res.p90_ns)
+		    << ", \"max_ns\": " << json_number(res.max_ns)
+		    << ", \"mean_ns\": " << json_number(res.mean_ns)
+		    << ", \"samples_ns\": [";
+		for(std::size_t j = 0; j < res.sample_ns.size(); ++j)
+			out << (j > 0 ? ", " : "") << json_number(res.sample_ns[j]);
+		out << "]}";
+	}
+	out << "\n  ]\n}\n";
+}
+
+}}
@@ -0,0 +1,99 @@
+#ifndef TFF_BENCHSUPPORT_BENCHMARK_H_
+#define TFF_BENCHSUPPORT_BENCHMARK_H_
+
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace tlz { namespace bench {
+
+/// Operation to be timed, returned by the setup function of a benchmark case.
+using operation = std::function<void()>;
+
+/// Benchmark case: named setup function which creates the data and returns the operation to time.
+/** The setup is not timed. \a params are reported along with the results, for example shape and element size.
+ ** \a items is the number of elements processed per operation, and \a bytes the number of bytes read and written,
+ ** used to report per-item time and throughput. */
+struct benchmark_case {
+	std::string name;
+	std::vector<std::pair<std::string, std::string>> params;
+	std::size_t items = 1;
+	std::size_t bytes = 0;
+	std::function<operation()> setup;
+};
+
+
+/// Timing settings, set from command line arguments.
+struct benchmark_settings {
+	double warmup_seconds = 0.05; ///< Time for which operation is run before timing.
+	double sample_seconds = 0.01; ///< Minimal duration of one sample, sets the number of operations per sample.
+	std::size_t samples = 15; ///< Number of timed samples.
+	std::string filter; ///< Only run cases whose name or parameters contain this string.
+};
+
+
+/// Timing results of a benchmark case. Times are nanoseconds per operation.
+struct benchmark_result {
+	const benchmark_case* cas;
+	std::size_t operations_per_sample = 0;
+	std::vector<double> sample_ns;
+	double min_ns = 0.0;
+	double median_ns = 0.0;
+	double mean_ns = 0.0;
+	double p10_ns = 0.0;
+	double p90_ns = 0.0;
+	double max_ns = 0.0;
+};
+
+
+/// All benchmark cases, in order of registration.
+std::vector<benchmark_case>& registered_cases();
+
+/// Register benchmark cases at static initialization, by calling \a func.
+struct registrar {
+	explicit registrar(const std::function<void()>& func) { func(); }
+};
+
+/// Add benchmark case.
+void add(const benchmark_case&);
+
+/// Run benchmark case \a cas with \a settings.
+benchmark_result run(const benchmark_case& cas, const benchmark_settings& settings);
+
+/// Write \a results as JSON document to \a path.
+void write_json(const std::string& path, const benchmark_settings& settings, const std::vector<benchmark_result>& results);
+
+/// Human readable string for \a shape, like `64x64`.
+template<typename Shape>
+std::string shape_string(const Shape& shape) {
+	std::string str;
+	for(std::size_t i = 0; i < shape.size(); ++i) {
+		if(i > 0) str += "x";
+		str += std::to_string(shape[i]);
+	}
+	return str;
+}
+
+/// Prevent compiler from optimizing away computation of \a value.
+template<typename T>
+inline void do_not_optimize(const T& value) {
+	#if defined(__GNUC__)
+	asm volatile("" : : "r,m"(value) : "memory");
+	#else
+	static volatile const void* sink;
+	sink = &value;
+	#endif
+}
+
+/// Prevent compiler from assuming memory is unchanged across this point.
+inline void clobber_memory() {
+	#if defined(__GNUC__)
+	asm volatile("" : : : "memory");
+	#endif
+}
+
+}}
+
+#endif
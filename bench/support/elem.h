@@ -0,0 +1,30 @@
+#ifndef TFF_BENCHSUPPORT_ELEM_H_
+#define TFF_BENCHSUPPORT_ELEM_H_
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace tlz { namespace bench {
+
+/// 12 byte element, whose size is not a power of two.
+using vec3_elem = std::array<float, 3>;
+
+/// Deterministic element value for index \a i.
+template<typename T>
+T sample_value(std::size_t i) { return static_cast<T>(i % 100); }
+
+template<>
+inline vec3_elem sample_value<vec3_elem>(std::size_t i) {
+	float f = static_cast<float>(i % 100);
+	return {{ f, f + 1.0f, f + 2.0f }};
+}
+
+/// Benchmark parameter value for element type \a T.
+template<typename T>
+std::string elem_size_param() { return std::to_string(sizeof(T)); }
+
+}}
+
+#endif
@@ -0,0 +1,123 @@
+#include <memory>
+#include "../src/ndarray.h"
+#include "../src/ndarray_view_operations.h"
+#include "../src/ndarray_wraparound_view.h"
+#include "support/benchmark.h"
+#include "support/elem.h"
+
+using namespace tlz;
+using namespace tlz::bench;
+
+// assign, compare and fill, for each kind of view layout, element size and shape
+
+namespace {
+
+struct dense_layout {
+	static const char* name() { return "dense"; }
+	static ndsize<2> storage_shape(const ndsize<2>& shp) { return shp; }
+	static std::size_t padding(std::size_t) { return 0; }
+	template<typename Array> static auto view(Array& arr) { return arr.view(); }
+	template<typename Array> static auto cview(const Array& arr) { return arr.cview(); }
+};
+
+struct strided_layout {
+	static const char* name() { return "strided"; }
+	static ndsize<2> storage_shape(const ndsize<2>& shp) { return make_ndsize(shp[0], 2 * shp[1]); }
+	static std::size_t padding(std::size_t) { return 0; }
+	template<typename Array> static auto view(Array& arr) { return step(arr.view(), 1, 2); }
+	template<typename Array> static auto cview(const Array& arr) { return step(arr.cview(), 1, 2); }
+};
+
+struct reversed_layout {
+	static const char* name() { return "reversed"; }
+	static ndsize<2> storage_shape(const ndsize<2>& shp) { return shp; }
+	static std::size_t padding(std::size_t) { return 0; }
+	template<typename Array> static auto view(Array& arr) { return reverse_all(arr.view()); }
+	template<typename Array> static auto cview(const Array& arr) { return reverse_all(arr.cview()); }
+};
+
+struct padded_layout {
+	static const char* name() { return "padded"; }
+	static ndsize<2> storage_shape(const ndsize<2>& shp) { return shp; }
+	static std::size_t padding(std::size_t elem_size) { return elem_size; }
+	template<typename Array> static auto view(Array& arr) { return arr.view(); }
+	template<typename Array> static auto cview(const Array& arr) { return arr.cview(); }
+};
+
+struct wraparound_layout {
+	static const char* name() { return "wraparound"; }
+	static ndsize<2> storage_shape(const ndsize<2>& shp) { return shp; }
+	static std::size_t padding(std::size_t) { return 0; }
+	template<typename Array> static auto view(Array& arr) { return wraparound(arr.view(), start(arr), end(arr)); }
+	template<typename Array> static auto cview(const Array& arr) { return wraparound(arr.cview(), start(arr), end(arr)); }
+
+	// starts in the middle, so that the view wraps around on both axes
+	template<typename Array> static ndptrdiff<2> start(const Array& arr)
+		{ return make_ndptrdiff(arr.shape()[0] / 2, arr.shape()[1] / 2); }
+	template<typename Array> static ndptrdiff<2> end(const Array& arr)
+		{ return start(arr) + ndptrdiff<2>(arr.shape()); }
+};
+
+
+template<typename T, typename Layout>
+void add_view_cases(const ndsize<2>& shp) {
+	using array_type = ndarray<2, T>;
+	using array_ptr = std::shared_ptr<array_type>;
+	benchmark_case cas;
+	cas.params = { {"layout", Layout::name()}, {"shape", shape_string(shp)}, {"elem_size", elem_size_param<T>()} };
+	cas.items = shp.product();
+
+	auto make_array = [shp]() {
+		array_ptr arr = std::make_shared<array_type>(Layout::storage_shape(shp), Layout::padding(sizeof(T)));
+		std::size_t i = 0;
+		for(T& x : arr->view()) x = sample_value<T>(i++);
+		return arr;
+	};
+
+	cas.name = "view/assign";
+	cas.bytes = 2 * cas.items * sizeof(T);
+	cas.setup = [make_array]() -> operation {
+		array_ptr a = make_array(), b = make_array();
+		return [a, b]() { Layout::view(*a).assign(Layout::cview(*b)); };
+	};
+	add(cas);
+
+	cas.name = "view/compare";
+	cas.setup = [make_array]() -> operation {
+		// equal contents, so that compare goes through all elements
+		array_ptr a = make_array(), b = make_array();
+		return [a, b]() { do_not_optimize(Layout::cview(*a).compare(Layout::cview(*b))); };
+	};
+	add(cas);
+
+	cas.name = "view/fill";
+	cas.bytes = cas.items * sizeof(T);
+	cas.setup = [make_array]() -> operation {
+		array_ptr a = make_array();
+		T value = sample_value<T>(7);
+		return [a, value]() { Layout::view(*a).fill(value); };
+	};
+	add(cas);
+}
+
+
+template<typename T>
+void add_elem_cases(const ndsize<2>& shp) {
+	add_view_cases<T, dense_layout>(shp);
+	add_view_cases<T, strided_layout>(shp);
+	add_view_cases<T, reversed_layout>(shp);
+	add_view_cases<T, padded_layout>(shp);
+	add_view_cases<T, wraparound_layout>(shp);
+}
+
+
+registrar reg([] {
+	for(const ndsize<2>& shp : { make_ndsize(64, 64), make_ndsize(512, 512), make_ndsize(4096, 8) }) {
+		add_elem_cases<std::uint8_t>(shp);
+		add_elem_cases<float>(shp);
+		add_elem_cases<double>(shp);
+		add_elem_cases<vec3_elem>(shp);
+	}
+});
+
+}
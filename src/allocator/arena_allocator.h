@@ -0,0 +1,165 @@
+#ifndef TLZ_ND_ARENA_ALLOCATOR_H_
+#define TLZ_ND_ARENA_ALLOCATOR_H_
+
+#include "../config.h"
+#if TLZ_ND_WITH_ALLOCATION
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include "../common.h"
+
+namespace tlz {
+
+/// Monotonic memory arena, from which allocations are made by incrementing a pointer.
+/** Memory is never freed individually: deallocation is a no-op, and reset() makes the whole arena available again.
+ ** Intended for temporary arrays which are all discarded together at the end of a processing cycle. All arrays
+ ** allocated from the arena must have been destructed before reset().
+ **
+ ** The arena owns a main buffer of capacity() bytes, or uses a buffer provided by the caller. When it is full and
+ ** overflow is allowed, additional blocks are allocated from `raw_allocator`. Otherwise `std::bad_alloc` is thrown.
+ ** Overflow blocks are released at reset(), and an owned main buffer then gets enlarged to the peak usage, so that
+ ** following cycles with the same allocations no longer overflow.
+ **
+ ** Not thread-safe. Not copyable, allocators \ref arena_allocator and \ref raw_arena_allocator refer to it. */
+class monotonic_arena {
+private:
+	struct overflow_block {
+		void* buffer;
+		std::size_t size;
+	};
+
+	void* buffer_ = nullptr; ///< Main buffer.
+	std::size_t capacity_ = 0; ///< Size of main buffer.
+	bool owns_buffer_ = false;
+	bool allow_overflow_ = true;
+
+	std::size_t offset_ = 0; ///< Used bytes in main buffer.
+	void* overflow_pointer_ = nullptr; ///< Next free byte in the last overflow block.
+	std::size_t overflow_remaining_ = 0; ///< Free bytes in the last overflow block.
+	std::vector<overflow_block> overflow_blocks_;
+	std::size_t used_ = 0; ///< Total bytes used in this cycle, including padding for alignment.
+	std::size_t peak_used_ = 0;
+
+	void* allocate_overflow_(std::size_t size, std::size_t alignment);
+	void release_overflow_();
+
+public:
+	/// Create arena with main buffer of \a capacity bytes, allocated from `raw_allocator`.
+	explicit monotonic_arena(std::size_t capacity, bool allow_overflow = true);
+
+	/// Create arena using existing \a buffer of \a capacity bytes. It does not get deallocated by the arena.
+	monotonic_arena(void* buffer, std::size_t capacity, bool allow_overflow = false);
+
+	monotonic_arena(const monotonic_arena&) = delete;
+	monotonic_arena& operator=(const monotonic_arena&) = delete;
+
+	~monotonic_arena();
+
+	/// Allocate \a size bytes aligned to \a alignment. O(1) unless the main buffer is full.
+	void* allocate(std::size_t size, std::size_t alignment = alignof(std::max_align_t)) {
+		std::uintptr_t start = reinterpret_cast<std::uintptr_t>(buffer_) + offset_;
+		std::size_t pad = (alignment - start % alignment) % alignment;
+		if(offset_ + pad + size > capacity_) return allocate_overflow_(size, alignment);
+		offset_ += pad + size;
+		used_ += pad + size;
+		return reinterpret_cast<void*>(start + pad);
+	}
+
+	/// Make the whole arena available again.
+	/** Releases overflow blocks, and enlarges an owned main buffer if there were any. */
+	void reset();
+
+	/// Size of the main buffer.
+	std::size_t capacity() const { return capacity_; }
+
+	/// Bytes used since last reset(), including padding and overflow.
+	std::size_t used() const { return used_; }
+
+	/// Largest value of used() in all cycles.
+	std::size_t peak_used() const { return peak_used_; }
+
+	/// Number of overflow blocks allocated since last reset().
+	std::size_t overflow_count() const { return overflow_blocks_.size(); }
+
+	bool allows_overflow() const { return allow_overflow_; }
+};
+
+
+/// Standard allocator for objects of type \a T which allocates from a \ref monotonic_arena.
+/** Usable as `Allocator` of \ref ndarray with `Elem = T`. A default-constructed allocator has no arena, and allocates
+ ** from `std::allocator<T>` instead. deallocate() is a no-op for memory from the arena. */
+template<typename T>
+class arena_allocator {
+	template<typename> friend class arena_allocator;
+
+private:
+	monotonic_arena* arena_ = nullptr;
+
+public:
+	using value_type = T;
+
+	template<typename U> struct rebind { using other = arena_allocator<U>; };
+
+	arena_allocator() = default;
+	arena_allocator(monotonic_arena& arena) : arena_(&arena) { }
+	template<typename U> arena_allocator(const arena_allocator<U>& alloc) : arena_(alloc.arena_) { }
+
+	monotonic_arena* arena() const { return arena_; }
+
+	T* allocate(std::size_t n) {
+		if(arena_ == nullptr) return std::allocator<T>().allocate(n);
+		else return static_cast<T*>(arena_->allocate(n * sizeof(T), alignof(T)));
+	}
+
+	void deallocate(T* ptr, std::size_t n) {
+		if(arena_ == nullptr) std::allocator<T>().deallocate(ptr, n);
+	}
+
+	template<typename U>
+	friend bool operator==(const arena_allocator& a, const arena_allocator<U>& b) { return a.arena_ == b.arena_; }
+	template<typename U>
+	friend bool operator!=(const arena_allocator& a, const arena_allocator<U>& b) { return a.arena_ != b.arena_; }
+};
+
+
+/// Raw allocator which allocates from a \ref monotonic_arena.
+/** Usable as `Allocator` of \ref ndarray_opaque, and of \ref ndarray with any `Elem`, with the runtime alignment
+ ** requirement. A default-constructed allocator has no arena, and allocates from `raw_allocator` instead.
+ ** raw_deallocate() is a no-op for memory from the arena. */
+class raw_arena_allocator {
+private:
+	monotonic_arena* arena_ = nullptr;
+
+public:
+	static std::size_t size_granularity() { return 1; }
+
+	raw_arena_allocator() = default;
+	raw_arena_allocator(monotonic_arena& arena) : arena_(&arena) { }
+
+	monotonic_arena* arena() const { return arena_; }
+
+	void* raw_allocate(std::size_t size, std::size_t alignment = 1) {
+		if(arena_ == nullptr) return raw_allocator().raw_allocate(size, alignment);
+		else return arena_->allocate(size, alignment);
+	}
+
+	void raw_deallocate(void* ptr, std::size_t size) {
+		if(arena_ == nullptr) raw_allocator().raw_deallocate(ptr, size);
+	}
+
+	friend bool operator==(const raw_arena_allocator& a, const raw_arena_allocator& b) { return a.arena_ == b.arena_; }
+	friend bool operator!=(const raw_arena_allocator& a, const raw_arena_allocator& b) { return a.arena_ != b.arena_; }
+};
+
+
+template<>
+constexpr bool is_raw_allocator<raw_arena_allocator> = true;
+
+}
+
+#include "arena_allocator.icc"
+
+#endif
+#endif
@@ -0,0 +1,86 @@
+#ifndef TLZ_ND_HUGE_PAGE_ALLOCATOR_H_
+#define TLZ_ND_HUGE_PAGE_ALLOCATOR_H_
+
+#include "../config.h"
+#if TLZ_ND_WITH_ALLOCATION && TLZ_ND_WITH_MMAP
+
+#include <cstddef>
+#include "../common.h"
+
+namespace tlz {
+
+/// Kind of pages used for allocation by \ref huge_page_allocator.
+enum class huge_page_mode {
+	normal, ///< Normal pages.
+	transparent, ///< Normal mapping advised for transparent huge pages with `madvise(MADV_HUGEPAGE)`.
+	hugetlb ///< Explicit huge pages from the reserved pool, with `mmap(MAP_HUGETLB)`.
+};
+
+
+/// Properties actually obtained for an allocation by \ref huge_page_allocator.
+struct huge_page_allocation {
+	huge_page_mode mode = huge_page_mode::normal;
+	bool populated = false; ///< All pages were faulted in at allocation.
+	bool locked = false; ///< Pages are locked in memory with `mlock`.
+};
+
+
+/// Raw allocator which maps large buffers with huge pages, optionally resident in memory.
+/** Huge pages reduce TLB misses for random access into large arrays. The requested mode is tried first, and on failure
+ ** it falls back to the next weaker mode: `hugetlb` needs pages reserved by the system administrator, and
+ ** `transparent` needs transparent huge pages enabled in `madvise` or `always` mode. With `transparent`, the kernel may
+ ** still use normal pages for parts of the buffer.
+ **
+ ** If \a populate is set, all pages are faulted in at allocation, so that there are no first-touch page faults later.
+ ** If \a lock is set, the pages are also locked in memory using `mlock`, which can fail due to `RLIMIT_MEMLOCK`. These
+ ** failures are not errors either. Only failure to map any memory throws `std::bad_alloc`.
+ **
+ ** Allocations are rounded up to a multiple of huge_page_size(), and aligned to it. The properties obtained for the
+ ** last allocation are returned by last_allocation(). The allocator inside an \ref ndarray can be queried using
+ ** `arr.get_allocator().last_allocation()`. */
+class huge_page_allocator {
+private:
+	huge_page_mode requested_mode_ = huge_page_mode::transparent;
+	bool populate_ = false;
+	bool lock_ = false;
+	huge_page_allocation last_allocation_;
+
+	void* map_(std::size_t size, huge_page_mode mode);
+	void populate_pages_(void* ptr, std::size_t size, huge_page_mode mode);
+
+public:
+	/// Default size of huge pages on the system, or 2 MiB if unknown.
+	static std::size_t huge_page_size();
+
+	static std::size_t size_granularity() { return 1; }
+
+	explicit huge_page_allocator(huge_page_mode mode = huge_page_mode::transparent, bool populate = false, bool lock = false) :
+		requested_mode_(mode), populate_(populate), lock_(lock) { }
+
+	/// Allocate \a size bytes. \a alignment cannot be larger than huge_page_size().
+	void* raw_allocate(std::size_t size, std::size_t alignment = 1);
+
+	/// Deallocate memory allocated with raw_allocate() with same \a size.
+	void raw_deallocate(void* ptr, std::size_t size);
+
+	huge_page_mode requested_mode() const { return requested_mode_; }
+	bool populates() const { return populate_; }
+	bool locks() const { return lock_; }
+
+	/// Properties obtained for the last allocation made with this allocator.
+	const huge_page_allocation& last_allocation() const { return last_allocation_; }
+
+	friend bool operator==(const huge_page_allocator&, const huge_page_allocator&) { return true; }
+	friend bool operator!=(const huge_page_allocator&, const huge_page_allocator&) { return false; }
+};
+
+
+template<>
+constexpr bool is_raw_allocator<huge_page_allocator> = true;
+
+}
+
+#include "huge_page_allocator.icc"
+
+#endif
+#endif
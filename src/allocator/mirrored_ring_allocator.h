@@ -0,0 +1,81 @@
+#ifndef TLZ_ND_MIRRORED_RING_ALLOCATOR_H_
+#define TLZ_ND_MIRRORED_RING_ALLOCATOR_H_
+
+#include "../config.h"
+#if TLZ_ND_WITH_ALLOCATION && TLZ_ND_WITH_MMAP
+
+#include <cstddef>
+#include "../common.h"
+#include "../ndarray.h"
+#if TLZ_ND_WITH_OPAQUE
+#include "../opaque/ndarray_opaque.h"
+#endif
+
+namespace tlz {
+
+/// Raw allocator which maps the same physical memory twice, back to back in virtual memory.
+/** For an allocation of `size` bytes at `ptr`, the bytes `[ptr + size, ptr + 2*size)` are a mirror of
+ ** `[ptr, ptr + size)`: writing to one range is visible in the other. A ring buffer allocated with it can access any
+ ** section of up to `size` bytes starting inside the buffer contiguously, without wrapping around at the border.
+ ** \a size must be a multiple of size_granularity(), i.e. the virtual memory page size. Implemented using an anonymous
+ ** shared memory file (`memfd_create`) mapped twice using `mmap`. Stateless. */
+class mirrored_ring_allocator {
+public:
+	/// Allocation size must be multiple of this. Equal to the virtual memory page size.
+	static std::size_t size_granularity();
+	
+	/// Allocate \a size bytes of memory, followed by a mirror of \a size bytes.
+	/** Alignment cannot be larger than the page size. Throws `std::bad_alloc` if the mapping fails. */
+	void* raw_allocate(std::size_t size, std::size_t alignment = 1);
+	
+	/// Deallocate memory, and its mirror, allocated with raw_allocate().
+	void raw_deallocate(void* ptr, std::size_t size);
+	
+	friend bool operator==(const mirrored_ring_allocator&, const mirrored_ring_allocator&) { return true; }
+	friend bool operator!=(const mirrored_ring_allocator&, const mirrored_ring_allocator&) { return false; }
+};
+
+
+template<>
+constexpr bool is_raw_allocator<mirrored_ring_allocator> = true;
+
+/// The mirror begins at the end of the allocation, so the buffer must always have the size of the ring.
+template<>
+constexpr bool allocator_allows_spare_capacity<mirrored_ring_allocator> = false;
+
+
+/// Smallest length not less than \a min_length for ring buffer with frames of \a frame_stride bytes.
+/** The result multiplied by \a frame_stride is a multiple of mirrored_ring_allocator::size_granularity(), so that a
+ ** 1-D array with that length and stride can be allocated with \ref mirrored_ring_allocator. */
+std::size_t mirrored_ring_length(std::size_t min_length, std::size_t frame_stride);
+
+
+/// Get plain view of section `[start, end)` of 1-D ring buffer \a ring allocated with \ref mirrored_ring_allocator.
+/** \a start gets wrapped around into the ring. The section may cross the end of \a ring, and can have a length of up to
+ ** the length of \a ring. Unlike ndarray_wraparound_view, the returned view is a normal \ref ndarray_view, because the
+ ** part that wraps around is accessed through the mirror mapping. */
+template<typename Elem>
+ndarray_view<1, Elem> mirrored_section(ndarray<1, Elem, mirrored_ring_allocator>& ring, std::ptrdiff_t start, std::ptrdiff_t end);
+
+template<typename Elem>
+ndarray_view<1, const Elem> mirrored_section(const ndarray<1, Elem, mirrored_ring_allocator>& ring, std::ptrdiff_t start, std::ptrdiff_t end);
+
+#if TLZ_ND_WITH_OPAQUE
+/// Get plain opaque view of section `[start, end)` of 1-D opaque ring buffer \a ring.
+/** Same as for \ref ndarray. For frames containing _n_-d arrays, the returned view can be casted to a concrete
+ ** `ndarray_view<1 + Frame_dim, T>`, instead of a `ndarray_wraparound_view`. */
+template<typename Frame_format>
+ndarray_opaque_view<1, true, Frame_format> mirrored_section(ndarray_opaque<1, Frame_format, mirrored_ring_allocator>& ring, std::ptrdiff_t start, std::ptrdiff_t end);
+
+template<typename Frame_format>
+ndarray_opaque_view<1, false, Frame_format> mirrored_section(const ndarray_opaque<1, Frame_format, mirrored_ring_allocator>& ring, std::ptrdiff_t start, std::ptrdiff_t end);
+#endif
+
+}
+
+#include "mirrored_ring_allocator.icc"
+#include "mirrored_ring_allocator.tcc"
+
+#endif
+
+#endif
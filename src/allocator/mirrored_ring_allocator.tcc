@@ -0,0 +1,55 @@
+namespace tlz {
+
+namespace detail {
+
+/// Byte offset from start of 1-D ring with given \a length and \a stride, to start of mirrored section.
+inline std::ptrdiff_t mirrored_section_offset_
+(std::size_t length, std::ptrdiff_t stride, std::size_t allocated_size, std::ptrdiff_t start, std::ptrdiff_t end) {
+	Assert(length > 0);
+	Assert(stride > 0 && length * stride == allocated_size, "mirrored ring must have default strides");
+	Assert(start <= end);
+	Assert(end - start <= std::ptrdiff_t(length), "mirrored section cannot be longer than ring");
+	return positive_modulo(start, std::ptrdiff_t(length)) * stride;
+}
+
+}
+
+
+template<typename Elem>
+ndarray_view<1, Elem> mirrored_section(ndarray<1, Elem, mirrored_ring_allocator>& ring, std::ptrdiff_t start, std::ptrdiff_t end) {
+	std::ptrdiff_t offset = detail::mirrored_section_offset_(
+		ring.shape().front(), ring.strides().front(), ring.allocated_size(), start, end);
+	return ndarray_view<1, Elem>(advance_raw_ptr(ring.start(), offset), make_ndsize(end - start), ring.strides());
+}
+
+
+template<typename Elem>
+ndarray_view<1, const Elem> mirrored_section(const ndarray<1, Elem, mirrored_ring_allocator>& ring, std::ptrdiff_t start, std::ptrdiff_t end) {
+	std::ptrdiff_t offset = detail::mirrored_section_offset_(
+		ring.shape().front(), ring.strides().front(), ring.allocated_size(), start, end);
+	return ndarray_view<1, const Elem>(advance_raw_ptr(ring.start(), offset), make_ndsize(end - start), ring.strides());
+}
+
+
+#if TLZ_ND_WITH_OPAQUE
+
+template<typename Frame_format>
+ndarray_opaque_view<1, true, Frame_format> mirrored_section(ndarray_opaque<1, Frame_format, mirrored_ring_allocator>& ring, std::ptrdiff_t start, std::ptrdiff_t end) {
+	std::ptrdiff_t offset = detail::mirrored_section_offset_(
+		ring.shape().front(), ring.strides().front(), ring.allocated_size(), start, end);
+	return ndarray_opaque_view<1, true, Frame_format>(
+		advance_raw_ptr(ring.start(), offset), make_ndsize(end - start), ring.strides(), ring.frame_format());
+}
+
+
+template<typename Frame_format>
+ndarray_opaque_view<1, false, Frame_format> mirrored_section(const ndarray_opaque<1, Frame_format, mirrored_ring_allocator>& ring, std::ptrdiff_t start, std::ptrdiff_t end) {
+	std::ptrdiff_t offset = detail::mirrored_section_offset_(
+		ring.shape().front(), ring.strides().front(), ring.allocated_size(), start, end);
+	return ndarray_opaque_view<1, false, Frame_format>(
+		advance_raw_ptr(ring.start(), offset), make_ndsize(end - start), ring.strides(), ring.frame_format());
+}
+
+#endif
+
+}
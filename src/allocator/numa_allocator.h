@@ -0,0 +1,114 @@
+#ifndef TLZ_ND_NUMA_ALLOCATOR_H_
+#define TLZ_ND_NUMA_ALLOCATOR_H_
+
+#include "../config.h"
+#if TLZ_ND_WITH_ALLOCATION && TLZ_ND_WITH_MMAP
+
+#include <cstddef>
+#include <functional>
+#include <vector>
+#include "../common.h"
+#include "../ndarray_view.h"
+
+namespace tlz {
+
+/// Number of NUMA nodes of the system, 1 if unknown.
+std::size_t numa_node_count();
+
+/// CPUs of NUMA node \a node.
+std::vector<int> numa_node_cpus(std::size_t node);
+
+/// Call \a func(node) for each NUMA node, in parallel by threads pinned to the CPUs of the node, and wait until done.
+/** If a call throws an exception, the first one is rethrown in the calling thread. With one node, \a func is called
+ ** in the calling thread. */
+void numa_run_on_nodes(const std::function<void(std::size_t node)>& func);
+
+
+/// Memory placement policy of \ref numa_allocator.
+enum class numa_policy {
+	local, ///< Pages are placed on the node of the thread that first touches them (system default).
+	interleave, ///< Pages are placed round-robin on all nodes.
+	partitioned ///< The buffer is divided into one contiguous block per node, in order of the nodes.
+};
+
+
+/// Properties actually obtained for an allocation by \ref numa_allocator.
+struct numa_allocation {
+	numa_policy policy = numa_policy::local; ///< Policy applied, `local` if the system has only one node.
+	bool bound = false; ///< Policy was set with `mbind`. Otherwise placement relies on first touch only.
+	bool first_touched = false; ///< Pages were faulted in by threads pinned to the nodes.
+	std::size_t nodes = 1; ///< Number of nodes the buffer is distributed over.
+};
+
+
+/// Raw allocator which distributes the pages of the buffer over NUMA nodes.
+/** With the `partitioned` policy, the buffer is divided into numa_node_count() contiguous byte ranges, rounded to
+ ** pages, and range `k` is placed on node `k`. For an \ref ndarray with default strides, this means blocks along the
+ ** outer axis, so that threads on each node can process their block from local memory. With `interleave`, pages are
+ ** distributed round-robin, which evens out bandwidth for access patterns that are not partitioned.
+ **
+ ** The policy is set using `mbind`. Additionally, if \a first_touch is set, the pages of each node's range are faulted
+ ** in at allocation by a thread pinned to that node, using numa_run_on_nodes(). So placement is right even when
+ ** `mbind` is not permitted, and the single-threaded element construction in \ref ndarray does not fault pages. On
+ ** systems with one node, nothing is done and the policy obtained is `local`. The outcome of the last allocation is
+ ** returned by last_allocation(), and the actual placement can be checked with numa_placement(). */
+class numa_allocator {
+private:
+	numa_policy policy_ = numa_policy::partitioned;
+	bool first_touch_ = true;
+	numa_allocation last_allocation_;
+
+public:
+	static std::size_t size_granularity() { return 1; }
+
+	explicit numa_allocator(numa_policy policy = numa_policy::partitioned, bool first_touch = true) :
+		policy_(policy), first_touch_(first_touch) { }
+
+	/// Allocate \a size bytes. \a alignment cannot be larger than the page size.
+	void* raw_allocate(std::size_t size, std::size_t alignment = 1);
+
+	/// Deallocate memory allocated with raw_allocate() with same \a size.
+	void raw_deallocate(void* ptr, std::size_t size);
+
+	numa_policy policy() const { return policy_; }
+	bool first_touches() const { return first_touch_; }
+
+	/// Properties obtained for the last allocation made with this allocator.
+	const numa_allocation& last_allocation() const { return last_allocation_; }
+
+	/// Byte range `[start, end)` of buffer of \a size bytes placed on \a node with the `partitioned` policy.
+	static void partition(std::size_t size, std::size_t node, std::size_t& start, std::size_t& end);
+
+	friend bool operator==(const numa_allocator&, const numa_allocator&) { return true; }
+	friend bool operator!=(const numa_allocator&, const numa_allocator&) { return false; }
+};
+
+
+template<>
+constexpr bool is_raw_allocator<numa_allocator> = true;
+
+
+/// Placement of the pages of a memory range on NUMA nodes, see numa_placement().
+struct numa_page_placement {
+	std::vector<std::size_t> node_pages; ///< Number of pages on each node.
+	std::size_t unknown_pages = 0; ///< Pages not yet faulted in, or whose node cannot be queried.
+};
+
+/// Get NUMA nodes on which the pages of `[ptr, ptr + size)` are placed, for diagnostics.
+numa_page_placement numa_placement(const void* ptr, std::size_t size);
+
+
+/// Assign \a vw to \a out in parallel, with the outer-axis block of each node copied by a thread pinned to the node.
+/** The blocks correspond to the `partitioned` policy of \ref numa_allocator for \a out with default strides, up to
+ ** rounding of the ranges to pages. Used for the first copy into a newly allocated array, for example
+ ** `numa_assign(arr.view(), vw)` after constructing `arr` with a shape. */
+template<std::size_t Dim, typename Elem>
+void numa_assign(const ndarray_view<Dim, Elem>& out, const ndarray_view<Dim, const Elem>& vw);
+
+}
+
+#include "numa_allocator.icc"
+#include "numa_allocator.tcc"
+
+#endif
+#endif
@@ -0,0 +1,31 @@
+namespace tlz {
+
+template<std::size_t Dim, typename Elem>
+void numa_assign(const ndarray_view<Dim, Elem>& out, const ndarray_view<Dim, const Elem>& vw) {
+	static_assert(Dim >= 1, "numa_assign requires dimension >= 1");
+	Assert_crit(out.shape() == vw.shape(), "ndarray_view must have same shape for assignment");
+	std::size_t nodes = numa_node_count();
+	std::size_t extent = out.shape()[0];
+	if(nodes == 1 || extent < 2) {
+		out.assign(vw);
+		return;
+	}
+
+	// rows of each node: those which start in its byte range. equal split for non-default strides
+	bool default_strides = out.has_default_strides();
+	std::size_t row_size = default_strides ? std::size_t(out.strides()[0]) : 0;
+	numa_run_on_nodes([&](std::size_t node) {
+		std::size_t start, end;
+		if(default_strides) {
+			numa_allocator::partition(extent * row_size, node, start, end);
+			start = (start + row_size - 1) / row_size;
+			end = (node + 1 == nodes) ? extent : (end + row_size - 1) / row_size;
+		} else {
+			start = (node * extent) / nodes;
+			end = ((node + 1) * extent) / nodes;
+		}
+		if(start < end) out.axis_section(0, start, end, 1).assign(vw.axis_section(0, start, end, 1));
+	});
+}
+
+}
@@ -0,0 +1,72 @@
+#ifndef TLZ_ND_POOL_ALLOCATOR_H_
+#define TLZ_ND_POOL_ALLOCATOR_H_
+
+#include "../config.h"
+#if TLZ_ND_WITH_ALLOCATION
+
+#include <cstddef>
+#include "../common.h"
+
+namespace tlz {
+
+/// Counters of \ref pool_allocator.
+struct pool_allocator_stats {
+	std::size_t allocations = 0; ///< Allocations served from the pool.
+	std::size_t deallocations = 0; ///< Deallocations returned to the pool.
+	std::size_t thread_cache_hits = 0; ///< Pooled allocations served from the thread-local cache, without locking.
+	std::size_t depot_transfers = 0; ///< Batches of blocks moved between a thread-local cache and the shared depot.
+	std::size_t slab_allocations = 0; ///< Slabs allocated from raw_allocator to carve blocks from.
+	std::size_t slab_bytes = 0; ///< Total size of allocated slabs. Slabs are never released.
+	std::size_t large_allocations = 0; ///< Allocations too large for the pool, forwarded to raw_allocator.
+};
+
+
+/// Raw allocator which serves small allocations from size-class pools.
+/** Sizes up to max_block_size() are rounded up to a power of two size class, starting at min_block_size(). Each size
+ ** class has a free list in a thread-local cache, which is used without locking, and a shared depot protected by a
+ ** mutex. When a cache runs empty or overflows, a batch of blocks is moved from or to the depot. Blocks are carved
+ ** from slabs allocated with `raw_allocator`, and are aligned to their size class. So the alignment requirement is
+ ** honored by using a size class at least as large as the alignment. Larger allocations are forwarded to
+ ** `raw_allocator`.
+ **
+ ** Intended for frequently created and destroyed small buffers, like `ndarray_opaque_frame` temporaries from
+ ** `make_ndarray_opaque_frame(frm, pool_allocator())`. The pool is shared by the whole process and the allocator is
+ ** stateless. Memory can be deallocated on a different thread than where it was allocated. */
+class pool_allocator {
+public:
+	/// Smallest size class.
+	static constexpr std::size_t min_block_size() { return 16; }
+
+	/// Largest size class. Larger allocations are not pooled.
+	static constexpr std::size_t max_block_size() { return 64 * 1024; }
+
+	static std::size_t size_granularity() { return 1; }
+
+	/// Allocate \a size bytes, aligned to \a alignment.
+	/** For pooled sizes, \a alignment cannot be larger than max_block_size(). */
+	void* raw_allocate(std::size_t size, std::size_t alignment = 1);
+
+	/// Deallocate memory allocated with raw_allocate() with same \a size.
+	void raw_deallocate(void* ptr, std::size_t size);
+
+	/// Counters of the pool.
+	/** Includes the counts of the calling thread, and of other threads up to their last exchange with the depot. */
+	static pool_allocator_stats stats();
+
+	/// Return all blocks cached for the calling thread to the shared depot.
+	static void flush_thread_cache();
+
+	friend bool operator==(const pool_allocator&, const pool_allocator&) { return true; }
+	friend bool operator!=(const pool_allocator&, const pool_allocator&) { return false; }
+};
+
+
+template<>
+constexpr bool is_raw_allocator<pool_allocator> = true;
+
+}
+
+#include "pool_allocator.icc"
+
+#endif
+#endif
@@ -0,0 +1,172 @@
+#ifndef TLZ_ND_CHUNKED_NDARRAY_H_
+#define TLZ_ND_CHUNKED_NDARRAY_H_
+
+#include "config.h"
+#if TLZ_ND_WITH_ALLOCATION && TLZ_ND_WITH_MMAP
+
+#include <cstddef>
+#include <list>
+#include <string>
+#include <type_traits>
+#include <unordered_map>
+#include "common.h"
+#include "ndcoord.h"
+#include "ndspan.h"
+#include "ndarray_view.h"
+#include "ndarray.h"
+
+namespace tlz {
+
+/// Counters of chunk cache of \ref chunked_ndarray.
+struct chunked_ndarray_cache_stats {
+	std::size_t hits = 0; ///< Chunk accesses where chunk was resident.
+	std::size_t misses = 0; ///< Chunk accesses where chunk had to be read from file.
+	std::size_t evictions = 0; ///< Chunks removed from the cache to make room.
+	std::size_t writebacks = 0; ///< Modified chunks written back to file.
+};
+
+
+/// Out-of-core _n_-d array, stored in fixed-shape chunks in a file, with bounded cache of resident chunks.
+/** The array of shape \a shape is subdivided into a grid of chunks with shape \a chunk_shape. Chunks at the end of an
+ ** axis are stored with the full chunk shape, but sectioned to the array shape when accessed. Each chunk is stored
+ ** contiguously with default strides, and the chunks are stored in row-major order of the chunk grid. Operations which
+ ** cover multiple chunks process them in this order, which gives sequential file access.
+ **
+ ** At most cache_capacity() chunks are resident in memory. When another chunk is accessed, the least recently used
+ ** chunk is evicted, and written back to the file if it was accessed for writing. Views returned by chunk() and
+ ** section() are only valid until their chunk gets evicted, i.e. until cache_capacity() other chunks have been
+ ** accessed. Sections which cross chunk borders get gathered (or scattered) with read() and write().
+ **
+ ** \a Elem must be a POD type. File I/O failures are reported as `std::system_error`. */
+template<std::size_t Dim, typename Elem>
+class chunked_ndarray {
+	static_assert(std::is_pod<Elem>::value, "chunked_ndarray Elem must be POD");
+
+public:
+	using value_type = Elem;
+	using view_type = ndarray_view<Dim, Elem>;
+	using const_view_type = ndarray_view<Dim, const Elem>;
+	using coordinates_type = ndptrdiff<Dim>;
+	using shape_type = ndsize<Dim>;
+	using span_type = ndspan<Dim>;
+
+private:
+	struct chunk_entry_ {
+		std::size_t index; ///< Row-major index of chunk in chunk grid.
+		ndarray<Dim, Elem> buffer; ///< Chunk data, with full chunk shape.
+		bool dirty; ///< Whether chunk needs to be written back.
+	};
+	using cache_list_type = std::list<chunk_entry_>;
+	
+	int fd_ = -1; ///< File descriptor of chunk file.
+	shape_type shape_; ///< Shape of array.
+	shape_type chunk_shape_; ///< Shape of each chunk.
+	shape_type chunks_shape_; ///< Shape of chunk grid.
+	std::size_t cache_capacity_; ///< Maximal number of resident chunks.
+	cache_list_type cache_; ///< Resident chunks, most recently used first.
+	std::unordered_map<std::size_t, typename cache_list_type::iterator> cache_index_; ///< Chunk index to cache entry.
+	chunked_ndarray_cache_stats stats_;
+	
+	chunked_ndarray(int fd, const shape_type& shape, const shape_type& chunk_shape, std::size_t cache_capacity);
+	
+	std::size_t chunk_byte_size_() const { return chunk_shape_.product() * sizeof(Elem); }
+	std::size_t file_size_() const { return chunks_shape_.product() * chunk_byte_size_(); }
+	coordinates_type chunk_start_(const coordinates_type& chunk_pos) const;
+	
+	chunk_entry_& access_(const coordinates_type& chunk_pos, bool write);
+	void write_back_(chunk_entry_&);
+	void close_();
+	
+	template<typename Function> void for_each_chunk_section_(const span_type&, bool write, Function&& func);
+	
+public:
+	/// \name Construction
+	///@{
+	/// Open existing chunk file at \a path, with given array and chunk shapes.
+	/** The file must have the size for this array and chunk shape. */
+	chunked_ndarray(const std::string& path, const shape_type& shape, const shape_type& chunk_shape, std::size_t cache_capacity);
+	
+	/// Create or truncate chunk file at \a path, with given array and chunk shapes.
+	/** Elements are initially zero. */
+	static chunked_ndarray create(const std::string& path, const shape_type& shape, const shape_type& chunk_shape, std::size_t cache_capacity);
+	
+	chunked_ndarray(const chunked_ndarray&) = delete;
+	chunked_ndarray(chunked_ndarray&&);
+	
+	chunked_ndarray& operator=(const chunked_ndarray&) = delete;
+	chunked_ndarray& operator=(chunked_ndarray&&);
+	
+	/// Write back modified chunks and close the file.
+	~chunked_ndarray();
+	///@}
+	
+	
+	/// \name Attributes
+	///@{
+	constexpr static std::size_t dimension() { return Dim; }
+	const shape_type& shape() const { return shape_; }
+	std::size_t size() const { return shape_.product(); }
+	span_type full_span() const { return span_type(0, shape_); }
+	
+	const shape_type& chunk_shape() const { return chunk_shape_; }
+	
+	/// Number of chunks along each axis.
+	const shape_type& chunks_shape() const { return chunks_shape_; }
+	
+	/// Span of elements in chunk at position \a chunk_pos of the chunk grid.
+	span_type chunk_span(const coordinates_type& chunk_pos) const;
+	
+	/// Position in chunk grid of chunk containing element at \a pos.
+	coordinates_type chunk_position(const coordinates_type& pos) const;
+	///@}
+	
+	
+	/// \name Chunk access
+	///@{
+	/// View to chunk at position \a chunk_pos of the chunk grid, for reading and writing.
+	view_type chunk(const coordinates_type& chunk_pos);
+	
+	/// View to chunk at position \a chunk_pos of the chunk grid, for reading only.
+	/** Does not cause the chunk to be written back. */
+	const_view_type cchunk(const coordinates_type& chunk_pos);
+	
+	/// View to section \a span of the array, for reading and writing. It must lie inside one chunk.
+	view_type section(const span_type& span);
+	
+	/// View to section \a span of the array, for reading only. It must lie inside one chunk.
+	const_view_type csection(const span_type& span);
+	///@}
+	
+	
+	/// \name Gather and scatter
+	///@{
+	/// Copy section \a span of the array, which may cover multiple chunks, into \a out.
+	void read(const span_type& span, const view_type& out);
+	
+	/// Copy section \a span of the array into new \ref ndarray.
+	ndarray<Dim, Elem> read(const span_type& span);
+	
+	/// Copy \a vw into section of the array of same shape, starting at \a start_pos.
+	void write(const coordinates_type& start_pos, const const_view_type& vw);
+	///@}
+	
+	
+	/// \name Cache
+	///@{
+	std::size_t cache_capacity() const { return cache_capacity_; }
+	std::size_t resident_chunks() const { return cache_.size(); }
+	
+	/// Write back all modified resident chunks to the file.
+	void flush();
+	
+	const chunked_ndarray_cache_stats& cache_stats() const { return stats_; }
+	void reset_cache_stats() { stats_ = chunked_ndarray_cache_stats(); }
+	///@}
+};
+
+}
+
+#include "chunked_ndarray.tcc"
+
+#endif
+#endif
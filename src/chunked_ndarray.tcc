@@ -0,0 +1,305 @@
+#include <algorithm>
+#include <cerrno>
+#include <iterator>
+#include <system_error>
+#include <utility>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
+
+namespace tlz {
+
+namespace detail {
+
+[[noreturn]] inline void throw_chunked_file_error_(const char* what, int err = errno) {
+	throw std::system_error(err, std::generic_category(), what);
+}
+
+inline void chunked_file_read_(int fd, void* buf, std::size_t size, std::size_t offset) {
+	while(size > 0) {
+		::ssize_t n = ::pread(fd, buf, size, offset);
+		if(n < 0 && errno == EINTR) continue;
+		else if(n < 0) throw_chunked_file_error_("could not read chunk");
+		else if(n == 0) throw_chunked_file_error_("chunk file too short", EIO);
+		buf = advance_raw_ptr(buf, n);
+		size -= n;
+		offset += n;
+	}
+}
+
+inline void chunked_file_write_(int fd, const void* buf, std::size_t size, std::size_t offset) {
+	while(size > 0) {
+		::ssize_t n = ::pwrite(fd, buf, size, offset);
+		if(n < 0 && errno == EINTR) continue;
+		else if(n < 0) throw_chunked_file_error_("could not write chunk");
+		buf = advance_raw_ptr(buf, n);
+		size -= n;
+		offset += n;
+	}
+}
+
+}
+
+
+template<std::size_t Dim, typename Elem>
+chunked_ndarray<Dim, Elem>::chunked_ndarray
+(int fd, const shape_type& shape, const shape_type& chunk_shape, std::size_t cache_capacity) :
+	fd_(fd),
+	shape_(shape),
+	chunk_shape_(chunk_shape),
+	cache_capacity_(cache_capacity)
+{
+	Assert(cache_capacity > 0, "chunked_ndarray cache capacity must be at least 1");
+	for(std::ptrdiff_t i = 0; i < Dim; ++i) {
+		Assert(chunk_shape[i] > 0, "chunked_ndarray chunk shape must be non-zero");
+		chunks_shape_[i] = (shape[i] + chunk_shape[i] - 1) / chunk_shape[i];
+	}
+	cache_index_.reserve(cache_capacity);
+}
+
+
+template<std::size_t Dim, typename Elem>
+chunked_ndarray<Dim, Elem>::chunked_ndarray
+(const std::string& path, const shape_type& shape, const shape_type& chunk_shape, std::size_t cache_capacity) :
+	chunked_ndarray(-1, shape, chunk_shape, cache_capacity)
+{
+	fd_ = ::open(path.c_str(), O_RDWR | O_CLOEXEC);
+	if(fd_ == -1) detail::throw_chunked_file_error_("could not open chunk file");
+	
+	struct ::stat st;
+	int err = 0;
+	if(::fstat(fd_, &st) != 0) err = errno;
+	else if(std::size_t(st.st_size) != file_size_()) err = EINVAL;
+	if(err != 0) {
+		close_();
+		detail::throw_chunked_file_error_("chunk file has incorrect size", err);
+	}
+}
+
+
+template<std::size_t Dim, typename Elem>
+auto chunked_ndarray<Dim, Elem>::create
+(const std::string& path, const shape_type& shape, const shape_type& chunk_shape, std::size_t cache_capacity) -> chunked_ndarray {
+	int fd = ::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+	if(fd == -1) detail::throw_chunked_file_error_("could not create chunk file");
+	chunked_ndarray arr(fd, shape, chunk_shape, cache_capacity);
+	if(::ftruncate(fd, arr.file_size_()) != 0) detail::throw_chunked_file_error_("could not resize chunk file");
+	return arr;
+}
+
+
+template<std::size_t Dim, typename Elem>
+chunked_ndarray<Dim, Elem>::chunked_ndarray(chunked_ndarray&& arr) :
+	fd_(arr.fd_),
+	shape_(arr.shape_),
+	chunk_shape_(arr.chunk_shape_),
+	chunks_shape_(arr.chunks_shape_),
+	cache_capacity_(arr.cache_capacity_),
+	cache_(std::move(arr.cache_)),
+	cache_index_(std::move(arr.cache_index_)),
+	stats_(arr.stats_)
+{
+	arr.fd_ = -1;
+	arr.cache_.clear();
+	arr.cache_index_.clear();
+}
+
+
+template<std::size_t Dim, typename Elem>
+auto chunked_ndarray<Dim, Elem>::operator=(chunked_ndarray&& arr) -> chunked_ndarray& {
+	if(&arr == this) return *this;
+	flush();
+	close_();
+	fd_ = arr.fd_;
+	shape_ = arr.shape_;
+	chunk_shape_ = arr.chunk_shape_;
+	chunks_shape_ = arr.chunks_shape_;
+	cache_capacity_ = arr.cache_capacity_;
+	cache_ = std::move(arr.cache_);
+	cache_index_ = std::move(arr.cache_index_);
+	stats_ = arr.stats_;
+	arr.fd_ = -1;
+	arr.cache_.clear();
+	arr.cache_index_.clear();
+	return *this;
+}
+
+
+template<std::size_t Dim, typename Elem>
+chunked_ndarray<Dim, Elem>::~chunked_ndarray() {
+	try {
+		flush();
+	} catch(const std::system_error&) {
+		// modifications are lost, cannot throw from destructor
+	}
+	close_();
+}
+
+
+template<std::size_t Dim, typename Elem>
+void chunked_ndarray<Dim, Elem>::close_() {
+	if(fd_ != -1) ::close(fd_);
+	fd_ = -1;
+}
+
+
+template<std::size_t Dim, typename Elem>
+auto chunked_ndarray<Dim, Elem>::chunk_start_(const coordinates_type& chunk_pos) const -> coordinates_type {
+	coordinates_type start;
+	for(std::ptrdiff_t i = 0; i < Dim; ++i) start[i] = chunk_pos[i] * chunk_shape_[i];
+	return start;
+}
+
+
+template<std::size_t Dim, typename Elem>
+auto chunked_ndarray<Dim, Elem>::chunk_span(const coordinates_type& chunk_pos) const -> span_type {
+	coordinates_type start = chunk_start_(chunk_pos);
+	coordinates_type end;
+	for(std::ptrdiff_t i = 0; i < Dim; ++i)
+		end[i] = std::min<std::ptrdiff_t>(start[i] + chunk_shape_[i], shape_[i]);
+	return span_type(start, end);
+}
+
+
+template<std::size_t Dim, typename Elem>
+auto chunked_ndarray<Dim, Elem>::chunk_position(const coordinates_type& pos) const -> coordinates_type {
+	coordinates_type chunk_pos;
+	for(std::ptrdiff_t i = 0; i < Dim; ++i) chunk_pos[i] = pos[i] / chunk_shape_[i];
+	return chunk_pos;
+}
+
+
+template<std::size_t Dim, typename Elem>
+void chunked_ndarray<Dim, Elem>::write_back_(chunk_entry_& entry) {
+	detail::chunked_file_write_(fd_, entry.buffer.start(), chunk_byte_size_(), entry.index * chunk_byte_size_());
+	entry.dirty = false;
+	++stats_.writebacks;
+}
+
+
+template<std::size_t Dim, typename Elem>
+auto chunked_ndarray<Dim, Elem>::access_(const coordinates_type& chunk_pos, bool write) -> chunk_entry_& {
+	Assert(span_type(0, chunks_shape_).includes(chunk_pos), "chunk position out of bounds");
+	std::size_t index = 0;
+	for(std::ptrdiff_t i = 0; i < Dim; ++i) index = index * chunks_shape_[i] + chunk_pos[i];
+	
+	auto it = cache_index_.find(index);
+	if(it != cache_index_.end()) {
+		++stats_.hits;
+		cache_.splice(cache_.begin(), cache_, it->second);
+	} else {
+		++stats_.misses;
+		if(cache_.size() < cache_capacity_) {
+			cache_.push_front(chunk_entry_ { index, ndarray<Dim, Elem>(chunk_shape_), false });
+		} else {
+			// reuse buffer of least recently used chunk
+			auto lru = std::prev(cache_.end());
+			if(lru->dirty) write_back_(*lru);
+			cache_index_.erase(lru->index);
+			++stats_.evictions;
+			cache_.splice(cache_.begin(), cache_, lru);
+		}
+		chunk_entry_& entry = cache_.front();
+		try {
+			detail::chunked_file_read_(fd_, entry.buffer.start(), chunk_byte_size_(), index * chunk_byte_size_());
+		} catch(...) {
+			// the buffer has undefined content, so drop the entry
+			cache_.pop_front();
+			throw;
+		}
+		entry.index = index;
+		entry.dirty = false;
+		cache_index_[index] = cache_.begin();
+	}
+	
+	chunk_entry_& entry = cache_.front();
+	if(write) entry.dirty = true;
+	return entry;
+}
+
+
+template<std::size_t Dim, typename Elem>
+auto chunked_ndarray<Dim, Elem>::chunk(const coordinates_type& chunk_pos) -> view_type {
+	span_type span = chunk_span(chunk_pos);
+	return access_(chunk_pos, true).buffer.view().section(make_ndspan(coordinates_type(span.shape())));
+}
+
+
+template<std::size_t Dim, typename Elem>
+auto chunked_ndarray<Dim, Elem>::cchunk(const coordinates_type& chunk_pos) -> const_view_type {
+	span_type span = chunk_span(chunk_pos);
+	return access_(chunk_pos, false).buffer.cview().section(make_ndspan(coordinates_type(span.shape())));
+}
+
+
+template<std::size_t Dim, typename Elem>
+auto chunked_ndarray<Dim, Elem>::section(const span_type& span) -> view_type {
+	Assert(full_span().includes(span), "section out of bounds");
+	coordinates_type chunk_pos = chunk_position(span.start_pos());
+	coordinates_type chunk_start = chunk_start_(chunk_pos);
+	Assert(chunk_span(chunk_pos).includes(span), "section must lie inside one chunk");
+	return chunk(chunk_pos).section(span.start_pos() - chunk_start, span.end_pos() - chunk_start);
+}
+
+
+template<std::size_t Dim, typename Elem>
+auto chunked_ndarray<Dim, Elem>::csection(const span_type& span) -> const_view_type {
+	Assert(full_span().includes(span), "section out of bounds");
+	coordinates_type chunk_pos = chunk_position(span.start_pos());
+	coordinates_type chunk_start = chunk_start_(chunk_pos);
+	Assert(chunk_span(chunk_pos).includes(span), "section must lie inside one chunk");
+	return cchunk(chunk_pos).section(span.start_pos() - chunk_start, span.end_pos() - chunk_start);
+}
+
+
+template<std::size_t Dim, typename Elem> template<typename Function>
+void chunked_ndarray<Dim, Elem>::for_each_chunk_section_(const span_type& span, bool write, Function&& func) {
+	Assert(full_span().includes(span), "section out of bounds");
+	if(span.size() == 0) return;
+	
+	coordinates_type first_chunk = chunk_position(span.start_pos());
+	coordinates_type last_chunk = chunk_position(span.end_pos() - coordinates_type(1));
+	for(const coordinates_type& chunk_pos : make_ndspan(first_chunk, last_chunk + coordinates_type(1))) {
+		coordinates_type chunk_start = chunk_start_(chunk_pos);
+		span_type sec = span_intersection(span, chunk_span(chunk_pos));
+		const view_type& chunk_vw = access_(chunk_pos, write).buffer.view();
+		func(
+			chunk_vw.section(sec.start_pos() - chunk_start, sec.end_pos() - chunk_start),
+			span_type(sec.start_pos() - span.start_pos(), sec.end_pos() - span.start_pos())
+		);
+	}
+}
+
+
+template<std::size_t Dim, typename Elem>
+void chunked_ndarray<Dim, Elem>::read(const span_type& span, const view_type& out) {
+	Assert(out.shape() == span.shape(), "output view must have shape of section");
+	for_each_chunk_section_(span, false, [&out](const view_type& chunk_sec, const span_type& out_span) {
+		out.section(out_span).assign(chunk_sec);
+	});
+}
+
+
+template<std::size_t Dim, typename Elem>
+ndarray<Dim, Elem> chunked_ndarray<Dim, Elem>::read(const span_type& span) {
+	ndarray<Dim, Elem> out(span.shape());
+	read(span, out.view());
+	return out;
+}
+
+
+template<std::size_t Dim, typename Elem>
+void chunked_ndarray<Dim, Elem>::write(const coordinates_type& start_pos, const const_view_type& vw) {
+	span_type span(start_pos, start_pos + coordinates_type(vw.shape()));
+	for_each_chunk_section_(span, true, [&vw](const view_type& chunk_sec, const span_type& in_span) {
+		chunk_sec.assign(vw.section(in_span));
+	});
+}
+
+
+template<std::size_t Dim, typename Elem>
+void chunked_ndarray<Dim, Elem>::flush() {
+	for(chunk_entry_& entry : cache_) if(entry.dirty) write_back_(entry);
+}
+
+}
@@ -27,4 +27,30 @@
 #define TLZ_ND_WITH_OPAQUE 1
 #endif
 
+// TLZ_ND_WITH_SIMD:
+// if enabled, strided POD copy/compare use SSE2/AVX2/AVX-512 kernels, selected at runtime (x86, GCC/Clang only)
+
+#ifndef TLZ_ND_WITH_SIMD
+#define TLZ_ND_WITH_SIMD 1
+#endif
+
+// TLZ_ND_WITH_MMAP:
+// if enabled, allocators and containers based on virtual memory mapping and file I/O are available (Linux only)
+
+#ifndef TLZ_ND_WITH_MMAP
+	#ifdef __linux__
+	#define TLZ_ND_WITH_MMAP 1
+	#else
+	#define TLZ_ND_WITH_MMAP 0
+	#endif
+#endif
+
+// TLZ_ND_WITH_INSTRUMENTATION:
+// if enabled, per-thread counters record which implementation paths assign, compare, iteration and allocation take,
+// and how many bytes they process (see instrumentation.h). If disabled, the counting compiles to nothing
+
+#ifndef TLZ_ND_WITH_INSTRUMENTATION
+#define TLZ_ND_WITH_INSTRUMENTATION 0
+#endif
+
 #endif
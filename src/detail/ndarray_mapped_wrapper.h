@@ -0,0 +1,109 @@
+#ifndef TLZ_NDARRAY_MAPPED_WRAPPER_H_
+#define TLZ_NDARRAY_MAPPED_WRAPPER_H_
+
+#include "../config.h"
+#if TLZ_ND_WITH_MMAP
+
+#include <string>
+#include <utility>
+#include "../common.h"
+#include "../ndcoord.h"
+#include "../mapped_file.h"
+
+namespace tlz { namespace detail {
+
+/// Byte range `[first, last)` covered by elements of size \a elem_size, relative to the first element.
+template<std::size_t Dim>
+std::pair<std::ptrdiff_t, std::ptrdiff_t> mapped_view_extent_(const ndsize<Dim>& shape, const ndptrdiff<Dim>& strides, std::size_t elem_size) {
+	if(shape.product() == 0) return std::make_pair(0, 0);
+	std::ptrdiff_t first = 0, last = elem_size;
+	for(std::ptrdiff_t i = 0; i < Dim; ++i) {
+		std::ptrdiff_t d = (shape[i] - 1) * strides[i];
+		if(d < 0) first += d;
+		else last += d;
+	}
+	return std::make_pair(first, last);
+}
+
+
+/// Container for view to memory-mapped file, base class and wrapper around view.
+/** Owns a \ref mapped_file, and a view to its content. Like \ref ndarray_wrapper, `const` access only gives `const`
+ ** access to the data. Elements are not constructed or destructed: they must be POD. */
+template<typename View, typename Const_view>
+class ndarray_mapped_wrapper {
+public:
+	using view_type = View;
+	using const_view_type = Const_view;
+	
+	using shape_type = typename view_type::shape_type;
+	using strides_type = typename view_type::strides_type;
+	
+private:
+	mapped_file file_; ///< Mapped section of file, covering the elements.
+	view_type view_; ///< View to mapped memory.
+	
+protected:
+	/// Map file at \a path, and create view with given shape and strides, whose first element is at byte \a offset.
+	template<typename... Arg>
+	ndarray_mapped_wrapper(
+		const std::string& path,
+		mapped_file_mode mode,
+		std::size_t offset,
+		const shape_type& shape,
+		const strides_type& strides,
+		std::size_t elem_size,
+		std::size_t elem_alignment,
+		const Arg&... view_arguments
+	) {
+		auto extent = mapped_view_extent_(shape, strides, elem_size);
+		Assert(std::ptrdiff_t(offset) + extent.first >= 0, "mapped view starts before beginning of file");
+		if(extent.second > extent.first)
+			file_ = mapped_file(path, mode, offset + extent.first, extent.second - extent.first);
+		void* start = advance_raw_ptr(file_.data(), -extent.first);
+		Assert(is_aligned(start, elem_alignment), "mapped view elements are not properly aligned");
+		view_.reset(view_type(static_cast<typename view_type::pointer>(start), shape, strides, view_arguments...));
+	}
+	
+	ndarray_mapped_wrapper(ndarray_mapped_wrapper&&) = default;
+	ndarray_mapped_wrapper& operator=(ndarray_mapped_wrapper&&) = default;
+	
+public:
+	/// \name Mapped file
+	///@{
+	const mapped_file& file() const { return file_; }
+	mapped_file_mode mode() const { return file_.mode(); }
+	
+	/// Give access pattern hint for the mapped memory, see mapped_file::advise().
+	void advise(mapped_access_hint hint) { file_.advise(hint); }
+	
+	/// Write back modifications to the file, see mapped_file::flush().
+	void flush(bool asynchronous = false) { file_.flush(asynchronous); }
+	///@}
+	
+	
+	/// \name View access
+	///@{
+	const view_type& view() { return view_; }
+	const_view_type view() const { return cview(); }
+	const_view_type cview() const { return const_view_type(view_);  }
+	
+	operator const view_type& () { return view(); }
+	operator const_view_type () const { return cview(); }
+	///@}
+	
+	
+	/// \name Attributes
+	///@{
+	constexpr static std::size_t dimension() { return view_type::dimension(); }
+	auto start() { return view_.start(); }
+	auto start() const { return cview().start(); }
+	shape_type shape() const { return view_.shape(); }
+	strides_type strides() const { return view_.strides(); }
+	std::size_t size() const { return view_.size(); }
+	///@}
+};
+
+}}
+
+#endif
+#endif
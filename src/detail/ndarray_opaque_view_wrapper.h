@@ -8,6 +8,10 @@
 #include <type_traits>
 #include "../common.h"
 #include "../ndarray_iterator.h"
+#include "../ndarray_view.h"
+#include "../ndarray_order.h"
+#include "../pod_array_strided.h"
+#include "../instrumentation.h"
 #include "ndarray_view_fcall.h"
 #include "../opaque/ndarray_opaque_traits.h"
 
@@ -44,6 +48,7 @@ public:
 	using shape_type = ndsize<Dim>;
 	using strides_type = ndptrdiff<Dim>;
 	using span_type = ndspan<Dim>;
+	using order_type = ndarray_order<Dim>;
 	
 	using iterator = ndarray_iterator<ndarray_opaque_view_wrapper>;
 	
@@ -55,9 +60,42 @@ private:
 	using enable_if_convertible_ = std::enable_if_t<is_convertible_ndarray_opaque_view<Other_view, ndarray_opaque_view_wrapper>::value, U>;
 
 	using fcall_type = ndarray_view_fcall<ndarray_opaque_view_wrapper, 1>;
+	
+	using strided_const_view_type = ndarray_opaque_view_wrapper<Dim, false, Frame_format, ndarray_view>;
+	
+	template<typename Other_view>
+	using has_strided_operands_ = std::integral_constant<bool,
+		(Dim > 0) &&
+		is_strided_ndarray_view<base>::value &&
+		std::is_convertible<Other_view, strided_const_view_type>::value
+	>;
 
 	frame_format_type frame_format_;
 	
+	using segment_view_type = ndarray_opaque_view_wrapper<Dim, Mutable, Frame_format, ndarray_view>;
+	using wraparound_other_ = wraparound_operand_constant<wraparound_operand::other>;
+	using wraparound_self_ = wraparound_operand_constant<wraparound_operand::self>;
+	using wraparound_none_ = wraparound_operand_constant<wraparound_operand::none>;
+	
+	template<typename Other_view> void assign_(const Other_view&, const pod_array_copy_policy&, wraparound_other_) const;
+	template<typename Other_view> void assign_(const Other_view&, const pod_array_copy_policy&, wraparound_self_) const;
+	template<typename Other_view> void assign_(const Other_view&, const pod_array_copy_policy&, wraparound_none_) const;
+	template<typename Other_view> void assign_(const Other_view&, const pod_array_copy_policy&, std::true_type) const;
+	template<typename Other_view> void assign_(const Other_view&, const pod_array_copy_policy&, std::false_type) const;
+	template<typename Other_view> bool compare_(const Other_view&, wraparound_other_) const;
+	template<typename Other_view> bool compare_(const Other_view&, wraparound_self_) const;
+	template<typename Other_view> bool compare_(const Other_view&, wraparound_none_) const;
+	template<typename Other_view> bool compare_(const Other_view&, std::true_type) const;
+	template<typename Other_view> bool compare_(const Other_view&, std::false_type) const;
+	
+	struct no_mutable_view_ { };
+	/// Mutable view if this is not mutable, otherwise unused type, so that the copy constructor stays defaulted.
+	using mutable_view_type_ = std::conditional_t<
+		! Mutable,
+		ndarray_opaque_view_wrapper<Dim, true, Frame_format, Base_view>,
+		no_mutable_view_
+	>;
+	
 protected:
 	using base::fix_coordinate_;
 	// required by ndarray_timed_view_derived<ndarray_opaque_view_wrapper>
@@ -70,7 +108,10 @@ public:
 	ndarray_opaque_view_wrapper(const base& base_vw, const frame_format_type& frm) :
 		base(base_vw), frame_format_(frm) { }
 	
-	ndarray_opaque_view_wrapper(const ndarray_opaque_view_wrapper<Dim, true, Frame_format, Base_view>& vw) :
+	ndarray_opaque_view_wrapper(const ndarray_opaque_view_wrapper&) = default;
+	
+	/// Create non-mutable view from mutable view.
+	ndarray_opaque_view_wrapper(const mutable_view_type_& vw) :
 		base(vw.base_view()), frame_format_(vw.frame_format()) { }
 	
 	ndarray_opaque_view_wrapper(pointer start, const shape_type& shp, const strides_type& str, const frame_format_type& frm) :
@@ -139,6 +180,29 @@ public:
 		else return false;
 	}
 	
+	static strides_type default_strides(const shape_type& shp, const frame_format_type& frm, const order_type& order, std::size_t frame_padding = 0) {
+		Assert(is_multiple_of(frame_padding, frm.alignment_requirement()));
+		return ordered_default_strides(shp, order, frm.size() + frame_padding);
+	}
+	
+	bool has_default_strides(const order_type& order, std::ptrdiff_t minimal_position = 0) const {
+		return has_ordered_default_strides(shape(), strides(), order, frame_format().size(), minimal_position);
+	}
+	
+	std::size_t default_strides_padding(const order_type& order, std::ptrdiff_t minimal_position = 0) const {
+		if(Dim == 0) return 0;
+		Assert(has_default_strides(order, minimal_position));
+		return (strides()[order.innermost_axis()] - frame_format().size());
+	}
+	
+	bool has_default_strides_without_padding(const order_type& order, std::ptrdiff_t minimal_position = 0) const {
+		if(Dim == 0) return true;
+		else if(has_default_strides(order, minimal_position)) return (default_strides_padding(order, minimal_position) == 0);
+		else return false;
+	}
+	
+	order_type strides_order() const { return detail::strides_order(shape(), strides()); }
+	
 	const frame_format_type& frame_format() const { return frame_format_; }
 	///@}
 	
@@ -156,17 +220,15 @@ public:
 	///@{
 	template<typename Other_view>
 	enable_if_convertible_<Other_view> assign(const Other_view& other) const {
+		assign(other, default_pod_array_copy_policy());
+	}
+	
+	/// Assign with explicit copy policy, used when frames are POD.
+	template<typename Other_view>
+	enable_if_convertible_<Other_view> assign(const Other_view& other, const pod_array_copy_policy& policy) const {
 		Assert(other.frame_format() == frame_format());
 		Assert(other.shape() == shape());
-		
-		if(has_pod_format() && other.has_pod_format() && pod_format() == other.pod_format()) {
-			pod_array_copy(start(), other.start(), pod_format());
-		} else {
-			auto it = begin();
-			for(const auto& other_view : other) {
-				(it++)->frame_handle().assign(other_view.frame_handle());
-			}
-		}
+		assign_(other, policy, wraparound_operand_tag<ndarray_opaque_view_wrapper, Other_view>());
 	}
 	
 	template<typename Arg>
@@ -184,17 +246,7 @@ public:
 		// TODO support nullable Other_view, check is_null, also assign()
 		Assert(other.frame_format() == frame_format());
 		Assert(other.shape() == shape());
-		
-		if(has_pod_format() && other.has_pod_format() && pod_format() == other.pod_format()) {
-			return pod_array_compare(start(), other.start(), pod_format());
-		} else {
-			auto it = begin();
-			for(const auto& other_view : other) {
-				bool frame_equal = (it++)->frame_handle().compare(other_view.frame_handle());
-				if(! frame_equal) return false;
-			}
-			return true;
-		}
+		return compare_(other, wraparound_operand_tag<ndarray_opaque_view_wrapper, Other_view>());
 	}
 	
 	template<typename Arg> bool operator==(const Arg& arg) const { return compare(arg); }
@@ -282,8 +334,14 @@ public:
 	}
 	
 	
+	/// Check if frames form a POD array, with default strides in any storage order.
+	/** Like for \ref ndarray_view, strides_order() must also be compared to know if two views have the same layout. */
 	bool has_pod_format() const {
-		return tail_has_pod_format<Dim>();
+		if(! frame_format().is_pod()) return false;
+		order_type order = strides_order();
+		pod_array_format frame_pod_format = frame_format().pod_format();
+		if(frame_pod_format.is_contiguous()) return has_default_strides(order);
+		else return has_default_strides_without_padding(order);
 	}
 	
 	template<std::size_t Tail_dim>
@@ -312,12 +370,165 @@ public:
 	}
 	
 	pod_array_format pod_format() const {
-		return tail_pod_format<Dim>();
+		if(Dim == 0) return frame_format().pod_format();
+		Assert(has_pod_format());
+		pod_array_format frame_pod_format = frame_format().pod_format();
+		if(frame_pod_format.is_contiguous()) {
+			std::size_t stride = strides()[strides_order().innermost_axis()];
+			return pod_array_format(frame_pod_format.size(), frame_pod_format.elem_alignment(), size(), stride);
+		} else {
+			std::size_t length = size() * frame_pod_format.length();
+			return pod_array_format(frame_pod_format.elem_size(), frame_pod_format.elem_alignment(), length, frame_pod_format.stride());
+		}
+	}
+	///@}
+	
+	
+	/// \name Segments
+	///@{
+	/// Call \a fn for each non-wrapping segment, if base view is \ref ndarray_wraparound_view.
+	/** Segments are opaque views with ordinary \ref ndarray_view base. See ndarray_wraparound_view::for_each_segment(). */
+	template<typename Function>
+	bool for_each_segment(Function&& fn) const {
+		return base::for_each_segment([&](const auto& base_seg_start, const auto& base_seg) {
+			return invoke_run_function(fn, head<Dim>(base_seg_start), segment_view_type(base_seg, frame_format_));
+		});
 	}
 	///@}
 };
 
 
+template<std::size_t Dim, bool Mutable, typename Frame_format, template<std::size_t,typename> class Base_view>
+template<typename Other_view>
+void ndarray_opaque_view_wrapper<Dim, Mutable, Frame_format, Base_view>::assign_(const Other_view& other, const pod_array_copy_policy& policy, wraparound_other_) const {
+	other.for_each_segment([&](const coordinates_type& seg_start, const auto& seg) {
+		section(seg_start, seg_start + coordinates_type(seg.shape())).assign(seg, policy);
+	});
+}
+
+
+template<std::size_t Dim, bool Mutable, typename Frame_format, template<std::size_t,typename> class Base_view>
+template<typename Other_view>
+void ndarray_opaque_view_wrapper<Dim, Mutable, Frame_format, Base_view>::assign_(const Other_view& other, const pod_array_copy_policy& policy, wraparound_self_) const {
+	for_each_segment([&](const coordinates_type& seg_start, const segment_view_type& seg) {
+		seg.assign(other.section(seg_start, seg_start + coordinates_type(seg.shape())), policy);
+	});
+}
+
+
+template<std::size_t Dim, bool Mutable, typename Frame_format, template<std::size_t,typename> class Base_view>
+template<typename Other_view>
+void ndarray_opaque_view_wrapper<Dim, Mutable, Frame_format, Base_view>::assign_(const Other_view& other, const pod_array_copy_policy& policy, wraparound_none_) const {
+	assign_(other, policy, has_strided_operands_<Other_view>());
+}
+
+
+template<std::size_t Dim, bool Mutable, typename Frame_format, template<std::size_t,typename> class Base_view>
+template<typename Other_view>
+void ndarray_opaque_view_wrapper<Dim, Mutable, Frame_format, Base_view>::assign_(const Other_view& other, const pod_array_copy_policy& policy, std::true_type) const {
+	if(frame_format().is_pod()) {
+		// POD frames: strided copy, with frame elements as inner axis
+		strided_const_view_type other_vw = other;
+		pod_array_format frame_pod_format = frame_format().pod_format();
+		TLZ_ND_INSTRUMENT(opaque_assign_pod_strided, shape().product() * frame_pod_format.length() * frame_pod_format.elem_size());
+		pod_array_strided_copy(
+			static_cast<void*>(start()), ndcoord_cat(strides(), frame_pod_format.stride()),
+			static_cast<const void*>(other_vw.start()), ndcoord_cat(other_vw.strides(), frame_pod_format.stride()),
+			ndcoord_cat(shape(), frame_pod_format.length()),
+			frame_pod_format.elem_size(),
+			policy
+		);
+	} else {
+		assign_(other, policy, std::false_type());
+	}
+}
+
+
+template<std::size_t Dim, bool Mutable, typename Frame_format, template<std::size_t,typename> class Base_view>
+template<typename Other_view>
+void ndarray_opaque_view_wrapper<Dim, Mutable, Frame_format, Base_view>::assign_(const Other_view& other, const pod_array_copy_policy& policy, std::false_type) const {
+	if(has_pod_format() && other.has_pod_format() && pod_format() == other.pod_format() && strides_order() == other.strides_order()) {
+		TLZ_ND_INSTRUMENT(opaque_assign_pod_contiguous, shape().product() * frame_format().size());
+		pod_array_copy(start(), other.start(), pod_format(), policy);
+	} else if(frame_format().is_pod()) {
+		pod_array_format frame_pod_format = frame_format().pod_format();
+		TLZ_ND_INSTRUMENT(opaque_assign_pod_frames, shape().product() * frame_format().size());
+		auto it = begin();
+		for(const auto& other_view : other) {
+			pod_array_copy((it++)->start(), other_view.start(), frame_pod_format, policy);
+		}
+	} else {
+		TLZ_ND_INSTRUMENT(opaque_assign_handles, shape().product() * frame_format().size());
+		auto it = begin();
+		for(const auto& other_view : other) {
+			(it++)->frame_handle().assign(other_view.frame_handle());
+		}
+	}
+}
+
+
+template<std::size_t Dim, bool Mutable, typename Frame_format, template<std::size_t,typename> class Base_view>
+template<typename Other_view>
+bool ndarray_opaque_view_wrapper<Dim, Mutable, Frame_format, Base_view>::compare_(const Other_view& other, wraparound_other_) const {
+	return other.for_each_segment([&](const coordinates_type& seg_start, const auto& seg) {
+		return section(seg_start, seg_start + coordinates_type(seg.shape())).compare(seg);
+	});
+}
+
+
+template<std::size_t Dim, bool Mutable, typename Frame_format, template<std::size_t,typename> class Base_view>
+template<typename Other_view>
+bool ndarray_opaque_view_wrapper<Dim, Mutable, Frame_format, Base_view>::compare_(const Other_view& other, wraparound_self_) const {
+	return for_each_segment([&](const coordinates_type& seg_start, const segment_view_type& seg) {
+		return seg.compare(other.section(seg_start, seg_start + coordinates_type(seg.shape())));
+	});
+}
+
+
+template<std::size_t Dim, bool Mutable, typename Frame_format, template<std::size_t,typename> class Base_view>
+template<typename Other_view>
+bool ndarray_opaque_view_wrapper<Dim, Mutable, Frame_format, Base_view>::compare_(const Other_view& other, wraparound_none_) const {
+	return compare_(other, has_strided_operands_<Other_view>());
+}
+
+
+template<std::size_t Dim, bool Mutable, typename Frame_format, template<std::size_t,typename> class Base_view>
+template<typename Other_view>
+bool ndarray_opaque_view_wrapper<Dim, Mutable, Frame_format, Base_view>::compare_(const Other_view& other, std::true_type) const {
+	if(frame_format().is_pod()) {
+		strided_const_view_type other_vw = other;
+		pod_array_format frame_pod_format = frame_format().pod_format();
+		TLZ_ND_INSTRUMENT(opaque_compare_pod_strided, shape().product() * frame_pod_format.length() * frame_pod_format.elem_size());
+		return pod_array_strided_compare(
+			static_cast<const void*>(start()), ndcoord_cat(strides(), frame_pod_format.stride()),
+			static_cast<const void*>(other_vw.start()), ndcoord_cat(other_vw.strides(), frame_pod_format.stride()),
+			ndcoord_cat(shape(), frame_pod_format.length()),
+			frame_pod_format.elem_size()
+		);
+	} else {
+		return compare_(other, std::false_type());
+	}
+}
+
+
+template<std::size_t Dim, bool Mutable, typename Frame_format, template<std::size_t,typename> class Base_view>
+template<typename Other_view>
+bool ndarray_opaque_view_wrapper<Dim, Mutable, Frame_format, Base_view>::compare_(const Other_view& other, std::false_type) const {
+	if(has_pod_format() && other.has_pod_format() && pod_format() == other.pod_format() && strides_order() == other.strides_order()) {
+		TLZ_ND_INSTRUMENT(opaque_compare_pod_contiguous, shape().product() * frame_format().size());
+		return pod_array_compare(start(), other.start(), pod_format());
+	} else {
+		TLZ_ND_INSTRUMENT(opaque_compare_handles, shape().product() * frame_format().size());
+		auto it = begin();
+		for(const auto& other_view : other) {
+			bool frame_equal = (it++)->frame_handle().compare(other_view.frame_handle());
+			if(! frame_equal) return false;
+		}
+		return true;
+	}
+}
+
+
 template<std::size_t Dim, bool Mutable1, bool Mutable2, typename Frame_format, template<std::size_t,typename> class Base_view>
 bool same(const ndarray_opaque_view_wrapper<Dim, Mutable1, Frame_format, Base_view>& a, const ndarray_opaque_view_wrapper<Dim, Mutable2, Frame_format, Base_view>& b) {
 	return same(a.base_view(), b.base_view()) && (a.frame_format() == b.frame_format());
@@ -9,8 +9,51 @@
 #include "../ndarray_view.h"
 #include "../ndcoord.h"
 #include "../pod_array_format.h"
+#include "../instrumentation.h"
+
+namespace tlz {
+
+/// Whether an \ref ndarray may keep using a buffer from \a Allocator which is larger than needed.
+/** Set to `false` for allocators where the allocation size is significant, such as \ref mirrored_ring_allocator. Then
+ ** the buffer is always reallocated when the needed size changes. */
+template<typename Allocator>
+constexpr bool allocator_allows_spare_capacity = true;
+
+namespace detail {
+
+/// Memory buffer allocated with \a Allocator, owned by a container.
+/** Allocates through `hybrid_allocator_traits`, so that \a Allocator can be a standard or a raw allocator, and counts
+ ** allocations and deallocations with instrumentation. Does not construct or destruct elements. */
+template<typename Allocator>
+class ndarray_buffer {
+private:
+	Allocator allocator_; ///< Raw allocator used to allocate memory.
+	std::size_t size_ = 0; ///< Allocated memory size, in bytes.
+	void* buffer_ = nullptr; ///< Allocated memory.
+
+	void allocate_(std::size_t size, std::size_t alignment);
+
+public:
+	explicit ndarray_buffer(const Allocator& allocator = Allocator()) : allocator_(allocator) { }
+	ndarray_buffer(ndarray_buffer&&);
+	ndarray_buffer(const ndarray_buffer&) = delete;
+	~ndarray_buffer() { deallocate(); }
+
+	ndarray_buffer& operator=(ndarray_buffer&&);
+	ndarray_buffer& operator=(const ndarray_buffer&) = delete;
+
+	/// Make buffer hold \a size bytes with \a alignment, and reallocate only if necessary.
+	/** Keeps the current buffer if it is large enough and has the alignment, i.e. never reallocates when shrinking,
+	 ** unless `allocator_allows_spare_capacity<Allocator>` is false. The contents are not preserved when reallocating. */
+	void reset(std::size_t size, std::size_t alignment);
+
+	void deallocate();
+
+	void* get() const { return buffer_; }
+	std::size_t size() const { return size_; }
+	const Allocator& get_allocator() const { return allocator_; }
+};
 
-namespace tlz { namespace detail {
 
 #define WRAP_VIEW_FUNCTION(__func__) \
 	template<typename... Args> decltype(auto) __func__(Args&&... args) { \
@@ -37,12 +80,7 @@ public:
 	using strides_type = typename view_type::strides_type;
 	
 private:
-	void allocate_(std::size_t allocate_size, std::size_t alignment);
-	void deallocate_();
-
-	Allocator allocator_; ///< Raw allocator used to allocate memory.
-	std::size_t allocated_size_ = 0; ///< Allocated memory size, in bytes.
-	void* allocated_buffer_ = nullptr; ///< Allocated memory.
+	ndarray_buffer<Allocator> buffer_; ///< Allocated memory.
 	view_type view_; ///< View to allocated memory.
 
 protected:
@@ -66,6 +104,9 @@ protected:
 	
 	ndarray_wrapper& operator=(ndarray_wrapper&&);
 	
+	/// Reset view to new shape and strides, and reallocate only if necessary.
+	/** Keeps the current buffer if it is at least \a allocate_size bytes large and has the alignment. Does not
+	 ** construct, destruct or copy elements. */
 	template<typename... Arg>
 	void reset_(
 		const shape_type& shape,
@@ -81,8 +122,9 @@ public:
 	///@{
 	~ndarray_wrapper();
 	
-	std::size_t allocated_byte_size() const { return allocated_size_; }
-	const allocator_type& get_allocator() const { return allocator_; }
+	/// Size of allocated buffer in bytes. May be larger than what the view currently covers.
+	std::size_t allocated_byte_size() const { return buffer_.size(); }
+	const allocator_type& get_allocator() const { return buffer_.get_allocator(); }
 	///@}
 	
 	
@@ -94,7 +136,7 @@ public:
 	const_view_type cview() const { return const_view_type(view_);  }
 	
 	operator const view_type& () { return view(); }
-	operator const const_view_type& () const { return cview(); }
+	operator const_view_type () const { return cview(); }
 	///@}
 	
 	
@@ -107,8 +149,9 @@ public:
 	WRAP_VIEW_FUNCTION(strides)
 	WRAP_VIEW_FUNCTION(size)
 	WRAP_VIEW_FUNCTION(full_span)
+	WRAP_VIEW_FUNCTION(strides_order)
 	
-	std::size_t allocated_size() const { return allocated_size_; }
+	std::size_t allocated_size() const { return buffer_.size(); }
 	///@}
 	
 	
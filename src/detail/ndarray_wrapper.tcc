@@ -36,26 +36,72 @@ public:
 ///////////////
 
 
-template<typename View, typename Const_view, typename Allocator>
-void ndarray_wrapper<View, Const_view, Allocator>::allocate_(std::size_t size, std::size_t alignment) {
+template<typename Allocator>
+void ndarray_buffer<Allocator>::allocate_(std::size_t size, std::size_t alignment) {
 	if(size > 0) {
 		void* buf = hybrid_allocator_traits<Allocator>::allocate(allocator_, size, alignment);
-		allocated_size_ = size;
-		allocated_buffer_ = buf;
+		TLZ_ND_INSTRUMENT(allocation, size);
+		size_ = size;
+		buffer_ = buf;
 	}
 }
 
 
-template<typename View, typename Const_view, typename Allocator>
-void ndarray_wrapper<View, Const_view, Allocator>::deallocate_() {
-	if(allocated_size_ != 0) {
-		hybrid_allocator_traits<Allocator>::deallocate(allocator_, allocated_buffer_, allocated_size_);
-		allocated_size_ = 0;
-		allocated_buffer_ = nullptr;
+template<typename Allocator>
+void ndarray_buffer<Allocator>::deallocate() {
+	if(size_ != 0) {
+		hybrid_allocator_traits<Allocator>::deallocate(allocator_, buffer_, size_);
+		TLZ_ND_INSTRUMENT(deallocation, size_);
+		size_ = 0;
+		buffer_ = nullptr;
 	}
 }
 
 
+template<typename Allocator>
+ndarray_buffer<Allocator>::ndarray_buffer(ndarray_buffer&& buf) :
+	allocator_(std::move(buf.allocator_)),
+	size_(buf.size_),
+	buffer_(buf.buffer_)
+{
+	buf.size_ = 0;
+	buf.buffer_ = nullptr;
+}
+
+
+template<typename Allocator>
+auto ndarray_buffer<Allocator>::operator=(ndarray_buffer&& buf) -> ndarray_buffer& {
+	if(&buf == this) return *this;
+	
+	deallocate();
+	
+	allocator_ = std::move(buf.allocator_);
+	size_ = buf.size_;
+	buffer_ = buf.buffer_;
+	
+	buf.size_ = 0;
+	buf.buffer_ = nullptr;
+	
+	return *this;
+}
+
+
+template<typename Allocator>
+void ndarray_buffer<Allocator>::reset(std::size_t size, std::size_t alignment) {
+	// reallocate memory only if necessary, never when shrinking
+	bool fits = allocator_allows_spare_capacity<Allocator>
+		? (size <= size_)
+		: (size == size_);
+	if(! fits || ! is_aligned(buffer_, alignment)) {
+		deallocate();
+		allocate_(size, alignment);
+	}
+}
+
+
+///////////////
+
+
 template<typename View, typename Const_view, typename Allocator> template<typename... Arg>
 ndarray_wrapper<View, Const_view, Allocator>::ndarray_wrapper(
 	const shape_type& shape,
@@ -65,50 +111,38 @@ ndarray_wrapper<View, Const_view, Allocator>::ndarray_wrapper(
 	const Allocator& allocator,
 	const Arg&... view_arguments
 ) :
-	allocator_(allocator)
+	buffer_(allocator)
 {
-	allocate_(allocate_size, allocate_alignment);
+	buffer_.reset(allocate_size, allocate_alignment);
 	view_.reset(view_type(
-		static_cast<typename view_type::pointer>(allocated_buffer_),
+		static_cast<typename view_type::pointer>(buffer_.get()),
 		shape,
 		strides,
 		view_arguments...
 	));
-	Assert(static_cast<void*>(view_.start()) == allocated_buffer_, "first element in ndarray must be at buffer start");
+	Assert(static_cast<void*>(view_.start()) == buffer_.get(), "first element in ndarray must be at buffer start");
 }
 	
 
 template<typename View, typename Const_view, typename Allocator>
 ndarray_wrapper<View, Const_view, Allocator>::ndarray_wrapper(ndarray_wrapper&& arr) :
-	allocator_(),
-	allocated_size_(arr.allocated_size_),
-	allocated_buffer_(arr.allocated_buffer_),
+	buffer_(std::move(arr.buffer_)),
 	view_(arr.view_)
 {
 	arr.view_.reset();
-	arr.allocated_size_ = 0;
-	arr.allocated_buffer_ = nullptr;
 }
 		
 
 template<typename View, typename Const_view, typename Allocator>
-ndarray_wrapper<View, Const_view, Allocator>::~ndarray_wrapper() {
-	deallocate_();
-}
+ndarray_wrapper<View, Const_view, Allocator>::~ndarray_wrapper() { }
 
 
 template<typename View, typename Const_view, typename Allocator>
 auto ndarray_wrapper<View, Const_view, Allocator>::operator=(ndarray_wrapper&& arr) -> ndarray_wrapper& {
 	if(&arr == this) return *this;
 	
-	deallocate_();
-	
-	allocated_size_ = arr.allocated_size_;
-	allocated_buffer_ = arr.allocated_buffer_;
+	buffer_ = std::move(arr.buffer_);
 	view_.reset(arr.view_);
-	
-	arr.allocated_size_ = 0;
-	arr.allocated_buffer_ = nullptr;
 	arr.view_.reset();
 	
 	return *this;
@@ -122,20 +156,14 @@ void ndarray_wrapper<View, Const_view, Allocator>::reset_(
 	std::size_t allocate_size,
 	std::size_t allocate_alignment,
 	const Arg&... view_arguments
-) {	
-	// reallocate memory only if necessary
-	if(allocate_size != allocated_size() || ! is_aligned(allocated_buffer_, allocate_alignment)) {
-		deallocate_();
-		allocate_(allocate_size, allocate_alignment);
-	}
-	
+) {
+	buffer_.reset(allocate_size, allocate_alignment);
 	view_.reset(view_type(
-		static_cast<typename view_type::pointer>(allocated_buffer_),
+		static_cast<typename view_type::pointer>(buffer_.get()),
 		shape,
 		strides,
 		view_arguments...
 	));
 }
 
-
 }}
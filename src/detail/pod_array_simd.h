@@ -0,0 +1,63 @@
+#ifndef TLZ_NDARRAY_POD_ARRAY_SIMD_H_
+#define TLZ_NDARRAY_POD_ARRAY_SIMD_H_
+
+#include "../config.h"
+#include <cstdlib>
+#include "../common.h"
+
+#if TLZ_ND_WITH_SIMD && (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#define TLZ_ND_SIMD_X86 1
+#else
+#define TLZ_ND_SIMD_X86 0
+#endif
+
+namespace tlz {
+
+/// Instruction set used by the strided POD kernels.
+enum class simd_level { none = 0, sse2, avx2, avx512bw };
+
+/// Highest instruction set supported by the CPU, and by the build.
+simd_level supported_simd_level();
+
+/// Instruction set currently used by pod_array_copy() and pod_array_compare() for strided data.
+simd_level pod_array_simd_level();
+
+/// Restrict the instruction set used by pod_array_copy() and pod_array_compare().
+/** Gets clamped to supported_simd_level(). Mostly useful for testing and benchmarking the kernels. */
+void set_pod_array_simd_level(simd_level);
+
+namespace detail {
+
+constexpr std::size_t pod_array_simd_max_stride = 64;
+
+/// Copy strided POD array using SIMD masked stores.
+/** Returns `false` without doing anything if no kernel applies to the format. Only the element bytes get written,
+ ** padding bytes between elements are left untouched. */
+bool pod_array_simd_copy(void* dest, const void* origin, std::size_t elem_size, std::size_t stride, std::size_t length);
+
+/// Compare strided POD array using SIMD vectorized masked comparison.
+/** Returns `false` without doing anything if no kernel applies to the format. Otherwise writes result to \a equal.
+ ** Returns early at the first block where a difference was found. */
+bool pod_array_simd_compare(const void* a, const void* b, std::size_t elem_size, std::size_t stride, std::size_t length, bool& equal);
+
+/// Copy \a rows x \a cols matrix of POD elements, between column-major source and row-major destination.
+/** Destination element `(r, c)` is at `dest + r * dest_row_stride + c * elem_size`, and source element `(r, c)` is at
+ ** `origin + r * elem_size + c * origin_col_stride`. Gets processed in square tiles that stay in L1 cache. Inside the
+ ** tiles, for element sizes 1, 2, 4 and 8, blocks of 8x8, 8x8, 4x4 and 2x2 elements are transposed in SSE2 registers. */
+void pod_array_transpose_copy(
+	void* dest, std::ptrdiff_t dest_row_stride,
+	const void* origin, std::ptrdiff_t origin_col_stride,
+	std::size_t rows, std::size_t cols, std::size_t elem_size
+);
+
+/// Copy \a size contiguous bytes using non-temporal stores.
+/** Falls back to `std::memcpy` if not supported, or if \a size is too small. */
+void pod_array_stream_copy(void* dest, const void* origin, std::size_t size);
+
+}
+
+}
+
+#include "pod_array_simd.icc"
+
+#endif
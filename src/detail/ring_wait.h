@@ -0,0 +1,52 @@
+#ifndef TLZ_ND_RING_WAIT_H_
+#define TLZ_ND_RING_WAIT_H_
+
+#include "../config.h"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include "../common.h"
+
+namespace tlz {
+
+/// How a ring buffer waits until frames become readable or writable.
+/** Busy-waits for up to \a spin_iterations checks first, which keeps latency minimal when the other side is about to
+ ** make progress. Then sleeps on a futex (on Linux, otherwise yields), so that an idle side uses no CPU time. */
+struct ring_wait_strategy {
+	std::size_t spin_iterations = 4000; ///< Number of busy-wait checks before sleeping.
+	bool sleep = true; ///< If false, only busy-waits and yields, never sleeps in the kernel.
+};
+
+namespace detail {
+
+/// Event on which a thread of a ring buffer can wait, and which other threads signal after making progress.
+/** Signaling is lock-free. It costs one atomic increment, and a system call only when a thread is sleeping. */
+class ring_wait_event {
+private:
+	std::atomic<std::uint32_t> epoch_ {0}; ///< Incremented at each signal. Futex word.
+	std::atomic<std::uint32_t> sleepers_ {0}; ///< Number of threads sleeping or about to sleep.
+
+	void futex_wait_(std::uint32_t expected);
+	void futex_wake_all_();
+
+public:
+	/// Wake up threads waiting in wait(). Call after changing the state they are waiting for.
+	void signal() {
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		epoch_.fetch_add(1, std::memory_order_seq_cst);
+		if(sleepers_.load(std::memory_order_seq_cst) != 0) futex_wake_all_();
+	}
+
+	/// Wait until \a ready() returns true, with wait strategy \a strategy.
+	/** \a ready must read the state with (at least) acquire semantics. */
+	template<typename Predicate> void wait(const ring_wait_strategy& strategy, Predicate&& ready);
+};
+
+}
+
+}
+
+#include "ring_wait.icc"
+#include "ring_wait.tcc"
+
+#endif
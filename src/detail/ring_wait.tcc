@@ -0,0 +1,33 @@
+#include <thread>
+
+namespace tlz { namespace detail {
+
+template<typename Predicate>
+void ring_wait_event::wait(const ring_wait_strategy& strategy, Predicate&& ready) {
+	for(std::size_t i = 0; i < strategy.spin_iterations; ++i) {
+		if(ready()) return;
+		#if defined(__x86_64__) || defined(__i386__)
+		__builtin_ia32_pause();
+		#endif
+	}
+	for(;;) {
+		if(! strategy.sleep) {
+			if(ready()) return;
+			std::this_thread::yield();
+			continue;
+		}
+		// announce sleeping before checking the state again, so that a signal() after the state change either sees the
+		// sleeper and wakes it, or changes epoch_ before the futex wait, which then returns immediately
+		std::uint32_t epoch = epoch_.load(std::memory_order_seq_cst);
+		sleepers_.fetch_add(1, std::memory_order_seq_cst);
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		if(ready()) {
+			sleepers_.fetch_sub(1, std::memory_order_seq_cst);
+			return;
+		}
+		futex_wait_(epoch);
+		sleepers_.fetch_sub(1, std::memory_order_seq_cst);
+	}
+}
+
+}}
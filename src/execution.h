@@ -0,0 +1,200 @@
+#ifndef TLZ_ND_EXECUTION_H_
+#define TLZ_ND_EXECUTION_H_
+
+#include "config.h"
+#include <cstddef>
+#include <cstdlib>
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "common.h"
+#include "ndcoord.h"
+
+namespace tlz {
+
+/// Fixed-size pool of worker threads, for parallel execution of \ref ndarray_view operations.
+class thread_pool {
+private:
+	struct parallel_for_state_;
+
+	std::vector<std::thread> workers_;
+	std::deque<std::function<void()>> tasks_;
+	std::mutex mutex_;
+	std::condition_variable condition_;
+	bool stop_ = false;
+	
+	void run_worker_();
+	void submit_(std::function<void()>&&);
+
+public:
+	/// Create pool with \a workers worker threads.
+	explicit thread_pool(std::size_t workers);
+	
+	thread_pool(const thread_pool&) = delete;
+	thread_pool& operator=(const thread_pool&) = delete;
+	
+	/// Stop worker threads, after finishing queued tasks.
+	~thread_pool();
+	
+	/// Shared pool with one worker for each hardware thread, besides the calling thread.
+	static thread_pool& default_pool();
+	
+	/// Number of threads that execute parallel_for(), including the calling thread.
+	std::size_t concurrency() const { return workers_.size() + 1; }
+	
+	/// Call \a func(i) for `i` in `[0, n)`, in parallel, and wait until done.
+	/** The calling thread participates. Indices are claimed dynamically, in increasing order. If a call throws an
+	 ** exception, no further indices are claimed, and the first exception is rethrown in the calling thread. Can be
+	 ** nested: helper tasks that have not yet started when the calling thread is done are skipped. */
+	void parallel_for(std::size_t n, const std::function<void(std::size_t)>& func);
+};
+
+
+namespace execution {
+
+/// Execution policy for sequential execution in calling thread.
+struct sequenced_policy { };
+
+/// Execution policy for parallel execution with thread pool.
+/** The operation gets partitioned along the outermost non-degenerate axis into blocks of at least
+ ** min_block_size() bytes. Smaller operations are executed sequentially in the calling thread.
+ ** With is_deterministic(), the partition depends only on the shape and on min_block_size(), and not on the
+ ** concurrency of the thread pool, so that floating point reductions give reproducible results. */
+class parallel_policy {
+private:
+	thread_pool* pool_ = nullptr;
+	std::size_t min_block_size_ = 256 * 1024;
+	bool deterministic_ = false;
+	
+public:
+	constexpr parallel_policy() = default;
+	
+	/// Thread pool used for execution. thread_pool::default_pool() unless specified with on().
+	thread_pool& pool() const { return (pool_ ? *pool_ : thread_pool::default_pool()); }
+	
+	/// Minimal size in bytes of block processed by one task.
+	std::size_t min_block_size() const { return min_block_size_; }
+	
+	/// Whether partition into blocks is independent of the thread pool.
+	bool is_deterministic() const { return deterministic_; }
+	
+	/// Copy of this policy, executing on thread pool \a pool.
+	parallel_policy on(thread_pool& pool) const { parallel_policy pol = *this; pol.pool_ = &pool; return pol; }
+	
+	/// Copy of this policy, with minimal block size \a sz.
+	parallel_policy with_min_block_size(std::size_t sz) const { parallel_policy pol = *this; pol.min_block_size_ = sz; return pol; }
+	
+	/// Copy of this policy, with deterministic partition into blocks.
+	parallel_policy deterministic(bool det = true) const { parallel_policy pol = *this; pol.deterministic_ = det; return pol; }
+};
+
+/// Execution policy for parallel execution with thread pool, and vectorized execution in each block.
+/** Same as \ref parallel_policy: the per-block POD copy and compare kernels are already vectorized. */
+class parallel_unsequenced_policy : public parallel_policy {
+public:
+	constexpr parallel_unsequenced_policy() = default;
+	explicit parallel_unsequenced_policy(const parallel_policy& pol) : parallel_policy(pol) { }
+	
+	parallel_unsequenced_policy on(thread_pool& pool) const
+		{ return parallel_unsequenced_policy(parallel_policy::on(pool)); }
+	parallel_unsequenced_policy with_min_block_size(std::size_t sz) const
+		{ return parallel_unsequenced_policy(parallel_policy::with_min_block_size(sz)); }
+	parallel_unsequenced_policy deterministic(bool det = true) const
+		{ return parallel_unsequenced_policy(parallel_policy::deterministic(det)); }
+};
+
+constexpr sequenced_policy seq { };
+constexpr parallel_policy par { };
+constexpr parallel_unsequenced_policy par_unseq { };
+
+}
+
+
+namespace detail {
+
+/// Partition of a shape into blocks along one of its axes.
+struct axis_partition {
+	std::ptrdiff_t axis;
+	std::size_t extent; ///< Length of the shape along \a axis.
+	std::size_t blocks; ///< Number of blocks, at least 1.
+	
+	std::ptrdiff_t block_start(std::size_t b) const { return (b * extent) / blocks; }
+	std::ptrdiff_t block_end(std::size_t b) const { return ((b + 1) * extent) / blocks; }
+};
+
+/// Partition \a shape with elements of size \a elem_size along \a axis, as specified by \a pol.
+template<std::size_t Dim>
+axis_partition make_axis_partition(const execution::parallel_policy& pol, const ndsize<Dim>& shape, std::ptrdiff_t axis, std::size_t elem_size) {
+	std::size_t extent = shape[axis];
+	std::size_t total_size = shape.product() * elem_size;
+	std::size_t blocks = std::min(extent, total_size / std::max<std::size_t>(pol.min_block_size(), 1));
+	if(! pol.is_deterministic() && blocks > 1) {
+		std::size_t concurrency = pol.pool().concurrency();
+		if(concurrency == 1) blocks = 1;
+		else blocks = std::min(blocks, 4 * concurrency); // some more blocks than threads, for load balancing
+	}
+	return axis_partition { axis, extent, std::max<std::size_t>(blocks, 1) };
+}
+
+/// Partition \a shape along its outermost non-degenerate axis in index order.
+/** Each block then covers a range of consecutive indices. */
+template<std::size_t Dim>
+axis_partition make_axis_partition(const execution::parallel_policy& pol, const ndsize<Dim>& shape, std::size_t elem_size) {
+	std::ptrdiff_t axis = 0;
+	while(axis < std::ptrdiff_t(Dim) - 1 && shape[axis] == 1) ++axis;
+	return make_axis_partition(pol, shape, axis, elem_size);
+}
+
+/// Partition \a shape along its non-degenerate axis with the largest absolute stride in \a strides.
+/** This is the outermost axis in memory of the view with \a strides, so that blocks written by different threads do
+ ** not share cache lines, also for column-major or otherwise permuted views. */
+template<std::size_t Dim>
+axis_partition make_axis_partition(const execution::parallel_policy& pol, const ndsize<Dim>& shape, const ndptrdiff<Dim>& strides, std::size_t elem_size) {
+	std::ptrdiff_t axis = -1;
+	for(std::ptrdiff_t i = 0; i < Dim; ++i) {
+		if(shape[i] == 1) continue;
+		if(axis == -1 || std::abs(strides[i]) > std::abs(strides[axis])) axis = i;
+	}
+	if(axis == -1) axis = Dim - 1;
+	return make_axis_partition(pol, shape, axis, elem_size);
+}
+
+/// Call `func(b)` for each block of \a part, in parallel on the thread pool of \a pol.
+template<typename Function>
+void parallel_partition_blocks(const execution::parallel_policy& pol, const axis_partition& part, Function&& func) {
+	if(part.blocks == 1) {
+		func(0);
+		return;
+	}
+	thread_pool& pool = pol.pool();
+	if(pool.concurrency() == 1) for(std::size_t b = 0; b < part.blocks; ++b) func(b);
+	else pool.parallel_for(part.blocks, [&](std::size_t b) { func(b); });
+}
+
+/// Partition \a shape into blocks along outermost axis in memory, and call `func(axis, start, end)` in parallel.
+/** The axis is chosen by make_axis_partition() from \a strides, which are those of the view that gets written.
+ ** Executes sequentially with one call when the total size \a shape times \a elem_size is too small for \a pol. */
+template<std::size_t Dim, typename Function>
+void parallel_axis_blocks(
+	const execution::parallel_policy& pol, const ndsize<Dim>& shape, const ndptrdiff<Dim>& strides, std::size_t elem_size,
+	Function&& func
+) {
+	axis_partition part = make_axis_partition(pol, shape, strides, elem_size);
+	parallel_partition_blocks(pol, part, [&](std::size_t b) {
+		func(part.axis, part.block_start(b), part.block_end(b));
+	});
+}
+}
+
+}
+
+#include "execution.icc"
+
+#endif
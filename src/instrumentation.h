@@ -0,0 +1,113 @@
+#ifndef TLZ_ND_INSTRUMENTATION_H_
+#define TLZ_ND_INSTRUMENTATION_H_
+
+#include "config.h"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace tlz {
+
+/// Implementation path taken by an operation, counted when instrumentation is enabled.
+/** `_pod` paths copy or compare raw memory with \ref pod_array_format functions. `_runs` paths loop over contiguous
+ ** runs of elements. `_iterator` paths are the generic fallback with `std::copy` or `std::equal` over iterators.
+ ** `_segments` paths split a wraparound operand into non-wrapping segments, which are then counted again. */
+enum class instrumented_path : std::size_t {
+	view_assign_pod,
+	view_assign_runs,
+	view_assign_iterator,
+	view_assign_segments,
+	view_compare_pod,
+	view_compare_runs,
+	view_compare_iterator,
+	view_compare_segments,
+
+	wraparound_assign_segments,
+	wraparound_assign_iterator,
+	wraparound_compare_segments,
+	wraparound_compare_iterator,
+
+	opaque_assign_pod_strided, ///< Frames and frame elements copied as one strided POD array.
+	opaque_assign_pod_contiguous, ///< Whole view copied as one POD array.
+	opaque_assign_pod_frames, ///< POD frames copied one by one.
+	opaque_assign_handles, ///< Non-POD frames assigned one by one through frame handles.
+	opaque_compare_pod_strided,
+	opaque_compare_pod_contiguous,
+	opaque_compare_handles,
+	frame_handle_assign, ///< Frame copied by frame handle of \ref opaque_raw_format or \ref opaque_ndarray_format.
+	frame_handle_compare, ///< Frames compared by frame handle. Self-assignment and self-comparison are not counted.
+
+	iterator_recompute, ///< ndarray_iterator moved past contiguous run, and recomputed pointer from coordinates.
+
+	allocation, ///< Buffer allocated by \ref ndarray or \ref ndarray_opaque.
+	deallocation,
+
+	count_
+};
+
+constexpr std::size_t instrumented_path_count = static_cast<std::size_t>(instrumented_path::count_);
+
+/// Name of \a path, for export to metrics systems.
+const char* instrumented_path_name(instrumented_path path);
+
+
+/// Number of times a path was taken, and total number of bytes processed by it.
+struct instrumentation_count {
+	std::uint64_t calls = 0;
+	std::uint64_t bytes = 0;
+};
+
+
+/// Values of all instrumentation counters at one point in time.
+struct instrumentation_snapshot {
+	std::array<instrumentation_count, instrumented_path_count> counts;
+
+	const instrumentation_count& operator[](instrumented_path path) const
+		{ return counts[static_cast<std::size_t>(path)]; }
+	instrumentation_count& operator[](instrumented_path path)
+		{ return counts[static_cast<std::size_t>(path)]; }
+};
+
+
+/// Whether the library was compiled with instrumentation, i.e. with `TLZ_ND_WITH_INSTRUMENTATION`.
+constexpr bool instrumentation_enabled = TLZ_ND_WITH_INSTRUMENTATION;
+
+/// Counters summed over all threads, including ended threads, since last reset_instrumentation().
+/** All zero if instrumentation is disabled. */
+instrumentation_snapshot instrumentation_totals();
+
+/// Counters of the calling thread since last reset_instrumentation().
+instrumentation_snapshot thread_instrumentation_totals();
+
+/// Restart counting from zero, for all threads.
+/** Counting threads are not interrupted. The counters are not modified, but the current values are stored as new
+ ** baseline, and subtracted in snapshots. */
+void reset_instrumentation();
+
+
+namespace detail {
+
+#if TLZ_ND_WITH_INSTRUMENTATION
+/// Count one call of \a path processing \a bytes bytes, in counters of calling thread.
+void instrument(instrumented_path path, std::size_t bytes);
+#endif
+
+}
+
+}
+
+
+/// Count one call of path \a __path__ of \ref instrumented_path, processing \a __bytes__ bytes.
+/** Expands to nothing, and does not evaluate the arguments, when instrumentation is disabled. */
+#if TLZ_ND_WITH_INSTRUMENTATION
+	#define TLZ_ND_INSTRUMENT(__path__, __bytes__) \
+		::tlz::detail::instrument(::tlz::instrumented_path::__path__, (__bytes__))
+#else
+	#define TLZ_ND_INSTRUMENT(__path__, __bytes__) \
+		(void)0
+#endif
+
+
+#include "instrumentation.icc"
+
+#endif
@@ -0,0 +1,96 @@
+#ifndef TLZ_ND_MAPPED_FILE_H_
+#define TLZ_ND_MAPPED_FILE_H_
+
+#include "config.h"
+#if TLZ_ND_WITH_MMAP
+
+#include <cstddef>
+#include <string>
+#include "common.h"
+
+namespace tlz {
+
+/// Access mode of \ref mapped_file.
+enum class mapped_file_mode {
+	read_only, ///< Read-only shared mapping.
+	read_write, ///< Read-write shared mapping, modifications are written back to the file.
+	copy_on_write ///< Read-write private mapping, modifications are not written back to the file.
+};
+
+/// Access pattern hint for \ref mapped_file, passed to `madvise`.
+enum class mapped_access_hint { normal, sequential, random, will_need, dont_need };
+
+
+/// Memory-mapped section of a file.
+/** Maps the byte range `[offset, offset + size)` of a file into memory. The offset needs not be page-aligned. Pages get
+ ** loaded lazily when they are first accessed. Move-only, unmaps the file when destructed. Failures of the underlying
+ ** system calls are reported as `std::system_error`. */
+class mapped_file {
+private:
+	void* mapping_ = nullptr; ///< Page-aligned start of mapping.
+	std::size_t mapping_size_ = 0; ///< Size of mapping, in bytes.
+	void* data_ = nullptr; ///< Start of mapped section in mapping.
+	std::size_t size_ = 0; ///< Size of mapped section, in bytes.
+	mapped_file_mode mode_ = mapped_file_mode::read_only;
+	
+	void unmap_();
+
+public:
+	/// Size value to map the file until its end.
+	static constexpr std::size_t whole_file = std::size_t(-1);
+
+	/// \name Construction
+	///@{
+	mapped_file() = default;
+	
+	/// Map section of \a size bytes of file at \a path, starting at byte \a offset.
+	/** The section must lie inside the file. With mapped_file::whole_file, maps until the end of the file. */
+	explicit mapped_file(const std::string& path, mapped_file_mode = mapped_file_mode::read_only, std::size_t offset = 0, std::size_t size = whole_file);
+	
+	/// Create or truncate file at \a path to \a size bytes, and map it in read-write mode.
+	static mapped_file create(const std::string& path, std::size_t size);
+	
+	mapped_file(const mapped_file&) = delete;
+	mapped_file(mapped_file&&);
+	
+	mapped_file& operator=(const mapped_file&) = delete;
+	mapped_file& operator=(mapped_file&&);
+	
+	~mapped_file();
+	///@}
+	
+	
+	/// \name Attributes
+	///@{
+	void* data() { return data_; }
+	const void* data() const { return data_; }
+	std::size_t size() const { return size_; }
+	mapped_file_mode mode() const { return mode_; }
+	bool is_writable() const { return (mode_ != mapped_file_mode::read_only); }
+	bool is_null() const { return (mapping_ == nullptr); }
+	explicit operator bool () const { return ! is_null(); }
+	///@}
+	
+	
+	/// \name Operations
+	///@{
+	/// Give access pattern hint for whole mapped section.
+	void advise(mapped_access_hint);
+	
+	/// Give access pattern hint for \a size bytes of mapped section starting at byte \a offset.
+	/** Range is extended to page boundaries. */
+	void advise(mapped_access_hint, std::size_t offset, std::size_t size);
+	
+	/// Write back modifications to the file.
+	/** Blocks until done, unless \a asynchronous. Does nothing if the mapping is not shared and writable. */
+	void flush(bool asynchronous = false);
+	///@}
+};
+
+}
+
+#include "mapped_file.icc"
+
+#endif
+
+#endif
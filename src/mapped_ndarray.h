@@ -0,0 +1,61 @@
+#ifndef TLZ_ND_MAPPED_NDARRAY_H_
+#define TLZ_ND_MAPPED_NDARRAY_H_
+
+#include "config.h"
+#if TLZ_ND_WITH_MMAP
+
+#include <string>
+#include <type_traits>
+#include "common.h"
+#include "ndarray_view.h"
+#include "mapped_file.h"
+#include "detail/ndarray_mapped_wrapper.h"
+
+namespace tlz {
+
+/// \ref ndarray_view to content of memory-mapped file.
+/** Opening is constant-time: only the address range gets mapped, and pages are loaded lazily on access. \a Elem must
+ ** be a POD type, and can be `const`. A non-`const` \a Elem requires a writable mode. The first element is at byte
+ ** \a offset in the file, and the file must contain all the elements with the given strides. */
+template<std::size_t Dim, typename Elem>
+class mapped_ndarray : public detail::ndarray_mapped_wrapper<ndarray_view<Dim, Elem>, ndarray_view<Dim, const Elem>> {
+	static_assert(std::is_pod<Elem>::value, "mapped_ndarray Elem must be POD");
+	
+	using base = detail::ndarray_mapped_wrapper<ndarray_view<Dim, Elem>, ndarray_view<Dim, const Elem>>;
+	
+public:
+	using typename base::view_type;
+	using typename base::const_view_type;
+	using typename base::shape_type;
+	using typename base::strides_type;
+	
+	using value_type = std::remove_const_t<Elem>;
+	
+	/// Default mode, read-only for `const` \a Elem.
+	static constexpr mapped_file_mode default_mode =
+		std::is_const<Elem>::value ? mapped_file_mode::read_only : mapped_file_mode::read_write;
+	
+	/// Map array with given shape and strides from file at \a path.
+	mapped_ndarray(const std::string& path, const shape_type& shape, const strides_type& strides, mapped_file_mode mode = default_mode, std::size_t offset = 0) :
+	base(path, mode, offset, shape, strides, sizeof(Elem), alignof(Elem)) {
+		Assert(std::is_const<Elem>::value || mode != mapped_file_mode::read_only, "mutable mapped_ndarray cannot be read-only");
+	}
+	
+	/// Map array with given shape and default strides from file at \a path.
+	mapped_ndarray(const std::string& path, const shape_type& shape, mapped_file_mode mode = default_mode, std::size_t offset = 0) :
+		mapped_ndarray(path, shape, view_type::default_strides(shape), mode, offset) { }
+	
+	/// Create or truncate file at \a path to hold array with given shape and default strides, and map it.
+	static mapped_ndarray create(const std::string& path, const shape_type& shape) {
+		mapped_file::create(path, sizeof(Elem) * shape.product());
+		return mapped_ndarray(path, shape, mapped_file_mode::read_write);
+	}
+	
+	mapped_ndarray(mapped_ndarray&&) = default;
+	mapped_ndarray& operator=(mapped_ndarray&&) = default;
+};
+
+}
+
+#endif
+#endif
@@ -13,14 +13,22 @@
 #include "ndcoord_dyn.h"
 #include "ndspan.h"
 #include "ndspan_iterator.h"
+#include "ndarray_order.h"
 
 #include "pod_array_format.h"
+#include "pod_array_strided.h"
+#include "execution.h"
+#include "instrumentation.h"
 
 #include "ndarray_traits.h"
 #include "ndarray_view.h"
 #include "ndarray_iterator.h"
+#include "ndarray_traversal.h"
 #include "ndarray_view_cast.h"
 #include "ndarray_view_operations.h"
+#include "ndarray_expression.h"
+#include "ndarray_reduction.h"
+#include "ndarray_tiled_view.h"
 
 #if TLZ_ND_WITH_WRAPAROUND
 	#include "ndarray_wraparound_view.h"
@@ -28,6 +36,9 @@
 
 #if TLZ_ND_WITH_ALLOCATION
 	#include "ndarray.h"
+	#include "ndarray_tiled.h"
+	#include "allocator/pool_allocator.h"
+	#include "allocator/arena_allocator.h"
 #endif
 
 #if TLZ_ND_WITH_OPAQUE
@@ -40,9 +51,27 @@
 	#endif
 	#if TLZ_ND_WITH_ALLOCATION
 		#include "opaque/ndarray_opaque.h"
+		#if TLZ_ND_WITH_WRAPAROUND
+			#include "opaque/spsc_ring_buffer.h"
+			#include "opaque/broadcast_ring_buffer.h"
+		#endif
 	#endif
 	#include "opaque_format/ndarray.h"
 	#include "opaque_format/raw.h"
 #endif
 
+#if TLZ_ND_WITH_MMAP
+	#include "mapped_file.h"
+	#include "mapped_ndarray.h"
+	#if TLZ_ND_WITH_OPAQUE
+		#include "opaque/mapped_ndarray_opaque.h"
+	#endif
+	#if TLZ_ND_WITH_ALLOCATION
+		#include "allocator/mirrored_ring_allocator.h"
+		#include "allocator/huge_page_allocator.h"
+		#include "allocator/numa_allocator.h"
+		#include "chunked_ndarray.h"
+	#endif
+#endif
+
 #endif
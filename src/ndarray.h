@@ -4,6 +4,8 @@
 #include "config.h"
 #if TLZ_ND_WITH_ALLOCATION
 
+#include <algorithm>
+#include <cstring>
 #include <memory>
 #include <initializer_list>
 #include <type_traits>
@@ -26,6 +28,8 @@ public:
 	using typename base::const_view_type;
 	using typename base::shape_type;
 	using typename base::strides_type;
+	using order_type = typename view_type::order_type;
+	using coordinates_type = typename view_type::coordinates_type;
 	
 	using value_type = Elem;
 	using pointer = Elem*;
@@ -39,8 +43,26 @@ private:
 	template<typename Other_view, typename U = void>
 	using enable_if_convertible_ = std::enable_if_t<is_convertible_ndarray_view<Other_view, ndarray>::value, U>;
 	
+	template<typename Expr, typename U = void>
+	using enable_if_expression_ = std::enable_if_t<is_ndarray_expression<Expr>::value, U>;
+	
 	void construct_elems_();
 	void destruct_elems_();
+	static void construct_elems_(const view_type&);
+	static void destruct_elems_(const view_type&);
+	
+	/// Construct with given shape and strides, in buffer of \a allocate_size bytes.
+	ndarray(const Allocator&, const shape_type&, const strides_type&, std::size_t allocate_size);
+	
+	std::size_t required_byte_size_() const;
+	std::size_t elem_stride_() const; ///< Size of element with its padding.
+	void reallocate_(std::size_t allocate_size);
+
+	/// Move elements of \a from into corresponding elements of \a to, in the same buffer.
+	/** Both views have default strides for \a order. Elements are visited in ascending address order if \a ascending is
+	 ** set, otherwise in descending order, so that elements which are still to be moved are not overwritten if all
+	 ** of them move towards the start, resp. the end, of the buffer. Elements of \a to must be constructed. */
+	static void relocate_elems_(const view_type& from, const view_type& to, const order_type& order, bool ascending);
 
 	static ndarray from_initializer_list_(initializer_list_type, std::size_t elem_padding, const Allocator&);
 	
@@ -56,6 +78,19 @@ public:
 	template<typename Other_view, typename = enable_if_convertible_<Other_view>>
 	explicit ndarray(const Other_view& vw, std::size_t elem_padding = 0, const Allocator& = Allocator());
 	
+	/// Construct empty \ref ndarray with given shape and storage order.
+	/** Has default strides for \a order, for example `storage_order::column_major`. */
+	ndarray(const shape_type& shape, const order_type& order, std::size_t elem_padding = 0, const Allocator& = Allocator());
+	
+	/// Construct \ref ndarray with given storage order and copy of elements from a \ref ndarray_view.
+	template<typename Other_view, typename = enable_if_convertible_<Other_view>>
+	ndarray(const Other_view& vw, const order_type& order, std::size_t elem_padding = 0, const Allocator& = Allocator());
+	
+	/// Construct \ref ndarray with shape and result of element-wise \ref ndarray_expression.
+	/** The expression is evaluated in one pass into the new array, which has default strides. */
+	template<typename Expr, enable_if_expression_<Expr, int> = 0>
+	explicit ndarray(const Expr& expr, std::size_t elem_padding = 0, const Allocator& = Allocator());
+	
 	
 	/// Copy-construct from another \ref ndarray of same type.
 	/** Takes strides from \a arr. */
@@ -86,6 +121,12 @@ public:
 	enable_if_convertible_<Other_view, ndarray&> operator=(const Other_view& vw)
 		{ assign(vw); return *this; }
 	
+	/// Assign shape and result of element-wise \ref ndarray_expression.
+	/** Evaluates in place if the shape is unchanged, then the expression may refer to elements of this array at the
+	 ** same coordinates. */
+	template<typename Expr>
+	enable_if_expression_<Expr, ndarray&> operator=(const Expr& expr);
+	
 	ndarray& operator=(initializer_list_type init);
 
 	/// Copy-assign from another \ref ndarray.
@@ -96,6 +137,27 @@ public:
 	/** Takes strides from \a arr and sets \a arr to null. */
 	ndarray& operator=(ndarray&& arr);
 	///@}
+	
+	
+	/// \name Capacity
+	///@{
+	/// Number of elements that fit into the allocated buffer, with the current element padding.
+	/** Assignments and resizes which need no more than this, and keep the padding, do not reallocate. */
+	std::size_t capacity() const { return base::allocated_byte_size() / elem_stride_(); }
+	
+	/// Reallocate so that capacity() is at least \a n elements, with their padding. Keeps shape, strides and elements.
+	void reserve(std::size_t n);
+	
+	/// Reallocate so that the buffer is no larger than needed for the current shape. Keeps strides and elements.
+	void shrink_to_fit();
+	
+	/// Change shape to \a shape, keeping storage order and element padding.
+	/** Reuses the buffer if the capacity is sufficient, and never reallocates when the array gets smaller.
+	 ** If \a preserve is set, elements in the overlapping region of the old and new shape keep their values. They are
+	 ** moved within the buffer if it is large enough, and stay in place if only the outermost axis in storage order
+	 ** changes. Other elements are default-initialized. */
+	void resize(const shape_type& shape, bool preserve = false);
+	///@}
 };
 
 
@@ -11,9 +11,15 @@ auto ndarray<Dim, Elem, Allocator>::from_initializer_list_
 
 template<std::size_t Dim, typename Elem, typename Allocator>
 ndarray<Dim, Elem, Allocator>::ndarray(const shape_type& shape, std::size_t elem_padding, const Allocator& allocator) :
+	ndarray(shape, order_type(), elem_padding, allocator) { }
+
+
+template<std::size_t Dim, typename Elem, typename Allocator>
+ndarray<Dim, Elem, Allocator>::ndarray
+(const shape_type& shape, const order_type& order, std::size_t elem_padding, const Allocator& allocator) :
 base(
 	shape,
-	view_type::default_strides(shape, elem_padding),
+	view_type::default_strides(shape, order, elem_padding),
 	(sizeof(Elem) + elem_padding) * shape.product(),
 	alignof(Elem),
 	allocator
@@ -25,9 +31,15 @@ base(
 template<std::size_t Dim, typename Elem, typename Allocator> template<typename Other_view, typename>
 ndarray<Dim, Elem, Allocator>::ndarray
 (const Other_view& vw, std::size_t elem_padding, const Allocator& allocator) :
+	ndarray(vw, order_type(), elem_padding, allocator) { }
+
+
+template<std::size_t Dim, typename Elem, typename Allocator> template<typename Other_view, typename>
+ndarray<Dim, Elem, Allocator>::ndarray
+(const Other_view& vw, const order_type& order, std::size_t elem_padding, const Allocator& allocator) :
 base(
 	vw.shape(),
-	view_type::default_strides(vw.shape(), elem_padding),
+	view_type::default_strides(vw.shape(), order, elem_padding),
 	(sizeof(Elem) + elem_padding) * vw.shape().product(),
 	alignof(Elem),
 	allocator
@@ -38,18 +50,40 @@ base(
 }
 
 
+template<std::size_t Dim, typename Elem, typename Allocator> template<typename Expr, std::enable_if_t<is_ndarray_expression<Expr>::value, int>>
+ndarray<Dim, Elem, Allocator>::ndarray
+(const Expr& expr, std::size_t elem_padding, const Allocator& allocator) :
+base(
+	expr.shape(),
+	view_type::default_strides(expr.shape(), elem_padding),
+	(sizeof(Elem) + elem_padding) * expr.shape().product(),
+	alignof(Elem),
+	allocator
+) {
+	construct_elems_();
+	base::view().assign(expr);
+}
+
+
 template<std::size_t Dim, typename Elem, typename Allocator>
-ndarray<Dim, Elem, Allocator>::ndarray(const ndarray& arr) :
+ndarray<Dim, Elem, Allocator>::ndarray
+(const Allocator& allocator, const shape_type& shape, const strides_type& strides, std::size_t allocate_size) :
 base(
-	arr.shape(),
-	arr.strides(),
-	arr.allocated_byte_size(),
+	shape,
+	strides,
+	allocate_size,
 	alignof(Elem),
-	arr.get_allocator()
+	allocator
 ) {
 	construct_elems_();
-	base::view().assign(arr.cview());
-	// TODO copy/move construction
+}
+
+
+template<std::size_t Dim, typename Elem, typename Allocator>
+ndarray<Dim, Elem, Allocator>::ndarray(const ndarray& arr) :
+	ndarray(arr.get_allocator(), arr.shape(), arr.strides(), arr.required_byte_size_())
+{
+	if(arr.size() > 0) base::view().assign(arr.cview());
 }
 
 
@@ -62,7 +96,6 @@ template<std::size_t Dim, typename Elem, typename Allocator>
 ndarray<Dim, Elem, Allocator>::ndarray(initializer_list_type init, std::size_t elem_padding, const Allocator& allocator) :
 	ndarray(from_initializer_list_(init, elem_padding, allocator))
 {
-	construct_elems_();
 	initializer_helper_type::copy_into(init, base::view());
 }
 
@@ -73,17 +106,57 @@ ndarray<Dim, Elem, Allocator>::~ndarray() {
 }
 
 
+template<std::size_t Dim, typename Elem, typename Allocator>
+void ndarray<Dim, Elem, Allocator>::construct_elems_(const view_type& vw) {
+	if(std::is_pod<Elem>::value) return;
+	for_each_run(vw, [](Elem* elem, std::ptrdiff_t n, std::ptrdiff_t stride) {
+		for(std::ptrdiff_t i = 0; i < n; ++i, elem = advance_raw_ptr(elem, stride)) new (elem) Elem;
+	});
+}
+
+
+template<std::size_t Dim, typename Elem, typename Allocator>
+void ndarray<Dim, Elem, Allocator>::destruct_elems_(const view_type& vw) {
+	if(std::is_pod<Elem>::value) return;
+	for_each_run(vw, [](Elem* elem, std::ptrdiff_t n, std::ptrdiff_t stride) {
+		for(std::ptrdiff_t i = 0; i < n; ++i, elem = advance_raw_ptr(elem, stride)) elem->~Elem();
+	});
+}
+
+
 template<std::size_t Dim, typename Elem, typename Allocator>
 void ndarray<Dim, Elem, Allocator>::construct_elems_() {
-	if(! std::is_pod<Elem>::value)
-		for(Elem& elem : *this) new (&elem) Elem;
+	construct_elems_(base::view());
 }
 
 
 template<std::size_t Dim, typename Elem, typename Allocator>
 void ndarray<Dim, Elem, Allocator>::destruct_elems_() {
-	if(! std::is_pod<Elem>::value)
-		for(Elem& elem : *this) elem.~Elem();
+	destruct_elems_(base::view());
+}
+
+
+template<std::size_t Dim, typename Elem, typename Allocator>
+std::size_t ndarray<Dim, Elem, Allocator>::required_byte_size_() const {
+	const view_type& vw = base::get_view_();
+	if(vw.size() == 0) return 0;
+	else return vw.size() * vw.strides()[vw.strides_order().innermost_axis()];
+}
+
+
+template<std::size_t Dim, typename Elem, typename Allocator>
+std::size_t ndarray<Dim, Elem, Allocator>::elem_stride_() const {
+	const view_type& vw = base::get_view_();
+	std::ptrdiff_t stride = vw.strides()[vw.strides_order().innermost_axis()];
+	return std::max<std::size_t>(stride, sizeof(Elem));
+}
+
+
+template<std::size_t Dim, typename Elem, typename Allocator>
+void ndarray<Dim, Elem, Allocator>::reallocate_(std::size_t allocate_size) {
+	ndarray new_arr(base::get_allocator(), base::shape(), base::strides(), allocate_size);
+	if(base::size() > 0) new_arr.view().assign(base::cview());
+	*this = std::move(new_arr);
 }
 
 
@@ -91,16 +164,26 @@ template<std::size_t Dim, typename Elem, typename Allocator> template<typename O
 auto ndarray<Dim, Elem, Allocator>::assign(const Other_view& vw, std::size_t elem_padding)
 -> enable_if_convertible_<Other_view> {
 	Assert(! vw.is_null());
+	destruct_elems_();
 	base::reset_(
 		vw.shape(),
 		view_type::default_strides(vw.shape(), elem_padding),
 		(sizeof(Elem) + elem_padding) * vw.shape().product(),
 		alignof(Elem)
 	);
+	construct_elems_();
 	base::view().assign(vw);
 }
 
 
+template<std::size_t Dim, typename Elem, typename Allocator> template<typename Expr>
+auto ndarray<Dim, Elem, Allocator>::operator=(const Expr& expr) -> enable_if_expression_<Expr, ndarray&> {
+	if(expr.shape() == base::shape()) base::view().assign(expr);
+	else *this = ndarray(expr, 0, base::get_allocator());
+	return *this;
+}
+
+
 template<std::size_t Dim, typename Elem, typename Allocator>
 void ndarray<Dim, Elem, Allocator>::assign(initializer_list_type init) {
 	base::view().assign(init);
@@ -110,19 +193,23 @@ void ndarray<Dim, Elem, Allocator>::assign(initializer_list_type init) {
 template<std::size_t Dim, typename Elem, typename Allocator>
 auto ndarray<Dim, Elem, Allocator>::operator=(const ndarray& arr) -> ndarray& {
 	if(&arr == this) return *this;
+	destruct_elems_();
 	base::reset_(
 		arr.shape(),
 		arr.strides(),
-		arr.allocated_size(),
+		arr.required_byte_size_(),
 		alignof(Elem)
 	);
-	base::view().assign(arr);
+	construct_elems_();
+	if(arr.size() > 0) base::view().assign(arr);
 	return *this;
 }
 
 	
 template<std::size_t Dim, typename Elem, typename Allocator>
 auto ndarray<Dim, Elem, Allocator>::operator=(ndarray&& arr) -> ndarray& {
+	if(&arr == this) return *this;
+	destruct_elems_();
 	base::operator=(std::move(arr));
 	return *this;
 }
@@ -130,12 +217,149 @@ auto ndarray<Dim, Elem, Allocator>::operator=(ndarray&& arr) -> ndarray& {
 
 template<std::size_t Dim, typename Elem, typename Allocator>
 auto ndarray<Dim, Elem, Allocator>::operator=(initializer_list_type init) -> ndarray& {
-	base::operator=(ndarray(init));
+	base::operator=(ndarray(init, 0, base::get_allocator()));
 	return *this;
 }
 
 
 
+template<std::size_t Dim, typename Elem, typename Allocator>
+void ndarray<Dim, Elem, Allocator>::reserve(std::size_t n) {
+	static_assert(allocator_allows_spare_capacity<Allocator>, "ndarray allocator does not allow spare capacity");
+	std::size_t size = n * elem_stride_();
+	if(size > base::allocated_byte_size()) reallocate_(size);
+}
 
+
+template<std::size_t Dim, typename Elem, typename Allocator>
+void ndarray<Dim, Elem, Allocator>::shrink_to_fit() {
+	std::size_t required_size = required_byte_size_();
+	if(required_size < base::allocated_byte_size()) reallocate_(required_size);
 }
 
+
+template<std::size_t Dim, typename Elem, typename Allocator>
+void ndarray<Dim, Elem, Allocator>::relocate_elems_
+(const view_type& from, const view_type& to, const order_type& order, bool ascending) {
+	if(from.size() == 0) return;
+	
+	// loop over axes in storage order, without canonicalization, so that runs are visited in address order
+	const std::ptrdiff_t sign = (ascending ? 1 : -1);
+	shape_type shape;
+	std::array<ndptrdiff<Dim>, 2> strides;
+	Elem* from_origin = from.start();
+	Elem* to_origin = to.start();
+	for(std::ptrdiff_t i = 0; i < Dim; ++i) {
+		std::ptrdiff_t axis = order[i];
+		shape[i] = from.shape()[axis];
+		strides[0][i] = sign * from.strides()[axis];
+		strides[1][i] = sign * to.strides()[axis];
+		if(! ascending) {
+			std::ptrdiff_t last = from.shape()[axis] - 1;
+			from_origin = advance_raw_ptr(from_origin, last * from.strides()[axis]);
+			to_origin = advance_raw_ptr(to_origin, last * to.strides()[axis]);
+		}
+	}
+	detail::strided_loop<Dim, 2> loop(shape, strides);
+	
+	const std::ptrdiff_t count = loop.run_length();
+	const std::ptrdiff_t from_stride = loop.run_strides()[0];
+	const std::ptrdiff_t to_stride = loop.run_strides()[1];
+	const bool contiguous = (from_stride == to_stride) && (from_stride == sign * std::ptrdiff_t(sizeof(Elem)));
+	loop.run([&](const auto& offsets) {
+		Elem* from_elem = advance_raw_ptr(from_origin, offsets[0]);
+		Elem* to_elem = advance_raw_ptr(to_origin, offsets[1]);
+		if(from_elem == to_elem && from_stride == to_stride) return;
+		if(std::is_pod<Elem>::value && contiguous) {
+			if(! ascending) {
+				from_elem = advance_raw_ptr(from_elem, (count - 1) * from_stride);
+				to_elem = advance_raw_ptr(to_elem, (count - 1) * to_stride);
+			}
+			std::memmove(static_cast<void*>(to_elem), static_cast<const void*>(from_elem), count * sizeof(Elem));
+		} else {
+			for(std::ptrdiff_t i = 0; i < count; ++i) {
+				if(to_elem != from_elem) *to_elem = std::move(*from_elem);
+				from_elem = advance_raw_ptr(from_elem, from_stride);
+				to_elem = advance_raw_ptr(to_elem, to_stride);
+			}
+		}
+	});
+}
+
+
+template<std::size_t Dim, typename Elem, typename Allocator>
+void ndarray<Dim, Elem, Allocator>::resize(const shape_type& new_shape, bool preserve) {
+	if(new_shape == base::shape()) return;
+	
+	// keep storage order and padding
+	view_type old_vw = base::view();
+	order_type order = old_vw.strides_order();
+	const bool dense = old_vw.has_default_strides(order);
+	std::size_t elem_padding = 0;
+	if(dense) elem_padding = old_vw.default_strides_padding(order);
+	else order = order_type();
+	strides_type new_strides = view_type::default_strides(new_shape, order, elem_padding);
+	std::size_t new_size = (sizeof(Elem) + elem_padding) * new_shape.product();
+	
+	if(! preserve) {
+		destruct_elems_();
+		base::reset_(new_shape, new_strides, new_size, alignof(Elem));
+		construct_elems_();
+		return;
+	}
+	
+	shape_type overlap;
+	for(std::ptrdiff_t i = 0; i < Dim; ++i) overlap[i] = std::min(old_vw.shape()[i], new_shape[i]);
+	
+	bool in_place = allocator_allows_spare_capacity<Allocator>
+		? (new_size <= base::allocated_byte_size())
+		: (new_size == base::allocated_byte_size());
+	if(! dense || ! in_place) {
+		ndarray new_arr(new_shape, order, elem_padding, base::get_allocator());
+		if(overlap.product() > 0)
+			new_arr.view().section(coordinates_type(0), overlap).assign(old_vw.section(coordinates_type(0), overlap));
+		*this = std::move(new_arr);
+		return;
+	}
+	
+	// preserve in place: the elements occupy the first slots of the buffer, in storage order
+	// first compact the overlap into default strides for its own shape, moving elements towards the start,
+	// then expand it into the new strides, moving elements towards the end
+	const std::size_t elem_stride = sizeof(Elem) + elem_padding;
+	Elem* buffer = old_vw.start();
+	auto slot = [buffer, elem_stride](std::size_t i) { return advance_raw_ptr(buffer, i * elem_stride); };
+	const std::size_t old_count = old_vw.size(), overlap_count = overlap.product(), new_count = new_shape.product();
+	
+	view_type overlap_vw(buffer, overlap, view_type::default_strides(overlap, order, elem_padding));
+	if(overlap != old_vw.shape()) {
+		relocate_elems_(old_vw.section(coordinates_type(0), overlap), overlap_vw, order, true);
+		if(! std::is_pod<Elem>::value) for(std::size_t i = overlap_count; i < old_count; ++i) slot(i)->~Elem();
+	}
+	
+	if(overlap != new_shape) {
+		if(! std::is_pod<Elem>::value) for(std::size_t i = overlap_count; i < new_count; ++i) new (slot(i)) Elem;
+		view_type new_vw(buffer, new_shape, new_strides);
+		relocate_elems_(overlap_vw, new_vw.section(coordinates_type(0), overlap), order, false);
+		
+		// elements outside the overlap, in slots that held elements of the overlap, get default-initialized again
+		if(! std::is_pod<Elem>::value) for(std::ptrdiff_t i = 0; i < Dim; ++i) {
+			if(overlap[i] == new_shape[i]) continue;
+			coordinates_type start(0), end = new_shape;
+			for(std::ptrdiff_t j = 0; j < i; ++j) end[j] = overlap[j];
+			start[i] = overlap[i];
+			for_each_run(new_vw.section(start, end), [&](Elem* elem, std::ptrdiff_t n, std::ptrdiff_t stride) {
+				for(std::ptrdiff_t k = 0; k < n; ++k, elem = advance_raw_ptr(elem, stride)) {
+					if(elem >= slot(overlap_count)) continue;
+					elem->~Elem();
+					new (elem) Elem;
+				}
+			});
+		}
+	}
+	
+	base::reset_(new_shape, new_strides, new_size, alignof(Elem));
+	Assert(base::start() == buffer);
+}
+
+
+}
@@ -0,0 +1,433 @@
+#ifndef TLZ_NDARRAY_EXPRESSION_H_
+#define TLZ_NDARRAY_EXPRESSION_H_
+
+#include <array>
+#include <functional>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include "common.h"
+#include "ndcoord.h"
+#include "ndarray_traits.h"
+#include "ndarray_view.h"
+#include "ndarray_traversal.h"
+#if TLZ_ND_WITH_ALLOCATION
+#include "ndarray.h"
+#endif
+
+namespace tlz {
+
+template<typename Function, typename... Operands> class ndarray_expression;
+
+namespace detail {
+
+/// View type stored in expression for operand of type \a View.
+template<typename View>
+struct expression_leaf_view {
+	using type = View;
+	static const type& get(const View& vw) { return vw; }
+};
+
+template<typename View, std::ptrdiff_t Target_dim>
+struct expression_leaf_view<ndarray_view_fcall<View, Target_dim>> {
+	using type = View;
+	static type get(const ndarray_view_fcall<View, Target_dim>& vw) { return vw; }
+};
+
+#if TLZ_ND_WITH_ALLOCATION
+template<std::size_t Dim, typename T, typename Allocator>
+struct expression_leaf_view<ndarray<Dim, T, Allocator>> {
+	using type = ndarray_view<Dim, const T>;
+	static type get(const ndarray<Dim, T, Allocator>& arr) { return arr.cview(); }
+};
+#endif
+
+
+/// Start pointers, strides and element sizes of the leaves of an expression, plus the destination as first entry.
+template<std::size_t Dim, std::size_t N>
+struct expression_leaf_table {
+	std::array<const byte*, N> starts;
+	std::array<ndptrdiff<Dim>, N> strides;
+	std::array<std::size_t, N> elem_sizes;
+};
+
+
+/// Access to leaf elements in a run where every operand is contiguous.
+template<std::size_t N>
+struct expression_contiguous_cursor {
+	std::array<const byte*, N> starts;
+
+	template<std::size_t K, typename T> const T& get(std::ptrdiff_t i) const {
+		return reinterpret_cast<const T*>(starts[K])[i];
+	}
+};
+
+/// Access to leaf elements in a run where every operand is contiguous, or has stride 0.
+/** The condition is invariant in the loop over the run, so the load of broadcast elements gets hoisted out of it. */
+template<std::size_t N>
+struct expression_broadcast_cursor {
+	std::array<const byte*, N> starts;
+	std::array<bool, N> broadcast;
+
+	template<std::size_t K, typename T> const T& get(std::ptrdiff_t i) const {
+		const T* ptr = reinterpret_cast<const T*>(starts[K]);
+		return (broadcast[K] ? *ptr : ptr[i]);
+	}
+};
+
+/// Access to leaf elements in a run with arbitrary strides.
+template<std::size_t N>
+struct expression_strided_cursor {
+	std::array<const byte*, N> starts;
+	std::array<std::ptrdiff_t, N> strides;
+
+	template<std::size_t K, typename T> const T& get(std::ptrdiff_t i) const {
+		return *reinterpret_cast<const T*>(starts[K] + i * strides[K]);
+	}
+};
+
+
+/// Expression leaf, referring to elements of a view.
+template<typename View>
+class ndarray_expression_leaf {
+public:
+	using view_type = View;
+	using value_type = std::remove_cv_t<typename View::value_type>;
+	using shape_type = typename View::shape_type;
+	using coordinates_type = typename View::coordinates_type;
+
+	static constexpr std::size_t leaf_count = 1;
+	static constexpr bool is_strided = is_strided_ndarray_view<View>::value;
+	static constexpr bool has_shape = true;
+
+private:
+	view_type view_;
+
+public:
+	explicit ndarray_expression_leaf(const view_type& vw) : view_(vw) { }
+
+	constexpr static std::size_t dimension() { return View::dimension(); }
+	shape_type shape() const { return view_.shape(); }
+
+	ndarray_expression_leaf axis_section(std::ptrdiff_t axis, std::ptrdiff_t start, std::ptrdiff_t end) const {
+		if(view_.shape()[axis] == 1) return *this; // broadcast axis
+		else return ndarray_expression_leaf(view_.axis_section(axis, start, end, 1));
+	}
+
+	template<std::size_t First, std::size_t N>
+	void collect_leaves(expression_leaf_table<View::dimension(), N>& table) const {
+		ndarray_view<View::dimension(), const value_type> vw = view_;
+		table.starts[First] = reinterpret_cast<const byte*>(vw.start());
+		table.strides[First] = vw.strides();
+		table.elem_sizes[First] = sizeof(value_type);
+		for(std::ptrdiff_t i = 0; i < View::dimension(); ++i) if(vw.shape()[i] == 1) table.strides[First][i] = 0;
+	}
+
+	template<std::size_t First, typename Cursor>
+	const value_type& eval(const Cursor& cursor, std::ptrdiff_t i) const {
+		return cursor.template get<First, value_type>(i);
+	}
+
+	value_type at(coordinates_type coord) const {
+		for(std::ptrdiff_t i = 0; i < View::dimension(); ++i) if(view_.shape()[i] == 1) coord[i] = 0;
+		return view_.at(coord);
+	}
+};
+
+
+/// Expression leaf holding scalar value, broadcasted to any shape.
+template<typename T>
+class ndarray_expression_scalar {
+public:
+	using value_type = T;
+
+	static constexpr std::size_t leaf_count = 0;
+	static constexpr bool is_strided = true;
+	static constexpr bool has_shape = false;
+
+private:
+	value_type value_;
+
+public:
+	explicit ndarray_expression_scalar(const value_type& value) : value_(value) { }
+
+	ndarray_expression_scalar axis_section(std::ptrdiff_t, std::ptrdiff_t, std::ptrdiff_t) const { return *this; }
+
+	template<std::size_t First, typename Table> void collect_leaves(Table&) const { }
+
+	template<std::size_t First, typename Cursor>
+	const value_type& eval(const Cursor&, std::ptrdiff_t) const { return value_; }
+
+	template<typename Coordinates> const value_type& at(const Coordinates&) const { return value_; }
+};
+
+
+/// Broadcast \a shape with the shape of expression node \a node. Scalars match any shape.
+/** Returns `false` if the shapes are incompatible. */
+template<typename Node, typename Shape>
+bool expression_broadcast_shape(const Node& node, Shape& shape) {
+	const Shape node_shape = node.shape();
+	for(std::ptrdiff_t i = 0; i < Shape::dimension(); ++i) {
+		if(node_shape[i] == shape[i] || node_shape[i] == 1) continue;
+		else if(shape[i] == 1) shape[i] = node_shape[i];
+		else return false;
+	}
+	return true;
+}
+
+template<typename T, typename Shape>
+bool expression_broadcast_shape(const ndarray_expression_scalar<T>&, Shape&) { return true; }
+
+
+/// Whether \a T is a view or an expression, i.e. not a scalar in an expression.
+template<typename T>
+using is_expression_array_operand = std::integral_constant<bool,
+	is_ndarray_view<T>::value || is_ndarray_expression<T>::value
+>;
+
+/// Expression node type for operand of type \a T.
+template<typename T, typename = void>
+struct expression_operand {
+	using type = ndarray_expression_scalar<T>;
+	static type wrap(const T& value) { return type(value); }
+};
+
+template<typename T>
+struct expression_operand<T, std::enable_if_t<is_ndarray_view<T>::value>> {
+	using type = ndarray_expression_leaf<typename expression_leaf_view<T>::type>;
+	static type wrap(const T& vw) { return type(expression_leaf_view<T>::get(vw)); }
+};
+
+template<typename T>
+struct expression_operand<T, std::enable_if_t<is_ndarray_expression<T>::value>> {
+	using type = T;
+	static const type& wrap(const T& expr) { return expr; }
+};
+
+template<typename T>
+using expression_operand_t = typename expression_operand<std::decay_t<T>>::type;
+
+
+/// Operands valid for an element-wise operator: at least one view or expression, others arithmetic scalars.
+template<typename... Operands>
+using enable_if_expression_operator = std::enable_if_t<
+	! conjunction<std::integral_constant<bool, ! is_expression_array_operand<Operands>::value>...>::value &&
+	conjunction<std::integral_constant<bool,
+		is_expression_array_operand<Operands>::value || std::is_arithmetic<Operands>::value
+	>...>::value
+>;
+
+
+template<typename T> struct expression_cast_function {
+	template<typename U> T operator()(const U& x) const { return static_cast<T>(x); }
+};
+
+struct expression_where_function {
+	template<typename C, typename A, typename B>
+	std::common_type_t<A, B> operator()(const C& cond, const A& a, const B& b) const { return cond ? a : b; }
+};
+
+
+/// Evaluate \a expr into \a vw in one pass, with one fused loop over runs of all operands.
+template<std::size_t Dim, typename T, typename Expr>
+void evaluate_ndarray_expression(const ndarray_view<Dim, T>& vw, const Expr& expr);
+
+}
+
+
+/// Lazily evaluated element-wise expression over views.
+/** Created with operators on views (any type with `is_ndarray_view`), or with elementwise(), where(), elementwise_cast()
+ ** and similar functions. Holds copies of its operand views, and of scalar operands which get broadcast to the shape.
+ ** Does not compute anything until it is assigned to an \ref ndarray_view, or used to construct an \ref ndarray. The
+ ** entire expression is then evaluated in a single pass, without intermediate arrays: one loop walks over runs which
+ ** are runs in the destination and in all operand views, and the innermost loop over contiguous runs can be vectorized
+ ** by the compiler. Expressions containing wraparound views are evaluated element by element.
+ **
+ ** Operand views must have the same dimension, and their shapes get broadcast as in _Numpy_: axes of length 1 are
+ ** repeated to the length of the other operands. (broadcast_to() also prepends axes.) Runs where broadcast operands
+ ** have stride 0 load their element only once. Elements of the destination view may alias elements of operand views
+ ** only at the same coordinates. Both sides of where() get evaluated. */
+template<typename Function, typename... Operands>
+class ndarray_expression {
+	static_assert(sizeof...(Operands) > 0, "ndarray_expression must have operands");
+
+private:
+	using operands_tuple_type = std::tuple<Operands...>;
+	using operand_indices_ = std::index_sequence_for<Operands...>;
+
+	static constexpr std::size_t shaped_operand_index_() {
+		constexpr bool has_shape[] = { Operands::has_shape... };
+		for(std::size_t i = 0; i < sizeof...(Operands); ++i) if(has_shape[i]) return i;
+		return sizeof...(Operands);
+	}
+
+	static constexpr std::size_t leaf_offset_(std::size_t k) {
+		constexpr std::size_t leaf_counts[] = { Operands::leaf_count... };
+		std::size_t offset = 0;
+		for(std::size_t i = 0; i < k; ++i) offset += leaf_counts[i];
+		return offset;
+	}
+
+	static constexpr bool all_strided_() {
+		constexpr bool strided[] = { Operands::is_strided... };
+		for(std::size_t i = 0; i < sizeof...(Operands); ++i) if(! strided[i]) return false;
+		return true;
+	}
+
+	static_assert(shaped_operand_index_() < sizeof...(Operands), "ndarray_expression must have a view operand");
+	using shaped_operand_type_ = std::tuple_element_t<shaped_operand_index_(), operands_tuple_type>;
+
+public:
+	using value_type = std::decay_t<std::result_of_t<const Function&(const typename Operands::value_type&...)>>;
+	using shape_type = typename shaped_operand_type_::shape_type;
+	using coordinates_type = typename shaped_operand_type_::coordinates_type;
+
+	static constexpr std::size_t leaf_count = leaf_offset_(sizeof...(Operands));
+	static constexpr bool is_strided = all_strided_();
+	static constexpr bool has_shape = true;
+
+private:
+	Function function_;
+	operands_tuple_type operands_;
+	shape_type shape_;
+
+	template<std::size_t... K>
+	void broadcast_shapes_(std::index_sequence<K...>);
+
+	template<std::size_t... K>
+	ndarray_expression axis_section_(std::ptrdiff_t axis, std::ptrdiff_t start, std::ptrdiff_t end, std::index_sequence<K...>) const {
+		return ndarray_expression(function_, std::get<K>(operands_).axis_section(axis, start, end)...);
+	}
+
+	template<std::size_t First, std::size_t N, std::size_t... K>
+	void collect_leaves_(detail::expression_leaf_table<shape_type::dimension(), N>& table, std::index_sequence<K...>) const {
+		int expand[] = { 0, (std::get<K>(operands_).template collect_leaves<First + leaf_offset_(K)>(table), 0)... };
+		(void)expand;
+	}
+
+	template<std::size_t First, typename Cursor, std::size_t... K>
+	value_type eval_(const Cursor& cursor, std::ptrdiff_t i, std::index_sequence<K...>) const {
+		return function_(std::get<K>(operands_).template eval<First + leaf_offset_(K)>(cursor, i)...);
+	}
+
+	template<std::size_t... K>
+	value_type at_(const coordinates_type& coord, std::index_sequence<K...>) const {
+		return function_(std::get<K>(operands_).at(coord)...);
+	}
+
+public:
+	explicit ndarray_expression(const Function& func, const Operands&... operands) :
+		function_(func),
+		operands_(operands...),
+		shape_(std::get<shaped_operand_index_()>(operands_).shape())
+	{
+		broadcast_shapes_(operand_indices_());
+	}
+
+	constexpr static std::size_t dimension() { return shape_type::dimension(); }
+	const shape_type& shape() const { return shape_; }
+	std::size_t size() const { return shape_.product(); }
+
+	/// Section of the expression along \a axis, i.e. expression on the sections of the operand views.
+	ndarray_expression axis_section(std::ptrdiff_t axis, std::ptrdiff_t start, std::ptrdiff_t end) const {
+		return axis_section_(axis, start, end, operand_indices_());
+	}
+
+	/// Value of the expression at coordinates \a coord.
+	value_type at(const coordinates_type& coord) const { return at_(coord, operand_indices_()); }
+
+	/// \name Evaluation interface
+	/// Used by detail::evaluate_ndarray_expression() and by parent expressions. \a First is the index of the first
+	/// leaf of this expression in the leaf table, and in the cursor.
+	///@{
+	template<std::size_t First, std::size_t N>
+	void collect_leaves(detail::expression_leaf_table<shape_type::dimension(), N>& table) const {
+		collect_leaves_<First>(table, operand_indices_());
+	}
+
+	template<std::size_t First, typename Cursor>
+	value_type eval(const Cursor& cursor, std::ptrdiff_t i) const {
+		return eval_<First>(cursor, i, operand_indices_());
+	}
+	///@}
+};
+
+
+template<typename Function, typename... Operands>
+struct is_ndarray_expression<ndarray_expression<Function, Operands...>> : std::true_type {};
+
+
+/// Element-wise application of \a func to views, expressions or scalars \a args.
+template<typename Function, typename... Args>
+auto elementwise(const Function& func, const Args&... args) {
+	return ndarray_expression<Function, detail::expression_operand_t<Args>...>(
+		func,
+		detail::expression_operand<Args>::wrap(args)...
+	);
+}
+
+/// Element-wise `cond ? a : b`. Both \a a and \a b are evaluated for each element.
+template<typename Cond, typename A, typename B>
+auto where(const Cond& cond, const A& a, const B& b) {
+	return elementwise(detail::expression_where_function(), cond, a, b);
+}
+
+/// Element-wise `static_cast<T>(x)`.
+template<typename T, typename Arg>
+auto elementwise_cast(const Arg& x) {
+	return elementwise(detail::expression_cast_function<T>(), x);
+}
+
+/// Element-wise `a == b`. The `==` operator on views does deep comparison instead.
+template<typename A, typename B, typename = detail::enable_if_expression_operator<A, B>>
+auto elementwise_equal(const A& a, const B& b) { return elementwise(std::equal_to<>(), a, b); }
+
+/// Element-wise `a != b`.
+template<typename A, typename B, typename = detail::enable_if_expression_operator<A, B>>
+auto elementwise_not_equal(const A& a, const B& b) { return elementwise(std::not_equal_to<>(), a, b); }
+
+
+#define TLZ_ND_EXPRESSION_BINARY_OPERATOR_(__op__, __function__) \
+	template<typename A, typename B, typename = detail::enable_if_expression_operator<A, B>> \
+	auto operator __op__ (const A& a, const B& b) { return elementwise(__function__(), a, b); }
+
+TLZ_ND_EXPRESSION_BINARY_OPERATOR_(+, std::plus<>)
+TLZ_ND_EXPRESSION_BINARY_OPERATOR_(-, std::minus<>)
+TLZ_ND_EXPRESSION_BINARY_OPERATOR_(*, std::multiplies<>)
+TLZ_ND_EXPRESSION_BINARY_OPERATOR_(/, std::divides<>)
+TLZ_ND_EXPRESSION_BINARY_OPERATOR_(%, std::modulus<>)
+TLZ_ND_EXPRESSION_BINARY_OPERATOR_(&, std::bit_and<>)
+TLZ_ND_EXPRESSION_BINARY_OPERATOR_(|, std::bit_or<>)
+TLZ_ND_EXPRESSION_BINARY_OPERATOR_(^, std::bit_xor<>)
+TLZ_ND_EXPRESSION_BINARY_OPERATOR_(<, std::less<>)
+TLZ_ND_EXPRESSION_BINARY_OPERATOR_(<=, std::less_equal<>)
+TLZ_ND_EXPRESSION_BINARY_OPERATOR_(>, std::greater<>)
+TLZ_ND_EXPRESSION_BINARY_OPERATOR_(>=, std::greater_equal<>)
+
+#undef TLZ_ND_EXPRESSION_BINARY_OPERATOR_
+
+
+#define TLZ_ND_EXPRESSION_UNARY_OPERATOR_(__op__, __function__) \
+	template<typename A, typename = detail::enable_if_expression_operator<A>> \
+	auto operator __op__ (const A& a) { return elementwise(__function__(), a); }
+
+TLZ_ND_EXPRESSION_UNARY_OPERATOR_(-, std::negate<>)
+TLZ_ND_EXPRESSION_UNARY_OPERATOR_(~, std::bit_not<>)
+
+#undef TLZ_ND_EXPRESSION_UNARY_OPERATOR_
+
+
+#if TLZ_ND_WITH_ALLOCATION
+/// Evaluate expression into new \ref ndarray with default strides.
+template<typename Function, typename... Operands>
+auto evaluate(const ndarray_expression<Function, Operands...>& expr) {
+	using expression_type = ndarray_expression<Function, Operands...>;
+	return ndarray<expression_type::dimension(), typename expression_type::value_type>(expr);
+}
+#endif
+
+}
+
+#include "ndarray_expression.tcc"
+
+#endif
@@ -0,0 +1,90 @@
+namespace tlz {
+
+template<typename Function, typename... Operands>
+constexpr std::size_t ndarray_expression<Function, Operands...>::leaf_count;
+
+template<typename Function, typename... Operands>
+constexpr bool ndarray_expression<Function, Operands...>::is_strided;
+
+template<typename Function, typename... Operands>
+constexpr bool ndarray_expression<Function, Operands...>::has_shape;
+
+
+template<typename Function, typename... Operands> template<std::size_t... K>
+void ndarray_expression<Function, Operands...>::broadcast_shapes_(std::index_sequence<K...>) {
+	bool compatible[] = { detail::expression_broadcast_shape(std::get<K>(operands_), shape_)... };
+	for(bool comp : compatible) Assert(comp, "ndarray_expression operands must have same or broadcastable shapes");
+}
+
+
+namespace detail {
+
+template<std::size_t Dim, typename T, typename Expr>
+void evaluate_ndarray_expression_(const ndarray_view<Dim, T>& vw, const Expr& expr, std::true_type) {
+	constexpr std::size_t arity = 1 + Expr::leaf_count;
+	
+	expression_leaf_table<Dim, arity> table;
+	table.starts[0] = reinterpret_cast<const byte*>(vw.start());
+	table.strides[0] = vw.strides();
+	table.elem_sizes[0] = sizeof(T);
+	expr.template collect_leaves<1>(table);
+	
+	strided_loop<Dim, arity> loop(vw.shape(), table.strides);
+	loop.canonicalize();
+	
+	const std::ptrdiff_t count = loop.run_length();
+	const auto& run_strides = loop.run_strides();
+	bool contiguous = true, broadcast_contiguous = (run_strides[0] == std::ptrdiff_t(sizeof(T)));
+	std::array<bool, arity> broadcast;
+	for(std::size_t k = 0; k < arity; ++k) {
+		broadcast[k] = (k > 0 && run_strides[k] == 0);
+		if(run_strides[k] != std::ptrdiff_t(table.elem_sizes[k])) {
+			contiguous = false;
+			if(! broadcast[k]) broadcast_contiguous = false;
+		}
+	}
+	
+	loop.run([&](const auto& offsets) {
+		std::array<const byte*, arity> starts;
+		for(std::size_t k = 0; k < arity; ++k) starts[k] = table.starts[k] + offsets[k];
+		T* out = reinterpret_cast<T*>(const_cast<byte*>(starts[0]));
+		
+		if(contiguous) {
+			// destination aliases operands only at same coordinates, so there are no loop-carried dependencies
+			expression_contiguous_cursor<arity> cursor { starts };
+			#if defined(__GNUC__) && ! defined(__clang__)
+			#pragma GCC ivdep
+			#endif
+			for(std::ptrdiff_t i = 0; i < count; ++i) out[i] = expr.template eval<1>(cursor, i);
+		} else if(broadcast_contiguous) {
+			expression_broadcast_cursor<arity> cursor { starts, broadcast };
+			#if defined(__GNUC__) && ! defined(__clang__)
+			#pragma GCC ivdep
+			#endif
+			for(std::ptrdiff_t i = 0; i < count; ++i) out[i] = expr.template eval<1>(cursor, i);
+		} else {
+			expression_strided_cursor<arity> cursor { starts, run_strides };
+			for(std::ptrdiff_t i = 0; i < count; ++i)
+				*advance_raw_ptr(out, i * run_strides[0]) = expr.template eval<1>(cursor, i);
+		}
+	});
+}
+
+
+template<std::size_t Dim, typename T, typename Expr>
+void evaluate_ndarray_expression_(const ndarray_view<Dim, T>& vw, const Expr& expr, std::false_type) {
+	// some operand cannot be traversed by runs (wraparound view)
+	for(const auto& coord : make_ndspan(vw.shape())) vw.at(coord) = expr.at(coord);
+}
+
+
+template<std::size_t Dim, typename T, typename Expr>
+void evaluate_ndarray_expression(const ndarray_view<Dim, T>& vw, const Expr& expr) {
+	Assert_crit(vw.shape() == expr.shape(), "ndarray_view must have same shape as expression for assignment");
+	if(vw.shape().product() == 0) return;
+	evaluate_ndarray_expression_(vw, expr, std::integral_constant<bool, Expr::is_strided>());
+}
+
+}
+
+}
@@ -2,6 +2,7 @@
 #define TLZ_NDARRAY_ITERATOR_H_
 
 #include <iterator>
+#include "instrumentation.h"
 
 namespace tlz {
 
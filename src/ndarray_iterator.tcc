@@ -12,6 +12,7 @@ inline void ndarray_iterator<View>::forward_(std::ptrdiff_t d) {
 	if(d < contiguous_limit) {
 		pointer_ = advance_raw_ptr(pointer_, d * view_.strides().back());
 	} else {
+		TLZ_ND_INSTRUMENT(iterator_recompute, 0);
 		auto new_coord = view_.index_to_coordinates(index_);
 		pointer_ = view_.coordinates_to_pointer(new_coord);
 	}
@@ -26,6 +27,7 @@ inline void ndarray_iterator<View>::backward_(std::ptrdiff_t d) {
 	if(d <= contiguous_limit) {
 		pointer_ = advance_raw_ptr(pointer_, -d * view_.strides().back());
 	} else {
+		TLZ_ND_INSTRUMENT(iterator_recompute, 0);
 		auto new_coord = view_.index_to_coordinates(index_);
 		pointer_ = view_.coordinates_to_pointer(new_coord);
 	}
@@ -0,0 +1,119 @@
+#ifndef TLZ_NDARRAY_ORDER_H_
+#define TLZ_NDARRAY_ORDER_H_
+
+#include <algorithm>
+#include "common.h"
+#include "ndcoord.h"
+
+namespace tlz {
+
+/// Predefined storage orders for \ref ndarray_order.
+enum class storage_order {
+	row_major, ///< Last axis varies fastest (C order). Default for \ref ndarray.
+	column_major ///< First axis varies fastest (Fortran order).
+};
+
+
+/// Storage order of the axes of an n-dimensional array, as permutation of the axis indices.
+/** Lists the axes from outermost (largest stride) to innermost (smallest stride). Row-major order is
+ ** `(0, 1, ..., Dim - 1)`, and column-major order is `(Dim - 1, ..., 1, 0)`. Implicitly constructible from
+ ** \ref storage_order. */
+template<std::size_t Dim>
+class ndarray_order {
+private:
+	ndptrdiff<Dim> axes_;
+
+public:
+	/// Row-major order.
+	ndarray_order() {
+		for(std::ptrdiff_t i = 0; i < Dim; ++i) axes_[i] = i;
+	}
+
+	ndarray_order(storage_order ord) {
+		for(std::ptrdiff_t i = 0; i < Dim; ++i) axes_[i] = (ord == storage_order::row_major ? i : std::ptrdiff_t(Dim) - 1 - i);
+	}
+
+	/// Order with explicitly specified axis permutation, from outermost to innermost axis.
+	explicit ndarray_order(const ndptrdiff<Dim>& axes) : axes_(axes) {
+		Assert(is_permutation_(axes), "ndarray_order must be permutation of axes");
+	}
+
+	static ndarray_order row_major() { return ndarray_order(storage_order::row_major); }
+	static ndarray_order column_major() { return ndarray_order(storage_order::column_major); }
+
+	constexpr static std::size_t dimension() { return Dim; }
+
+	/// Axis at storage position \a i, where position `0` is outermost.
+	std::ptrdiff_t operator[](std::ptrdiff_t i) const { return axes_[i]; }
+	const ndptrdiff<Dim>& axes() const { return axes_; }
+
+	/// Storage position of axis \a axis.
+	std::ptrdiff_t position(std::ptrdiff_t axis) const {
+		return std::find(axes_.begin(), axes_.end(), axis) - axes_.begin();
+	}
+
+	std::ptrdiff_t innermost_axis() const { return (Dim == 0 ? 0 : axes_[Dim - 1]); }
+
+	bool is_row_major() const { return (*this == row_major()); }
+	bool is_column_major() const { return (*this == column_major()); }
+
+	friend bool operator==(const ndarray_order& a, const ndarray_order& b) { return (a.axes_ == b.axes_); }
+	friend bool operator!=(const ndarray_order& a, const ndarray_order& b) { return (a.axes_ != b.axes_); }
+
+private:
+	static bool is_permutation_(const ndptrdiff<Dim>& axes) {
+		for(std::ptrdiff_t i = 0; i < Dim; ++i)
+			if(std::find(axes.begin(), axes.end(), i) == axes.end()) return false;
+		return true;
+	}
+};
+
+
+namespace detail {
+
+/// Default strides for \a shape where axes are laid out in \a order, and innermost stride is \a inner_stride.
+template<std::size_t Dim>
+ndptrdiff<Dim> ordered_default_strides(const ndsize<Dim>& shape, const ndarray_order<Dim>& order, std::ptrdiff_t inner_stride) {
+	ndptrdiff<Dim> strides;
+	if(Dim == 0) return strides;
+	strides[order[Dim - 1]] = inner_stride;
+	for(std::ptrdiff_t i = Dim - 1; i > 0; --i)
+		strides[order[i - 1]] = strides[order[i]] * shape[order[i]];
+	return strides;
+}
+
+
+/// Check if \a strides are default strides for \a shape in \a order.
+/** Only checks storage positions from `Dim - 1` down to \a minimal_position. The innermost stride must be at least
+ ** \a min_inner_stride. */
+template<std::size_t Dim>
+bool has_ordered_default_strides(const ndsize<Dim>& shape, const ndptrdiff<Dim>& strides, const ndarray_order<Dim>& order,
+std::ptrdiff_t min_inner_stride, std::ptrdiff_t minimal_position) {
+	if(Dim == 0) return true;
+	if(strides[order[Dim - 1]] < min_inner_stride) return false;
+	for(std::ptrdiff_t i = Dim - 2; i >= minimal_position; --i) {
+		std::ptrdiff_t expected_stride = shape[order[i + 1]] * strides[order[i + 1]];
+		if(strides[order[i]] != expected_stride) return false;
+	}
+	return true;
+}
+
+
+/// Order of axes of view with \a shape and \a strides, by decreasing stride.
+/** When strides are equal, axes of extent 1 are placed inwards, and other axes keep their relative order. This way
+ ** default strides in any order yield an order for which has_ordered_default_strides() holds. */
+template<std::size_t Dim>
+ndarray_order<Dim> strides_order(const ndsize<Dim>& shape, const ndptrdiff<Dim>& strides) {
+	ndptrdiff<Dim> axes = ndarray_order<Dim>().axes();
+	std::stable_sort(axes.begin(), axes.end(), [&](std::ptrdiff_t a, std::ptrdiff_t b) {
+		if(strides[a] != strides[b]) return (strides[a] > strides[b]);
+		else return (shape[a] != 1 && shape[b] == 1);
+	});
+	return ndarray_order<Dim>(axes);
+}
+
+}
+
+}
+
+#endif
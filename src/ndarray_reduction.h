@@ -0,0 +1,340 @@
+#ifndef TLZ_NDARRAY_REDUCTION_H_
+#define TLZ_NDARRAY_REDUCTION_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <type_traits>
+#include <utility>
+#include "config.h"
+#include "common.h"
+#include "ndcoord.h"
+#include "ndarray_view.h"
+#include "ndarray_traversal.h"
+#include "execution.h"
+#if TLZ_ND_WITH_ALLOCATION
+#include "ndarray.h"
+#endif
+
+namespace tlz {
+
+namespace detail {
+
+/// Number of independent accumulators used in reduction of contiguous runs.
+/** Breaks the dependency chain of the accumulation, so that the compiler can vectorize the loop. The lanes get combined
+ ** in a fixed order, so the result does not depend on the instruction set. */
+constexpr std::ptrdiff_t reduction_lanes = 8;
+
+/// Reduce contiguous run of \a n elements at \a ptr using `reduction_lanes` accumulators, initialized with \a init.
+/** `op(acc, x)` accumulates element `x`, `merge(acc, acc)` combines two accumulators. */
+template<typename Acc, typename T, typename Op, typename Merge>
+Acc reduce_contiguous_run(const T* ptr, std::ptrdiff_t n, const Acc& init, Op op, Merge merge);
+
+/// Reduce strided run of \a n elements at \a ptr, with \a stride in bytes, using `reducer.first()` and `reducer.next()`.
+template<typename Reducer, typename T>
+typename Reducer::accumulator_type reduce_strided_run(const Reducer&, const T* ptr, std::ptrdiff_t n, std::ptrdiff_t stride, std::ptrdiff_t index);
+
+
+/*
+ * Reducers for element type `T` have the interface:
+ *  - `accumulator_type`, `result_type`.
+ *  - `has_identity`: whether `identity()` exists, i.e. empty views can be reduced.
+ *  - `uses_index`: whether elements must be visited in index order, because result depends on their index.
+ *  - `first(x, index)`: accumulator for one element, `next(acc, x, index)`: accumulate element into `acc`.
+ *  - `merge(acc, later)`: combine two accumulators, where \a later covers elements after those of \a acc.
+ *  - `run(ptr, n, stride, index)`: accumulator of run of `n > 0` elements.
+ *  - `saturated(acc)`: whether further elements cannot change the result.
+ *  - `result(acc, count)`: result from accumulator for `count` elements.
+ */
+
+/// Accumulator type for sum of elements of type \a T.
+/** 64 bit integer of same signedness for integral types, so that sums of large views of small integers do not
+ ** overflow. */
+template<typename T>
+using reduction_sum_type = std::conditional_t<
+	std::is_integral<T>::value,
+	std::conditional_t<std::is_signed<T>::value, std::int64_t, std::uint64_t>,
+	std::decay_t<decltype(std::declval<T>() + std::declval<T>())>
+>;
+
+template<typename T>
+using reduction_mean_type = std::conditional_t<std::is_floating_point<T>::value, T, double>;
+
+
+template<typename T, typename Acc = reduction_sum_type<T>>
+struct sum_reducer {
+	using accumulator_type = Acc;
+	using result_type = Acc;
+	static constexpr bool has_identity = true;
+	static constexpr bool uses_index = false;
+
+	accumulator_type identity() const { return accumulator_type(0); }
+	accumulator_type first(const T& x, std::ptrdiff_t) const { return accumulator_type(x); }
+	void next(accumulator_type& acc, const T& x, std::ptrdiff_t) const { acc += x; }
+	void merge(accumulator_type& acc, const accumulator_type& later) const { acc += later; }
+	accumulator_type run(const T* ptr, std::ptrdiff_t n, std::ptrdiff_t stride, std::ptrdiff_t index) const;
+	bool saturated(const accumulator_type&) const { return false; }
+	result_type result(const accumulator_type& acc, std::size_t) const { return acc; }
+};
+
+
+template<typename T>
+struct mean_reducer : sum_reducer<T, reduction_mean_type<T>> {
+	using base = sum_reducer<T, reduction_mean_type<T>>;
+	using typename base::accumulator_type;
+	using result_type = reduction_mean_type<T>;
+
+	result_type result(const accumulator_type& acc, std::size_t count) const { return acc / result_type(count); }
+};
+
+
+template<typename T, typename Compare>
+struct extremum_reducer {
+	using accumulator_type = T;
+	using result_type = T;
+	static constexpr bool has_identity = false;
+	static constexpr bool uses_index = false;
+
+	accumulator_type identity() const { return T(); }
+	accumulator_type first(const T& x, std::ptrdiff_t) const { return x; }
+	void next(accumulator_type& acc, const T& x, std::ptrdiff_t) const { if(Compare()(x, acc)) acc = x; }
+	void merge(accumulator_type& acc, const accumulator_type& later) const { next(acc, later, 0); }
+	accumulator_type run(const T* ptr, std::ptrdiff_t n, std::ptrdiff_t stride, std::ptrdiff_t index) const;
+	bool saturated(const accumulator_type&) const { return false; }
+	result_type result(const accumulator_type& acc, std::size_t) const { return acc; }
+};
+
+template<typename T> using min_reducer = extremum_reducer<T, std::less<T>>;
+template<typename T> using max_reducer = extremum_reducer<T, std::greater<T>>;
+
+
+template<typename T>
+struct arg_extremum_accumulator {
+	T value;
+	std::ptrdiff_t index;
+};
+
+/// Index of first extremal element.
+template<typename T, typename Compare>
+struct arg_extremum_reducer {
+	using accumulator_type = arg_extremum_accumulator<T>;
+	using result_type = std::ptrdiff_t;
+	static constexpr bool has_identity = false;
+	static constexpr bool uses_index = true;
+
+	accumulator_type identity() const { return { T(), -1 }; }
+	accumulator_type first(const T& x, std::ptrdiff_t index) const { return { x, index }; }
+	void next(accumulator_type& acc, const T& x, std::ptrdiff_t index) const
+		{ if(Compare()(x, acc.value)) acc = { x, index }; }
+	void merge(accumulator_type& acc, const accumulator_type& later) const
+		{ if(Compare()(later.value, acc.value)) acc = later; }
+	accumulator_type run(const T* ptr, std::ptrdiff_t n, std::ptrdiff_t stride, std::ptrdiff_t index) const
+		{ return reduce_strided_run(*this, ptr, n, stride, index); }
+	bool saturated(const accumulator_type&) const { return false; }
+	result_type result(const accumulator_type& acc, std::size_t) const { return acc.index; }
+};
+
+template<typename T> using argmin_reducer = arg_extremum_reducer<T, std::less<T>>;
+template<typename T> using argmax_reducer = arg_extremum_reducer<T, std::greater<T>>;
+
+
+template<typename T>
+struct count_reducer {
+	using accumulator_type = std::size_t;
+	using result_type = std::size_t;
+	static constexpr bool has_identity = true;
+	static constexpr bool uses_index = false;
+
+	accumulator_type identity() const { return 0; }
+	accumulator_type first(const T& x, std::ptrdiff_t) const { return static_cast<bool>(x); }
+	void next(accumulator_type& acc, const T& x, std::ptrdiff_t) const { acc += static_cast<bool>(x); }
+	void merge(accumulator_type& acc, const accumulator_type& later) const { acc += later; }
+	accumulator_type run(const T* ptr, std::ptrdiff_t n, std::ptrdiff_t stride, std::ptrdiff_t index) const;
+	bool saturated(const accumulator_type&) const { return false; }
+	result_type result(const accumulator_type& acc, std::size_t) const { return acc; }
+};
+
+
+/// Whether any (\a Value = `true`) or all (\a Value = `false`) elements are `true`.
+template<typename T, bool Value>
+struct any_all_reducer {
+	using accumulator_type = bool;
+	using result_type = bool;
+	static constexpr bool has_identity = true;
+	static constexpr bool uses_index = false;
+
+	accumulator_type identity() const { return ! Value; }
+	accumulator_type first(const T& x, std::ptrdiff_t) const { return static_cast<bool>(x); }
+	void next(accumulator_type& acc, const T& x, std::ptrdiff_t) const { if(static_cast<bool>(x) == Value) acc = Value; }
+	void merge(accumulator_type& acc, const accumulator_type& later) const { if(later == Value) acc = Value; }
+	accumulator_type run(const T* ptr, std::ptrdiff_t n, std::ptrdiff_t stride, std::ptrdiff_t index) const;
+	bool saturated(const accumulator_type& acc) const { return (acc == Value); }
+	result_type result(const accumulator_type& acc, std::size_t) const { return acc; }
+};
+
+template<typename T> using any_reducer = any_all_reducer<T, true>;
+template<typename T> using all_reducer = any_all_reducer<T, false>;
+
+
+/// Reduce all elements of \a vw.
+template<typename Reducer, std::size_t Dim, typename T>
+typename Reducer::result_type reduce_ndarray_view(const Reducer&, const ndarray_view<Dim, T>& vw);
+
+/// Reduce all elements of \a vw, in parallel.
+/** Blocks get reduced in parallel, and their accumulators are then combined pairwise in a fixed tree order. */
+template<typename Reducer, std::size_t Dim, typename T>
+typename Reducer::result_type reduce_ndarray_view(const execution::parallel_policy&, const Reducer&, const ndarray_view<Dim, T>& vw);
+
+/// Reduce \a vw along \a axis, and write results into \a out.
+/** \a out has the shape of \a vw with \a axis removed. If \a axis has the smallest stride, each output element is
+ ** reduced from one run. Otherwise the loop runs over the source in memory order, and accumulates slices of \a vw into
+ ** blocks of the output that stay in cache. */
+template<typename Reducer, std::size_t Dim, typename T>
+void reduce_ndarray_view_axis(
+	const Reducer&, const ndarray_view<Dim, T>& vw, std::ptrdiff_t axis,
+	const ndarray_view<Dim - 1, typename Reducer::result_type>& out
+);
+
+/// Reduce \a vw along \a axis, and write results into \a out, in parallel.
+/** The output gets partitioned into blocks. The result does not depend on the partition. */
+template<typename Reducer, std::size_t Dim, typename T>
+void reduce_ndarray_view_axis(
+	const execution::parallel_policy&, const Reducer&, const ndarray_view<Dim, T>& vw, std::ptrdiff_t axis,
+	const ndarray_view<Dim - 1, typename Reducer::result_type>& out
+);
+
+#if TLZ_ND_WITH_ALLOCATION
+template<typename Reducer, std::size_t Dim, typename T>
+ndarray<Dim - 1, typename Reducer::result_type> reduce_ndarray_view_axis(const Reducer&, const ndarray_view<Dim, T>& vw, std::ptrdiff_t axis);
+
+template<typename Reducer, std::size_t Dim, typename T>
+ndarray<Dim - 1, typename Reducer::result_type> reduce_ndarray_view_axis(
+	const execution::parallel_policy&, const Reducer&, const ndarray_view<Dim, T>& vw, std::ptrdiff_t axis
+);
+#endif
+
+}
+
+
+/// \name Reductions
+/// Reductions over all elements of a view, or along \a axis of a view, giving an \ref ndarray with one dimension less.
+/// Optionally with execution policy as first argument. Contiguous runs are reduced with multiple independent
+/// accumulators, which the compiler can vectorize. With a parallel policy, the view is partitioned into blocks which get
+/// reduced in parallel, then combined in a fixed order. For floating point types the result may differ from sequential
+/// reduction, and depends on the partition, unless the policy is deterministic().
+///@{
+
+/// Sum of elements. Integral types are summed as `std::int64_t` or `std::uint64_t`, depending on their signedness.
+template<std::size_t Dim, typename T>
+auto sum(const ndarray_view<Dim, T>& vw) { return detail::reduce_ndarray_view(detail::sum_reducer<std::remove_cv_t<T>>(), vw); }
+
+/// Mean of elements. `double` for integral types.
+template<std::size_t Dim, typename T>
+auto mean(const ndarray_view<Dim, T>& vw) {
+	Assert(vw.size() > 0, "cannot take mean of empty ndarray_view");
+	return detail::reduce_ndarray_view(detail::mean_reducer<std::remove_cv_t<T>>(), vw);
+}
+
+/// Minimal element. \a vw must not be empty.
+template<std::size_t Dim, typename T>
+auto min(const ndarray_view<Dim, T>& vw) { return detail::reduce_ndarray_view(detail::min_reducer<std::remove_cv_t<T>>(), vw); }
+
+/// Maximal element. \a vw must not be empty.
+template<std::size_t Dim, typename T>
+auto max(const ndarray_view<Dim, T>& vw) { return detail::reduce_ndarray_view(detail::max_reducer<std::remove_cv_t<T>>(), vw); }
+
+/// Coordinates of first minimal element. \a vw must not be empty.
+template<std::size_t Dim, typename T>
+auto argmin(const ndarray_view<Dim, T>& vw)
+	{ return vw.index_to_coordinates(detail::reduce_ndarray_view(detail::argmin_reducer<std::remove_cv_t<T>>(), vw)); }
+
+/// Coordinates of first maximal element. \a vw must not be empty.
+template<std::size_t Dim, typename T>
+auto argmax(const ndarray_view<Dim, T>& vw)
+	{ return vw.index_to_coordinates(detail::reduce_ndarray_view(detail::argmax_reducer<std::remove_cv_t<T>>(), vw)); }
+
+/// Whether any element converts to `true`.
+template<std::size_t Dim, typename T>
+bool any(const ndarray_view<Dim, T>& vw) { return detail::reduce_ndarray_view(detail::any_reducer<std::remove_cv_t<T>>(), vw); }
+
+/// Whether all elements convert to `true`.
+template<std::size_t Dim, typename T>
+bool all(const ndarray_view<Dim, T>& vw) { return detail::reduce_ndarray_view(detail::all_reducer<std::remove_cv_t<T>>(), vw); }
+
+/// Number of elements which convert to `true`.
+template<std::size_t Dim, typename T>
+std::size_t count(const ndarray_view<Dim, T>& vw)
+	{ return detail::reduce_ndarray_view(detail::count_reducer<std::remove_cv_t<T>>(), vw); }
+
+
+#define TLZ_ND_REDUCTION_OVERLOADS_(__name__, __reducer__) \
+	template<std::size_t Dim, typename T> \
+	auto __name__(execution::sequenced_policy, const ndarray_view<Dim, T>& vw) { return __name__(vw); } \
+	template<std::size_t Dim, typename T> \
+	auto __name__(const execution::parallel_policy& pol, const ndarray_view<Dim, T>& vw) \
+		{ return detail::reduce_ndarray_view(pol, detail::__reducer__<std::remove_cv_t<T>>(), vw); }
+
+#define TLZ_ND_AXIS_REDUCTION_OVERLOADS_(__name__, __reducer__) \
+	template<std::size_t Dim, typename T> \
+	auto __name__(const ndarray_view<Dim, T>& vw, std::ptrdiff_t axis) \
+		{ return detail::reduce_ndarray_view_axis(detail::__reducer__<std::remove_cv_t<T>>(), vw, axis); } \
+	template<std::size_t Dim, typename T> \
+	auto __name__(execution::sequenced_policy, const ndarray_view<Dim, T>& vw, std::ptrdiff_t axis) \
+		{ return __name__(vw, axis); } \
+	template<std::size_t Dim, typename T> \
+	auto __name__(const execution::parallel_policy& pol, const ndarray_view<Dim, T>& vw, std::ptrdiff_t axis) \
+		{ return detail::reduce_ndarray_view_axis(pol, detail::__reducer__<std::remove_cv_t<T>>(), vw, axis); }
+
+TLZ_ND_REDUCTION_OVERLOADS_(sum, sum_reducer)
+TLZ_ND_REDUCTION_OVERLOADS_(min, min_reducer)
+TLZ_ND_REDUCTION_OVERLOADS_(max, max_reducer)
+TLZ_ND_REDUCTION_OVERLOADS_(any, any_reducer)
+TLZ_ND_REDUCTION_OVERLOADS_(all, all_reducer)
+TLZ_ND_REDUCTION_OVERLOADS_(count, count_reducer)
+
+template<std::size_t Dim, typename T>
+auto mean(execution::sequenced_policy, const ndarray_view<Dim, T>& vw) { return mean(vw); }
+
+template<std::size_t Dim, typename T>
+auto mean(const execution::parallel_policy& pol, const ndarray_view<Dim, T>& vw) {
+	Assert(vw.size() > 0, "cannot take mean of empty ndarray_view");
+	return detail::reduce_ndarray_view(pol, detail::mean_reducer<std::remove_cv_t<T>>(), vw);
+}
+
+template<std::size_t Dim, typename T>
+auto argmin(execution::sequenced_policy, const ndarray_view<Dim, T>& vw) { return argmin(vw); }
+
+template<std::size_t Dim, typename T>
+auto argmin(const execution::parallel_policy& pol, const ndarray_view<Dim, T>& vw)
+	{ return vw.index_to_coordinates(detail::reduce_ndarray_view(pol, detail::argmin_reducer<std::remove_cv_t<T>>(), vw)); }
+
+template<std::size_t Dim, typename T>
+auto argmax(execution::sequenced_policy, const ndarray_view<Dim, T>& vw) { return argmax(vw); }
+
+template<std::size_t Dim, typename T>
+auto argmax(const execution::parallel_policy& pol, const ndarray_view<Dim, T>& vw)
+	{ return vw.index_to_coordinates(detail::reduce_ndarray_view(pol, detail::argmax_reducer<std::remove_cv_t<T>>(), vw)); }
+
+#if TLZ_ND_WITH_ALLOCATION
+// Along axis: ndarray of results. For argmin() and argmax(), index of first extremal element along axis.
+TLZ_ND_AXIS_REDUCTION_OVERLOADS_(sum, sum_reducer)
+TLZ_ND_AXIS_REDUCTION_OVERLOADS_(mean, mean_reducer)
+TLZ_ND_AXIS_REDUCTION_OVERLOADS_(min, min_reducer)
+TLZ_ND_AXIS_REDUCTION_OVERLOADS_(max, max_reducer)
+TLZ_ND_AXIS_REDUCTION_OVERLOADS_(argmin, argmin_reducer)
+TLZ_ND_AXIS_REDUCTION_OVERLOADS_(argmax, argmax_reducer)
+TLZ_ND_AXIS_REDUCTION_OVERLOADS_(any, any_reducer)
+TLZ_ND_AXIS_REDUCTION_OVERLOADS_(all, all_reducer)
+TLZ_ND_AXIS_REDUCTION_OVERLOADS_(count, count_reducer)
+#endif
+
+#undef TLZ_ND_REDUCTION_OVERLOADS_
+#undef TLZ_ND_AXIS_REDUCTION_OVERLOADS_
+
+///@}
+
+}
+
+#include "ndarray_reduction.tcc"
+
+#endif
@@ -0,0 +1,293 @@
+#include <algorithm>
+#include <cstdlib>
+#include <memory>
+#include <vector>
+
+namespace tlz {
+
+namespace detail {
+
+template<typename Acc, typename T, typename Op, typename Merge>
+Acc reduce_contiguous_run(const T* ptr, std::ptrdiff_t n, const Acc& init, Op op, Merge merge) {
+	Acc lanes[reduction_lanes];
+	for(std::ptrdiff_t l = 0; l < reduction_lanes; ++l) lanes[l] = init;
+
+	std::ptrdiff_t i = 0;
+	for(; i + reduction_lanes <= n; i += reduction_lanes)
+		for(std::ptrdiff_t l = 0; l < reduction_lanes; ++l) lanes[l] = op(lanes[l], ptr[i + l]);
+	for(std::ptrdiff_t l = 0; i < n; ++i, ++l) lanes[l] = op(lanes[l], ptr[i]);
+
+	// pairwise combination of lanes
+	for(std::ptrdiff_t w = reduction_lanes / 2; w > 0; w /= 2)
+		for(std::ptrdiff_t l = 0; l < w; ++l) lanes[l] = merge(lanes[l], lanes[l + w]);
+	return lanes[0];
+}
+
+
+template<typename Reducer, typename T>
+typename Reducer::accumulator_type reduce_strided_run(const Reducer& red, const T* ptr, std::ptrdiff_t n, std::ptrdiff_t stride, std::ptrdiff_t index) {
+	auto acc = red.first(*ptr, index);
+	for(std::ptrdiff_t i = 1; i < n; ++i) {
+		ptr = advance_raw_ptr(ptr, stride);
+		red.next(acc, *ptr, index + i);
+	}
+	return acc;
+}
+
+
+template<typename T, typename Acc>
+auto sum_reducer<T, Acc>::run(const T* ptr, std::ptrdiff_t n, std::ptrdiff_t stride, std::ptrdiff_t index) const
+-> accumulator_type {
+	if(stride != std::ptrdiff_t(sizeof(T))) return reduce_strided_run(*this, ptr, n, stride, index);
+	return reduce_contiguous_run(
+		ptr, n, accumulator_type(0),
+		[](const accumulator_type& acc, const T& x) { return acc + x; },
+		[](const accumulator_type& a, const accumulator_type& b) { return a + b; }
+	);
+}
+
+
+template<typename T, typename Compare>
+auto extremum_reducer<T, Compare>::run(const T* ptr, std::ptrdiff_t n, std::ptrdiff_t stride, std::ptrdiff_t index) const
+-> accumulator_type {
+	if(stride != std::ptrdiff_t(sizeof(T))) return reduce_strided_run(*this, ptr, n, stride, index);
+	auto select = [](const T& a, const T& b) { return (Compare()(b, a) ? b : a); };
+	return reduce_contiguous_run(ptr, n, *ptr, select, select);
+}
+
+
+template<typename T>
+auto count_reducer<T>::run(const T* ptr, std::ptrdiff_t n, std::ptrdiff_t stride, std::ptrdiff_t index) const
+-> accumulator_type {
+	if(stride != std::ptrdiff_t(sizeof(T))) return reduce_strided_run(*this, ptr, n, stride, index);
+	return reduce_contiguous_run(
+		ptr, n, accumulator_type(0),
+		[](const accumulator_type& acc, const T& x) { return acc + static_cast<bool>(x); },
+		[](const accumulator_type& a, const accumulator_type& b) { return a + b; }
+	);
+}
+
+
+template<typename T, bool Value>
+auto any_all_reducer<T, Value>::run(const T* ptr, std::ptrdiff_t n, std::ptrdiff_t stride, std::ptrdiff_t) const
+-> accumulator_type {
+	for(std::ptrdiff_t i = 0; i < n; ++i, ptr = advance_raw_ptr(ptr, stride))
+		if(static_cast<bool>(*ptr) == Value) return Value;
+	return ! Value;
+}
+
+
+template<typename Reducer>
+typename Reducer::accumulator_type reduction_identity_(const Reducer& red, std::true_type) {
+	return red.identity();
+}
+
+template<typename Reducer>
+typename Reducer::accumulator_type reduction_identity_(const Reducer& red, std::false_type) {
+	Assert(false, "cannot reduce empty ndarray_view");
+	return red.identity();
+}
+
+template<typename Reducer>
+typename Reducer::accumulator_type reduction_identity_(const Reducer& red) {
+	return reduction_identity_(red, std::integral_constant<bool, Reducer::has_identity>());
+}
+
+
+/// Accumulator for \a vw, which is not empty. Elements of \a vw have indices starting at \a index.
+template<typename Reducer, std::size_t Dim, typename T>
+typename Reducer::accumulator_type reduce_ndarray_view_accumulator_(const Reducer& red, const ndarray_view<Dim, T>& vw, std::ptrdiff_t index) {
+	strided_loop<Dim, 1> loop(vw.shape(), {{ vw.strides() }});
+	if(! Reducer::uses_index) loop.canonicalize(); // else keep index order
+
+	const std::ptrdiff_t count = loop.run_length();
+	const std::ptrdiff_t stride = loop.run_strides()[0];
+	const T* start = vw.start();
+
+	typename Reducer::accumulator_type acc = red.run(advance_raw_ptr(start, loop.origin()[0]), count, stride, index);
+	bool first = true;
+	loop.run([&](const auto& offsets) {
+		if(first) { first = false; return ! red.saturated(acc); }
+		index += count;
+		red.merge(acc, red.run(advance_raw_ptr(start, offsets[0]), count, stride, index));
+		return ! red.saturated(acc);
+	});
+	return acc;
+}
+
+
+template<typename Reducer, std::size_t Dim, typename T>
+typename Reducer::result_type reduce_ndarray_view(const Reducer& red, const ndarray_view<Dim, T>& vw) {
+	if(vw.size() == 0) return red.result(reduction_identity_(red), 0);
+	else return red.result(reduce_ndarray_view_accumulator_(red, vw, 0), vw.size());
+}
+
+
+template<typename Reducer, std::size_t Dim, typename T>
+typename Reducer::result_type reduce_ndarray_view(const execution::parallel_policy& pol, const Reducer& red, const ndarray_view<Dim, T>& vw) {
+	if(vw.size() == 0) return red.result(reduction_identity_(red), 0);
+
+	// reducers using the index need blocks of consecutive indices
+	axis_partition part = Reducer::uses_index
+		? make_axis_partition(pol, vw.shape(), sizeof(T))
+		: make_axis_partition(pol, vw.shape(), vw.strides(), sizeof(T));
+	if(part.blocks == 1) return reduce_ndarray_view(red, vw);
+
+	// wrapped, so that threads don't write into same word of std::vector<bool>
+	struct partial { typename Reducer::accumulator_type acc; };
+	std::vector<partial> partials(part.blocks);
+	const std::ptrdiff_t block_index_factor = vw.size() / part.extent;
+	parallel_partition_blocks(pol, part, [&](std::size_t b) {
+		std::ptrdiff_t start = part.block_start(b), end = part.block_end(b);
+		partials[b].acc = reduce_ndarray_view_accumulator_(red, vw.axis_section(part.axis, start, end, 1), start * block_index_factor);
+	});
+
+	// combine in fixed tree order
+	for(std::size_t w = 1; w < part.blocks; w *= 2)
+		for(std::size_t b = 0; b + w < part.blocks; b += 2 * w) red.merge(partials[b].acc, partials[b + w].acc);
+	return red.result(partials[0].acc, vw.size());
+}
+
+
+/// Number of output elements that get accumulated together in reduce_ndarray_view_axis_slices_().
+constexpr std::ptrdiff_t reduction_axis_block_length = 1024;
+
+
+template<typename Reducer, std::size_t Dim, typename T>
+void reduce_ndarray_view_axis_runs_(
+	const Reducer& red, const ndarray_view<Dim, T>& vw, std::ptrdiff_t axis,
+	const ndarray_view<Dim - 1, typename Reducer::result_type>& out
+) {
+	// each output element is reduced from one run along axis
+	using result_type = typename Reducer::result_type;
+	const std::ptrdiff_t length = vw.shape()[axis];
+	const std::ptrdiff_t axis_stride = vw.strides()[axis];
+
+	strided_loop<Dim - 1, 2> loop(out.shape(), {{ vw.strides().erase(axis), out.strides() }});
+	loop.canonicalize();
+	const std::ptrdiff_t count = loop.run_length();
+	const std::ptrdiff_t src_stride = loop.run_strides()[0];
+	const std::ptrdiff_t out_stride = loop.run_strides()[1];
+	loop.run([&](const auto& offsets) {
+		const T* src = advance_raw_ptr(vw.start(), offsets[0]);
+		result_type* dst = advance_raw_ptr(out.start(), offsets[1]);
+		for(std::ptrdiff_t i = 0; i < count; ++i) {
+			*dst = red.result(red.run(src, length, axis_stride, 0), length);
+			src = advance_raw_ptr(src, src_stride);
+			dst = advance_raw_ptr(dst, out_stride);
+		}
+	});
+}
+
+
+template<typename Reducer, std::size_t Dim, typename T>
+void reduce_ndarray_view_axis_slices_(
+	const Reducer& red, const ndarray_view<Dim, T>& vw, std::ptrdiff_t axis,
+	const ndarray_view<Dim - 1, typename Reducer::result_type>& out
+) {
+	// traverse slices in memory order, accumulate into block of accumulators that stays in cache
+	using accumulator_type = typename Reducer::accumulator_type;
+	using result_type = typename Reducer::result_type;
+	const std::ptrdiff_t length = vw.shape()[axis];
+	const std::ptrdiff_t axis_stride = vw.strides()[axis];
+
+	strided_loop<Dim - 1, 2> loop(out.shape(), {{ vw.strides().erase(axis), out.strides() }});
+	loop.canonicalize();
+	const std::ptrdiff_t count = loop.run_length();
+	const std::ptrdiff_t src_stride = loop.run_strides()[0];
+	const std::ptrdiff_t out_stride = loop.run_strides()[1];
+	const bool contiguous = (src_stride == std::ptrdiff_t(sizeof(T)));
+
+	std::unique_ptr<accumulator_type[]> accs(new accumulator_type[std::min(count, reduction_axis_block_length)]);
+	loop.run([&](const auto& offsets) {
+		const T* src_run = advance_raw_ptr(vw.start(), offsets[0]);
+		result_type* dst_run = advance_raw_ptr(out.start(), offsets[1]);
+		for(std::ptrdiff_t block_start = 0; block_start < count; block_start += reduction_axis_block_length) {
+			const std::ptrdiff_t n = std::min(count - block_start, reduction_axis_block_length);
+			const T* src = advance_raw_ptr(src_run, block_start * src_stride);
+			accumulator_type* acc = accs.get();
+
+			for(std::ptrdiff_t i = 0; i < n; ++i) acc[i] = red.first(*advance_raw_ptr(src, i * src_stride), 0);
+			for(std::ptrdiff_t k = 1; k < length; ++k) {
+				src = advance_raw_ptr(src, axis_stride);
+				if(contiguous) for(std::ptrdiff_t i = 0; i < n; ++i) red.next(acc[i], src[i], k);
+				else for(std::ptrdiff_t i = 0; i < n; ++i) red.next(acc[i], *advance_raw_ptr(src, i * src_stride), k);
+			}
+
+			result_type* dst = advance_raw_ptr(dst_run, block_start * out_stride);
+			for(std::ptrdiff_t i = 0; i < n; ++i, dst = advance_raw_ptr(dst, out_stride)) *dst = red.result(acc[i], length);
+		}
+	});
+}
+
+
+template<typename Reducer, std::size_t Dim, typename T>
+void reduce_ndarray_view_axis(
+	const Reducer& red, const ndarray_view<Dim, T>& vw, std::ptrdiff_t axis,
+	const ndarray_view<Dim - 1, typename Reducer::result_type>& out
+) {
+	static_assert(Dim > 1, "reduction along axis requires ndarray_view with at least 2 dimensions");
+	Assert_crit(axis >= 0 && axis < Dim, "invalid axis");
+	Assert_crit(out.shape() == vw.shape().erase(axis), "output of reduction along axis has wrong shape");
+	if(out.size() == 0) return;
+	if(vw.shape()[axis] == 0) {
+		out.fill(red.result(reduction_identity_(red), 0));
+		return;
+	}
+
+	// whether axis has smallest stride, among non-degenerate axes
+	bool innermost = true;
+	for(std::ptrdiff_t i = 0; i < Dim; ++i)
+		if(i != axis && vw.shape()[i] > 1 && std::abs(vw.strides()[i]) < std::abs(vw.strides()[axis])) innermost = false;
+
+	if(innermost || vw.shape()[axis] == 1) reduce_ndarray_view_axis_runs_(red, vw, axis, out);
+	else reduce_ndarray_view_axis_slices_(red, vw, axis, out);
+}
+
+
+template<typename Reducer, std::size_t Dim, typename T>
+void reduce_ndarray_view_axis(
+	const execution::parallel_policy& pol, const Reducer& red, const ndarray_view<Dim, T>& vw, std::ptrdiff_t axis,
+	const ndarray_view<Dim - 1, typename Reducer::result_type>& out
+) {
+	static_assert(Dim > 1, "reduction along axis requires ndarray_view with at least 2 dimensions");
+	Assert_crit(axis >= 0 && axis < Dim, "invalid axis");
+	Assert_crit(out.shape() == vw.shape().erase(axis), "output of reduction along axis has wrong shape");
+	if(out.size() == 0) return;
+
+	// partition output, each block of output is reduced from corresponding section of vw
+	axis_partition part = make_axis_partition(pol, out.shape(), out.strides(), sizeof(T) * vw.shape()[axis]);
+	const std::ptrdiff_t vw_axis = (part.axis < axis ? part.axis : part.axis + 1);
+	parallel_partition_blocks(pol, part, [&](std::size_t b) {
+		std::ptrdiff_t start = part.block_start(b), end = part.block_end(b);
+		reduce_ndarray_view_axis(
+			red, vw.axis_section(vw_axis, start, end, 1), axis, out.axis_section(part.axis, start, end, 1)
+		);
+	});
+}
+
+
+#if TLZ_ND_WITH_ALLOCATION
+template<typename Reducer, std::size_t Dim, typename T>
+ndarray<Dim - 1, typename Reducer::result_type> reduce_ndarray_view_axis(const Reducer& red, const ndarray_view<Dim, T>& vw, std::ptrdiff_t axis) {
+	Assert_crit(axis >= 0 && axis < Dim, "invalid axis");
+	ndarray<Dim - 1, typename Reducer::result_type> out(vw.shape().erase(axis));
+	reduce_ndarray_view_axis(red, vw, axis, out.view());
+	return out;
+}
+
+
+template<typename Reducer, std::size_t Dim, typename T>
+ndarray<Dim - 1, typename Reducer::result_type> reduce_ndarray_view_axis(
+	const execution::parallel_policy& pol, const Reducer& red, const ndarray_view<Dim, T>& vw, std::ptrdiff_t axis
+) {
+	Assert_crit(axis >= 0 && axis < Dim, "invalid axis");
+	ndarray<Dim - 1, typename Reducer::result_type> out(vw.shape().erase(axis));
+	reduce_ndarray_view_axis(pol, red, vw, axis, out.view());
+	return out;
+}
+#endif
+
+}
+
+}
@@ -0,0 +1,140 @@
+#ifndef TLZ_NDARRAY_TILED_H_
+#define TLZ_NDARRAY_TILED_H_
+
+#include "config.h"
+#if TLZ_ND_WITH_ALLOCATION
+
+#include <memory>
+#include <type_traits>
+#include "common.h"
+#include "ndarray_tiled_view.h"
+#include "ndarray.h"
+#include "detail/ndarray_wrapper.h"
+
+namespace tlz {
+
+/// Container for \ref ndarray_tiled_view.
+/** Allocates and owns the storage of an array of shape \a shape stored in bricks of shape \a brick_shape. The storage
+ ** includes the padding elements of the edge bricks. Like \ref ndarray, `const` access to the container gives only
+ ** `const` access to the elements. */
+template<std::size_t Dim, typename Elem, typename Allocator = std::allocator<Elem>>
+class ndarray_tiled {
+	static_assert(! std::is_const<Elem>::value, "ndarray_tiled Elem cannot be const");
+
+public:
+	using view_type = ndarray_tiled_view<Dim, Elem>;
+	using const_view_type = ndarray_tiled_view<Dim, const Elem>;
+	using allocator_type = Allocator;
+	using value_type = Elem;
+	using coordinates_type = typename view_type::coordinates_type;
+	using shape_type = typename view_type::shape_type;
+	using span_type = typename view_type::span_type;
+
+private:
+	detail::ndarray_buffer<Allocator> buffer_; ///< Allocated storage.
+	view_type view_; ///< View to full array.
+
+	/// Reset to new shape and brick shape, with default-constructed elements.
+	/** Reuses the buffer if it is large enough, like \ref ndarray. */
+	void reset_(const shape_type& shape, const shape_type& brick_shape);
+	void construct_elems_();
+	void destruct_elems_();
+
+public:
+	/// \name Construction
+	///@{
+	/// Construct \ref ndarray_tiled with given shape and brick shape.
+	ndarray_tiled(const shape_type& shape, const shape_type& brick_shape, const Allocator& = Allocator());
+
+	/// Construct \ref ndarray_tiled with shape and copy of elements from \ref ndarray_view \a vw.
+	ndarray_tiled(const ndarray_view<Dim, const Elem>& vw, const shape_type& brick_shape, const Allocator& = Allocator());
+
+	/// Copy-construct from another \ref ndarray_tiled, with same brick shape.
+	ndarray_tiled(const ndarray_tiled&);
+
+	/// Move-construct from another \ref ndarray_tiled, and set \a arr to null.
+	ndarray_tiled(ndarray_tiled&& arr);
+
+	~ndarray_tiled();
+
+	ndarray_tiled& operator=(const ndarray_tiled&);
+	ndarray_tiled& operator=(ndarray_tiled&&);
+	///@}
+
+
+	/// \name View access
+	///@{
+	const view_type& view() { return view_; }
+	const_view_type view() const { return cview(); }
+	const_view_type cview() const { return const_view_type(view_); }
+
+	operator const view_type& () { return view(); }
+	operator const_view_type () const { return cview(); }
+	///@}
+
+
+	/// \name Attributes
+	///@{
+	constexpr static std::size_t dimension() { return Dim; }
+	const shape_type& shape() const { return view_.shape(); }
+	std::size_t size() const { return view_.size(); }
+	span_type full_span() const { return view_.full_span(); }
+	const shape_type& brick_shape() const { return view_.brick_shape(); }
+
+	std::size_t allocated_byte_size() const { return buffer_.size(); }
+	const allocator_type& get_allocator() const { return buffer_.get_allocator(); }
+	///@}
+
+
+	/// \name Indexing
+	///@{
+	Elem& at(const coordinates_type& coord) { return view_.at(coord); }
+	const Elem& at(const coordinates_type& coord) const { return cview().at(coord); }
+
+	view_type section(const coordinates_type& start, const coordinates_type& end) { return view_.section(start, end); }
+	const_view_type section(const coordinates_type& start, const coordinates_type& end) const
+		{ return cview().section(start, end); }
+	view_type section(const span_type& span) { return view_.section(span); }
+	const_view_type section(const span_type& span) const { return cview().section(span); }
+	///@}
+
+
+	/// \name Deep assignment and comparison
+	///@{
+	/// Assign elements from \ref ndarray_view \a vw of same shape.
+	void assign(const ndarray_view<Dim, const Elem>& vw) { view_.assign(vw); }
+	void fill(const Elem& val) { view_.fill(val); }
+	void copy_to(const ndarray_view<Dim, Elem>& out) const { cview().copy_to(out); }
+
+	template<typename Other> bool compare(const Other& other) const { return cview().compare(other); }
+	template<typename Other> bool operator==(const Other& other) const { return cview().compare(other); }
+	template<typename Other> bool operator!=(const Other& other) const { return ! cview().compare(other); }
+	///@}
+
+
+	/// \name Iteration
+	///@{
+	/// Iterators in storage order, see \ref ndarray_tiled_iterator.
+	auto begin() { return view_.begin(); }
+	auto begin() const { return cview().begin(); }
+	auto end() { return view_.end(); }
+	auto end() const { return cview().end(); }
+	///@}
+};
+
+
+/// Copy tiled view \a vw into new \ref ndarray, with default strides.
+template<std::size_t Dim, typename Elem>
+auto make_ndarray(const ndarray_tiled_view<Dim, Elem>& vw) {
+	using array_elem_type = std::remove_const_t<Elem>;
+	ndarray<Dim, array_elem_type> arr(vw.shape());
+	vw.copy_to(arr.view());
+	return arr;
+}
+
+}
+
+#include "ndarray_tiled.tcc"
+
+#endif
+#endif
@@ -0,0 +1,95 @@
+#include <utility>
+
+namespace tlz {
+
+
+template<std::size_t Dim, typename Elem, typename Allocator>
+void ndarray_tiled<Dim, Elem, Allocator>::construct_elems_() {
+	if(std::is_pod<Elem>::value || view_.is_null()) return;
+	Elem* buffer = static_cast<Elem*>(buffer_.get());
+	std::size_t length = view_type::storage_length(shape(), brick_shape());
+	for(std::size_t i = 0; i < length; ++i) new (buffer + i) Elem;
+}
+
+
+template<std::size_t Dim, typename Elem, typename Allocator>
+void ndarray_tiled<Dim, Elem, Allocator>::destruct_elems_() {
+	if(std::is_pod<Elem>::value || view_.is_null()) return;
+	Elem* buffer = static_cast<Elem*>(buffer_.get());
+	std::size_t length = view_type::storage_length(shape(), brick_shape());
+	for(std::size_t i = 0; i < length; ++i) buffer[i].~Elem();
+}
+
+
+template<std::size_t Dim, typename Elem, typename Allocator>
+void ndarray_tiled<Dim, Elem, Allocator>::reset_(const shape_type& shape, const shape_type& brick_shape) {
+	destruct_elems_();
+	buffer_.reset(view_type::storage_length(shape, brick_shape) * sizeof(Elem), alignof(Elem));
+	view_.reset(view_type(static_cast<Elem*>(buffer_.get()), shape, brick_shape));
+	construct_elems_();
+}
+
+
+template<std::size_t Dim, typename Elem, typename Allocator>
+ndarray_tiled<Dim, Elem, Allocator>::ndarray_tiled
+(const shape_type& shape, const shape_type& brick_shape, const Allocator& allocator) :
+	buffer_(allocator)
+{
+	reset_(shape, brick_shape);
+}
+
+
+template<std::size_t Dim, typename Elem, typename Allocator>
+ndarray_tiled<Dim, Elem, Allocator>::ndarray_tiled
+(const ndarray_view<Dim, const Elem>& vw, const shape_type& brick_shape, const Allocator& allocator) :
+	ndarray_tiled(vw.shape(), brick_shape, allocator)
+{
+	Assert(! vw.is_null());
+	view_.assign(vw);
+}
+
+
+template<std::size_t Dim, typename Elem, typename Allocator>
+ndarray_tiled<Dim, Elem, Allocator>::ndarray_tiled(const ndarray_tiled& arr) :
+	ndarray_tiled(arr.shape(), arr.brick_shape(), arr.get_allocator())
+{
+	view_.assign(arr.cview());
+}
+
+
+template<std::size_t Dim, typename Elem, typename Allocator>
+ndarray_tiled<Dim, Elem, Allocator>::ndarray_tiled(ndarray_tiled&& arr) :
+	buffer_(std::move(arr.buffer_)),
+	view_(arr.view_)
+{
+	arr.view_.reset(view_type());
+}
+
+
+template<std::size_t Dim, typename Elem, typename Allocator>
+ndarray_tiled<Dim, Elem, Allocator>::~ndarray_tiled() {
+	destruct_elems_();
+}
+
+
+template<std::size_t Dim, typename Elem, typename Allocator>
+auto ndarray_tiled<Dim, Elem, Allocator>::operator=(const ndarray_tiled& arr) -> ndarray_tiled& {
+	if(&arr == this) return *this;
+	if(shape() != arr.shape() || brick_shape() != arr.brick_shape()) reset_(arr.shape(), arr.brick_shape());
+	view_.assign(arr.cview());
+	return *this;
+}
+
+
+template<std::size_t Dim, typename Elem, typename Allocator>
+auto ndarray_tiled<Dim, Elem, Allocator>::operator=(ndarray_tiled&& arr) -> ndarray_tiled& {
+	if(&arr == this) return *this;
+	destruct_elems_();
+	buffer_ = std::move(arr.buffer_);
+	view_.reset(arr.view_);
+	arr.view_.reset(view_type());
+	return *this;
+}
+
+
+}
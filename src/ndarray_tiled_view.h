@@ -0,0 +1,212 @@
+#ifndef TLZ_NDARRAY_TILED_VIEW_H_
+#define TLZ_NDARRAY_TILED_VIEW_H_
+
+#include <iterator>
+#include <type_traits>
+#include "common.h"
+#include "ndcoord.h"
+#include "ndspan.h"
+#include "ndarray_view.h"
+
+namespace tlz {
+
+template<std::size_t Dim, typename T> class ndarray_tiled_view;
+
+
+/// Forward iterator which traverses an \ref ndarray_tiled_view in storage order.
+/** Visits the bricks which intersect the view in row-major order of the brick grid, and the elements of each brick in
+ ** row-major order. This follows the memory layout, so it is the efficient order when the caller does not care about
+ ** the order of elements. */
+template<std::size_t Dim, typename T>
+class ndarray_tiled_iterator {
+public:
+	using view_type = ndarray_tiled_view<Dim, T>;
+	using brick_view_type = ndarray_view<Dim, T>;
+	using value_type = std::remove_const_t<T>;
+	using iterator_category = std::forward_iterator_tag;
+	using difference_type = std::ptrdiff_t;
+	using pointer = T*;
+	using reference = T&;
+	using coordinates_type = ndptrdiff<Dim>;
+
+private:
+	view_type view_;
+	coordinates_type brick_pos_; ///< Position of current brick in brick grid.
+	brick_view_type brick_section_; ///< Section of current brick which lies in the view.
+	coordinates_type brick_coord_; ///< Coordinates of current element in brick_section_.
+	pointer pointer_ = nullptr;
+	std::ptrdiff_t count_ = 0; ///< Number of elements visited before the current one.
+
+	void enter_brick_();
+	void next_row_();
+
+public:
+	ndarray_tiled_iterator() = default;
+	ndarray_tiled_iterator(const view_type& vw, bool end);
+
+	pointer ptr() const { return pointer_; }
+	reference operator*() const { return *pointer_; }
+	pointer operator->() const { return pointer_; }
+
+	/// Coordinates of current element in the view.
+	coordinates_type coordinates() const;
+
+	ndarray_tiled_iterator& operator++();
+	ndarray_tiled_iterator operator++(int) { auto copy = *this; ++(*this); return copy; }
+
+	friend bool operator==(const ndarray_tiled_iterator& a, const ndarray_tiled_iterator& b) noexcept
+		{ return a.count_ == b.count_; }
+	friend bool operator!=(const ndarray_tiled_iterator& a, const ndarray_tiled_iterator& b) noexcept
+		{ return a.count_ != b.count_; }
+};
+
+
+/// View to _n_-d data stored in fixed-shape bricks, for locality of neighborhood access.
+/** The underlying array is subdivided into a grid of bricks of shape \a brick_shape, for example `8x8x8`. Each brick is
+ ** stored contiguously in row-major order, and the bricks are stored after each other in row-major order of the brick
+ ** grid. Bricks at the end of an axis are stored with the full brick shape, so the storage holds
+ ** storage_length() elements. With this layout, elements which are close in any axis tend to lie on the same page.
+ **
+ ** Unlike \ref ndarray_view, there are no strides. `ndarray_tiled_view` can be sectioned, and the part of one brick
+ ** inside the view is always a plain \ref ndarray_view. Assignment, comparison and for_each_brick() operate brick by
+ ** brick, so that conversions to and from \ref ndarray_view use the optimized strided copy for each brick. The
+ ** iterator traverses elements in storage order, not in index order.
+ **
+ ** Like \ref ndarray_view, the view is non-owning, and assignment and comparison are deep. */
+template<std::size_t Dim, typename T>
+class ndarray_tiled_view {
+	template<std::size_t, typename> friend class ndarray_tiled_view;
+
+public:
+	using value_type = T;
+	using pointer = T*;
+	using reference = T&;
+	using coordinates_type = ndptrdiff<Dim>;
+	using shape_type = ndsize<Dim>;
+	using span_type = ndspan<Dim>;
+	using brick_view_type = ndarray_view<Dim, T>;
+	using iterator = ndarray_tiled_iterator<Dim, T>;
+
+private:
+	using nonconst_value_type = std::remove_const_t<T>;
+
+	pointer origin_ = nullptr; ///< Start of first brick of the underlying array.
+	shape_type brick_shape_; ///< Shape of each brick.
+	shape_type bricks_shape_; ///< Shape of brick grid of the underlying array.
+	coordinates_type offset_; ///< Coordinates in underlying array of first element of view.
+	shape_type shape_; ///< Shape of the view.
+
+	ndarray_tiled_view(pointer origin, const shape_type& brick_shape, const shape_type& bricks_shape,
+		const coordinates_type& offset, const shape_type& shape) :
+		origin_(origin), brick_shape_(brick_shape), bricks_shape_(bricks_shape), offset_(offset), shape_(shape) { }
+
+	std::size_t brick_length_() const { return brick_shape_.product(); }
+
+public:
+	/// \name Construction
+	///@{
+	/// Create null view.
+	ndarray_tiled_view() = default;
+
+	/// Create view to tiled array with shape \a shape, stored starting at \a origin with bricks of shape \a brick_shape.
+	ndarray_tiled_view(pointer origin, const shape_type& shape, const shape_type& brick_shape);
+
+	/// Copy-construct view. Can create view to `const T` from view to `T`.
+	ndarray_tiled_view(const ndarray_tiled_view<Dim, nonconst_value_type>& vw) :
+		ndarray_tiled_view(vw.origin_, vw.brick_shape_, vw.bricks_shape_, vw.offset_, vw.shape_) { }
+
+	bool is_null() const { return (origin_ == nullptr); }
+	explicit operator bool () const { return ! is_null(); }
+
+	void reset(const ndarray_tiled_view& other);
+	///@}
+
+
+	/// \name Attributes
+	///@{
+	static constexpr std::size_t dimension() { return Dim; }
+
+	const shape_type& shape() const { return shape_; }
+	std::size_t size() const { return shape_.product(); }
+	span_type full_span() const { return span_type(0, shape_); }
+
+	const shape_type& brick_shape() const { return brick_shape_; }
+
+	/// Number of bricks along each axis, for array of shape \a shape.
+	static shape_type bricks_shape(const shape_type& shape, const shape_type& brick_shape);
+
+	/// Number of elements in storage of tiled array of shape \a shape, including padding in the edge bricks.
+	static std::size_t storage_length(const shape_type& shape, const shape_type& brick_shape) {
+		return bricks_shape(shape, brick_shape).product() * brick_shape.product();
+	}
+
+	/// Span of the view covered by brick at position \a brick_pos of the brick grid of the underlying array.
+	span_type brick_span(const coordinates_type& brick_pos) const;
+
+	/// Position in brick grid of the underlying array of brick containing element at \a coord of the view.
+	coordinates_type brick_position(const coordinates_type& coord) const;
+	///@}
+
+
+	/// \name Indexing
+	///@{
+	pointer coordinates_to_pointer(const coordinates_type&) const;
+
+	/// Access element at coordinates \a coord.
+	reference at(const coordinates_type& coord) const;
+
+	/// Cuboid section of view. Remains tiled with same bricks.
+	ndarray_tiled_view section(const coordinates_type& start, const coordinates_type& end) const;
+	ndarray_tiled_view section(const span_type& span) const { return section(span.start_pos(), span.end_pos()); }
+
+	/// Part of the brick at position \a brick_pos which lies in the view, as \ref ndarray_view.
+	brick_view_type brick(const coordinates_type& brick_pos) const;
+
+	/// Call \a func for each brick which intersects the view, in storage order.
+	/** \a func receives the part of the brick in the view, as \ref ndarray_view, and the span it covers in the view. */
+	template<typename Function> void for_each_brick(Function&& func) const;
+	///@}
+
+
+	/// \name Deep assignment
+	///@{
+	/// Assign elements from \ref ndarray_view \a vw of same shape.
+	void assign(const ndarray_view<Dim, const nonconst_value_type>& vw) const;
+
+	/// Assign elements from other tiled view of same shape. Brick shapes may differ.
+	void assign(const ndarray_tiled_view<Dim, const nonconst_value_type>& vw) const;
+
+	void fill(const nonconst_value_type& val) const;
+
+	/// Copy elements into \ref ndarray_view \a out of same shape.
+	void copy_to(const ndarray_view<Dim, nonconst_value_type>& out) const;
+
+	template<typename Other>
+	const ndarray_tiled_view& operator=(const Other& other) const { assign(other); return *this; }
+	const ndarray_tiled_view& operator=(const ndarray_tiled_view& other) const { assign(other); return *this; }
+	///@}
+
+
+	/// \name Deep comparison
+	///@{
+	bool compare(const ndarray_view<Dim, const nonconst_value_type>& vw) const;
+	bool compare(const ndarray_tiled_view<Dim, const nonconst_value_type>& vw) const;
+
+	template<typename Other> bool operator==(const Other& other) const { return compare(other); }
+	template<typename Other> bool operator!=(const Other& other) const { return ! compare(other); }
+	///@}
+
+
+	/// \name Iteration
+	///@{
+	iterator begin() const { return iterator(*this, false); }
+	iterator end() const { return iterator(*this, true); }
+	///@}
+};
+
+
+}
+
+#include "ndarray_tiled_view.tcc"
+
+#endif
@@ -0,0 +1,227 @@
+#include <algorithm>
+
+namespace tlz {
+
+
+template<std::size_t Dim, typename T>
+ndarray_tiled_iterator<Dim, T>::ndarray_tiled_iterator(const view_type& vw, bool end) :
+	view_(vw)
+{
+	if(end || vw.size() == 0) {
+		count_ = vw.size();
+	} else {
+		brick_pos_ = vw.brick_position(coordinates_type(0));
+		enter_brick_();
+	}
+}
+
+
+template<std::size_t Dim, typename T>
+void ndarray_tiled_iterator<Dim, T>::enter_brick_() {
+	brick_section_.reset(view_.brick(brick_pos_));
+	brick_coord_ = coordinates_type(0);
+	pointer_ = brick_section_.start();
+}
+
+
+template<std::size_t Dim, typename T>
+void ndarray_tiled_iterator<Dim, T>::next_row_() {
+	brick_coord_[Dim - 1] = 0;
+	for(std::ptrdiff_t i = Dim - 2; i >= 0; --i) {
+		if(++brick_coord_[i] < brick_section_.shape()[i]) {
+			pointer_ = brick_section_.coordinates_to_pointer(brick_coord_);
+			return;
+		}
+		brick_coord_[i] = 0;
+	}
+
+	// end of brick: go to next brick intersecting the view, in row-major order of the brick grid
+	coordinates_type first_brick = view_.brick_position(coordinates_type(0));
+	coordinates_type last_brick = view_.brick_position(coordinates_type(view_.shape()) - coordinates_type(1));
+	for(std::ptrdiff_t i = Dim - 1; i >= 0; --i) {
+		if(++brick_pos_[i] <= last_brick[i]) break;
+		brick_pos_[i] = first_brick[i];
+	}
+	enter_brick_();
+}
+
+
+template<std::size_t Dim, typename T>
+auto ndarray_tiled_iterator<Dim, T>::operator++() -> ndarray_tiled_iterator& {
+	if(++count_ == std::ptrdiff_t(view_.size())) return *this;
+	if(++brick_coord_[Dim - 1] < brick_section_.shape()[Dim - 1]) ++pointer_;
+	else next_row_();
+	return *this;
+}
+
+
+template<std::size_t Dim, typename T>
+auto ndarray_tiled_iterator<Dim, T>::coordinates() const -> coordinates_type {
+	return view_.brick_span(brick_pos_).start_pos() + brick_coord_;
+}
+
+
+///////////////
+
+
+template<std::size_t Dim, typename T>
+ndarray_tiled_view<Dim, T>::ndarray_tiled_view(pointer origin, const shape_type& shape, const shape_type& brick_shape) :
+	origin_(origin),
+	brick_shape_(brick_shape),
+	bricks_shape_(bricks_shape(shape, brick_shape)),
+	offset_(0),
+	shape_(shape) { }
+
+
+template<std::size_t Dim, typename T>
+void ndarray_tiled_view<Dim, T>::reset(const ndarray_tiled_view& other) {
+	origin_ = other.origin_;
+	brick_shape_ = other.brick_shape_;
+	bricks_shape_ = other.bricks_shape_;
+	offset_ = other.offset_;
+	shape_ = other.shape_;
+}
+
+
+template<std::size_t Dim, typename T>
+auto ndarray_tiled_view<Dim, T>::bricks_shape(const shape_type& shape, const shape_type& brick_shape) -> shape_type {
+	shape_type bricks;
+	for(std::ptrdiff_t i = 0; i < Dim; ++i) {
+		Assert(brick_shape[i] > 0, "ndarray_tiled_view brick shape must be non-zero");
+		bricks[i] = (shape[i] + brick_shape[i] - 1) / brick_shape[i];
+	}
+	return bricks;
+}
+
+
+template<std::size_t Dim, typename T>
+auto ndarray_tiled_view<Dim, T>::brick_span(const coordinates_type& brick_pos) const -> span_type {
+	coordinates_type start, end;
+	for(std::ptrdiff_t i = 0; i < Dim; ++i) {
+		std::ptrdiff_t brick_start = brick_pos[i] * brick_shape_[i] - offset_[i];
+		start[i] = std::max<std::ptrdiff_t>(brick_start, 0);
+		end[i] = std::min<std::ptrdiff_t>(brick_start + brick_shape_[i], shape_[i]);
+		Assert(start[i] <= end[i], "brick must intersect ndarray_tiled_view");
+	}
+	return span_type(start, end);
+}
+
+
+template<std::size_t Dim, typename T>
+auto ndarray_tiled_view<Dim, T>::brick_position(const coordinates_type& coord) const -> coordinates_type {
+	coordinates_type brick_pos;
+	for(std::ptrdiff_t i = 0; i < Dim; ++i) brick_pos[i] = (offset_[i] + coord[i]) / brick_shape_[i];
+	return brick_pos;
+}
+
+
+template<std::size_t Dim, typename T>
+auto ndarray_tiled_view<Dim, T>::coordinates_to_pointer(const coordinates_type& coord) const -> pointer {
+	std::ptrdiff_t brick_index = 0, inner_index = 0;
+	for(std::ptrdiff_t i = 0; i < Dim; ++i) {
+		std::ptrdiff_t pos = offset_[i] + coord[i];
+		std::ptrdiff_t b = pos / brick_shape_[i];
+		brick_index = brick_index * bricks_shape_[i] + b;
+		inner_index = inner_index * brick_shape_[i] + (pos - b * brick_shape_[i]);
+	}
+	return origin_ + (brick_index * brick_length_() + inner_index);
+}
+
+
+template<std::size_t Dim, typename T>
+auto ndarray_tiled_view<Dim, T>::at(const coordinates_type& coord) const -> reference {
+	Assert_crit(full_span().includes(coord), "ndarray_tiled_view coordinates out of bounds");
+	return *coordinates_to_pointer(coord);
+}
+
+
+template<std::size_t Dim, typename T>
+auto ndarray_tiled_view<Dim, T>::section(const coordinates_type& start, const coordinates_type& end) const
+-> ndarray_tiled_view {
+	Assert_crit(full_span().includes(span_type(start, end)), "ndarray_tiled_view section out of bounds");
+	return ndarray_tiled_view(origin_, brick_shape_, bricks_shape_, offset_ + start, end - start);
+}
+
+
+template<std::size_t Dim, typename T>
+auto ndarray_tiled_view<Dim, T>::brick(const coordinates_type& brick_pos) const -> brick_view_type {
+	span_type span = brick_span(brick_pos);
+	std::ptrdiff_t brick_index = 0;
+	for(std::ptrdiff_t i = 0; i < Dim; ++i) brick_index = brick_index * bricks_shape_[i] + brick_pos[i];
+	brick_view_type brick_vw(origin_ + brick_index * brick_length_(), brick_shape_);
+	coordinates_type brick_start = brick_pos * coordinates_type(brick_shape_) - offset_;
+	return brick_vw.section(span.start_pos() - brick_start, span.end_pos() - brick_start);
+}
+
+
+template<std::size_t Dim, typename T> template<typename Function>
+void ndarray_tiled_view<Dim, T>::for_each_brick(Function&& func) const {
+	if(size() == 0) return;
+	coordinates_type first_brick = brick_position(coordinates_type(0));
+	coordinates_type last_brick = brick_position(coordinates_type(shape_) - coordinates_type(1));
+	for(const coordinates_type& brick_pos : make_ndspan(first_brick, last_brick + coordinates_type(1)))
+		func(brick(brick_pos), brick_span(brick_pos));
+}
+
+
+template<std::size_t Dim, typename T>
+void ndarray_tiled_view<Dim, T>::assign(const ndarray_view<Dim, const nonconst_value_type>& vw) const {
+	static_assert(! std::is_const<value_type>::value, "cannot assign to const ndarray_tiled_view");
+	Assert_crit(shape() == vw.shape(), "ndarray_tiled_view must have same shape for assignment");
+	for_each_brick([&vw](const brick_view_type& brick_sec, const span_type& span) {
+		brick_sec.assign(vw.section(span));
+	});
+}
+
+
+template<std::size_t Dim, typename T>
+void ndarray_tiled_view<Dim, T>::assign(const ndarray_tiled_view<Dim, const nonconst_value_type>& vw) const {
+	static_assert(! std::is_const<value_type>::value, "cannot assign to const ndarray_tiled_view");
+	Assert_crit(shape() == vw.shape(), "ndarray_tiled_view must have same shape for assignment");
+	for_each_brick([&vw](const brick_view_type& brick_sec, const span_type& span) {
+		vw.section(span).copy_to(brick_sec);
+	});
+}
+
+
+template<std::size_t Dim, typename T>
+void ndarray_tiled_view<Dim, T>::fill(const nonconst_value_type& val) const {
+	static_assert(! std::is_const<value_type>::value, "cannot assign to const ndarray_tiled_view");
+	for_each_brick([&val](const brick_view_type& brick_sec, const span_type&) {
+		brick_sec.fill(val);
+	});
+}
+
+
+template<std::size_t Dim, typename T>
+void ndarray_tiled_view<Dim, T>::copy_to(const ndarray_view<Dim, nonconst_value_type>& out) const {
+	Assert_crit(shape() == out.shape(), "output view must have same shape");
+	for_each_brick([&out](const brick_view_type& brick_sec, const span_type& span) {
+		out.section(span).assign(brick_sec);
+	});
+}
+
+
+template<std::size_t Dim, typename T>
+bool ndarray_tiled_view<Dim, T>::compare(const ndarray_view<Dim, const nonconst_value_type>& vw) const {
+	if(shape() != vw.shape()) return false;
+	bool equal = true;
+	for_each_brick([&](const brick_view_type& brick_sec, const span_type& span) {
+		if(equal) equal = brick_sec.compare(vw.section(span));
+	});
+	return equal;
+}
+
+
+template<std::size_t Dim, typename T>
+bool ndarray_tiled_view<Dim, T>::compare(const ndarray_tiled_view<Dim, const nonconst_value_type>& vw) const {
+	if(shape() != vw.shape()) return false;
+	bool equal = true;
+	for_each_brick([&](const brick_view_type& brick_sec, const span_type& span) {
+		if(equal) equal = vw.section(span).compare(brick_sec);
+	});
+	return equal;
+}
+
+
+}
@@ -1,6 +1,7 @@
 #ifndef TLZ_NDARRAY_TRAITS_H_
 #define TLZ_NDARRAY_TRAITS_H_
 
+#include <type_traits>
 #include "common.h"
 
 namespace tlz {
@@ -26,6 +27,34 @@ struct is_convertible_ndarray_view : conjunction<
 	detail::is_convertible_ndarray_view<From_view, To_view>
 > { };
 
+
+/// Whether \a Expr is a lazily evaluated element-wise \ref ndarray_expression.
+template<typename Expr>
+struct is_ndarray_expression : std::false_type {};
+
+
+/// Whether \a View may wrap around, and can be decomposed into ordinary views using `View::for_each_segment()`.
+template<typename View>
+struct is_ndarray_wraparound_view : std::false_type {};
+
+
+namespace detail {
+
+/// Which operand of an assignment or comparison gets decomposed into non-wrapping segments.
+enum class wraparound_operand { none, other, self };
+
+template<typename View, typename Other_view>
+using wraparound_operand_tag = std::integral_constant<wraparound_operand,
+	is_ndarray_wraparound_view<Other_view>::value ? wraparound_operand::other :
+	is_ndarray_wraparound_view<View>::value ? wraparound_operand::self :
+	wraparound_operand::none
+>;
+
+template<wraparound_operand Operand>
+using wraparound_operand_constant = std::integral_constant<wraparound_operand, Operand>;
+
+}
+
 }
 
 #endif
@@ -0,0 +1,104 @@
+#ifndef TLZ_NDARRAY_TRAVERSAL_H_
+#define TLZ_NDARRAY_TRAVERSAL_H_
+
+#include <array>
+#include <utility>
+#include <type_traits>
+#include "common.h"
+#include "ndcoord.h"
+
+namespace tlz {
+
+template<std::size_t Dim, typename T> class ndarray_view;
+
+namespace detail {
+
+/// Loop nest over `Dim` axes, shared by `Arity` strided operands.
+/** Holds the shape, and the strides (in bytes) of each operand. Inner axes along which all operands are contiguous,
+ ** i.e. `strides[i] == shape[i + 1] * strides[i + 1]` for each operand, are merged into one axis. The innermost
+ ** remaining axis is the _run_ axis. run() calls the function once per run, and walks the outer axes using an
+ ** incremental odometer, instead of recomputing coordinates from an index.
+ ** Runs are visited in index order, unless canonicalize() was called. */
+template<std::size_t Dim, std::size_t Arity>
+class strided_loop {
+public:
+	using offsets_type = std::array<std::ptrdiff_t, Arity>;
+	using operand_strides_type = std::array<std::ptrdiff_t, Arity>;
+
+private:
+	std::ptrdiff_t dimension_ = 0; ///< Number of axes in use, the last one is the run axis.
+	std::array<std::size_t, Dim> shape_;
+	std::array<operand_strides_type, Dim> strides_; ///< `strides_[axis][operand]`
+	offsets_type origin_; ///< Offsets of first element, nonzero when axes were reversed.
+	bool empty_ = false;
+
+	void merge_contiguous_axes_();
+	void swap_axes_(std::ptrdiff_t a, std::ptrdiff_t b);
+
+public:
+	strided_loop(const ndsize<Dim>& shape, const std::array<ndptrdiff<Dim>, Arity>& strides);
+
+	/// Reduce loop nest to lowest possible dimension.
+	/** Drops axes of length 1, reverses axes on which the first operand has negative stride, and sorts the axes by
+	 ** descending absolute stride of the first operand, so that the run axis is the one with the smallest stride.
+	 ** Then merges contiguous axes. The correspondence of elements between operands is retained, but afterwards
+	 ** runs are no longer visited in index order. */
+	void canonicalize();
+
+	std::ptrdiff_t dimension() const { return dimension_; }
+	std::size_t shape(std::ptrdiff_t axis) const { return shape_[axis]; }
+	const operand_strides_type& strides(std::ptrdiff_t axis) const { return strides_[axis]; }
+	const offsets_type& origin() const { return origin_; }
+	bool is_empty() const { return empty_; }
+
+	std::size_t run_length() const { return shape_[dimension_ - 1]; }
+	const operand_strides_type& run_strides() const { return strides_[dimension_ - 1]; }
+	std::size_t run_count() const;
+
+	/// Call \a fn for each run.
+	/** `fn(const offsets_type&)` gets the byte offset of the first element of the run, for each operand. If it returns
+	 ** `bool`, traversal stops when it returns `false`. Returns `false` if traversal was stopped. */
+	template<typename Function> bool run(Function&& fn) const;
+};
+
+
+/// Call \a fn with \a args, return its result if it is `bool`, or `true` if it is `void`.
+template<typename Function, typename... Args>
+auto invoke_run_function(Function& fn, Args&&... args)
+-> std::enable_if_t<std::is_void<decltype(fn(std::forward<Args>(args)...))>::value, bool> {
+	fn(std::forward<Args>(args)...);
+	return true;
+}
+
+template<typename Function, typename... Args>
+auto invoke_run_function(Function& fn, Args&&... args)
+-> std::enable_if_t<! std::is_void<decltype(fn(std::forward<Args>(args)...))>::value, bool> {
+	return fn(std::forward<Args>(args)...);
+}
+
+}
+
+
+/// Call \a fn for each run of elements in \a vw.
+/** A run is a sequence of elements with constant stride. `fn(pointer ptr, std::ptrdiff_t count, std::ptrdiff_t stride)`
+ ** receives pointer to first element, number of elements and stride (in bytes) of the run. The axes of \a vw are
+ ** reordered, reversed and merged as by `detail::strided_loop::canonicalize()`, so that `fn` gets called as rarely as
+ ** possible, and memory gets traversed in ascending address order when possible. The order in which elements are
+ ** visited is unspecified.
+ ** If `fn` returns `bool`, traversal is stopped when it returns `false`, and then `false` is returned. */
+template<std::size_t Dim, typename T, typename Function>
+bool for_each_run(const ndarray_view<Dim, T>& vw, Function&& fn);
+
+
+/// Call \a fn for each pair of corresponding runs of elements in \a a and \a b.
+/** \a a and \a b must have same shape. Runs are delimited such that they are runs in both views.
+ ** `fn(T1* a_ptr, T2* b_ptr, std::ptrdiff_t count, std::ptrdiff_t a_stride, std::ptrdiff_t b_stride)`.
+ ** If `fn` returns `bool`, traversal is stopped when it returns `false`, and then `false` is returned. */
+template<std::size_t Dim, typename T1, typename T2, typename Function>
+bool for_each_run(const ndarray_view<Dim, T1>& a, const ndarray_view<Dim, T2>& b, Function&& fn);
+
+}
+
+#include "ndarray_traversal.tcc"
+
+#endif
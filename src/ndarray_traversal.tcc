@@ -0,0 +1,165 @@
+#include "ndarray_view.h"
+
+namespace tlz {
+
+namespace detail {
+
+template<std::size_t Dim, std::size_t Arity>
+strided_loop<Dim, Arity>::strided_loop(const ndsize<Dim>& shape, const std::array<ndptrdiff<Dim>, Arity>& strides) :
+	dimension_(Dim)
+{
+	origin_.fill(0);
+	for(std::ptrdiff_t i = 0; i < Dim; ++i) {
+		shape_[i] = shape[i];
+		if(shape_[i] == 0) empty_ = true;
+		for(std::ptrdiff_t k = 0; k < Arity; ++k) strides_[i][k] = strides[k][i];
+	}
+	merge_contiguous_axes_();
+}
+
+
+template<std::size_t Dim, std::size_t Arity>
+void strided_loop<Dim, Arity>::merge_contiguous_axes_() {
+	// merged axes get collected at the back, innermost axis stays last
+	const std::ptrdiff_t last = dimension_ - 1;
+	std::ptrdiff_t top = last;
+	for(std::ptrdiff_t i = last - 1; i >= 0; --i) {
+		bool contiguous = true;
+		for(std::ptrdiff_t k = 0; k < Arity; ++k)
+			if(strides_[i][k] != static_cast<std::ptrdiff_t>(shape_[top]) * strides_[top][k]) contiguous = false;
+
+		if(contiguous) {
+			shape_[top] *= shape_[i];
+		} else {
+			--top;
+			shape_[top] = shape_[i];
+			strides_[top] = strides_[i];
+		}
+	}
+
+	dimension_ = last + 1 - top;
+	if(top > 0) for(std::ptrdiff_t i = 0; i < dimension_; ++i) {
+		shape_[i] = shape_[top + i];
+		strides_[i] = strides_[top + i];
+	}
+}
+
+
+template<std::size_t Dim, std::size_t Arity>
+void strided_loop<Dim, Arity>::swap_axes_(std::ptrdiff_t a, std::ptrdiff_t b) {
+	std::swap(shape_[a], shape_[b]);
+	std::swap(strides_[a], strides_[b]);
+}
+
+
+template<std::size_t Dim, std::size_t Arity>
+void strided_loop<Dim, Arity>::canonicalize() {
+	if(empty_) return;
+	
+	// drop unit axes, and reverse axes where first operand has negative stride
+	const operand_strides_type last_strides = strides_[dimension_ - 1];
+	std::ptrdiff_t n = 0;
+	for(std::ptrdiff_t i = 0; i < dimension_; ++i) {
+		if(shape_[i] == 1) continue;
+		if(strides_[i][0] < 0) for(std::ptrdiff_t k = 0; k < Arity; ++k) {
+			origin_[k] += strides_[i][k] * static_cast<std::ptrdiff_t>(shape_[i] - 1);
+			strides_[i][k] = -strides_[i][k];
+		}
+		shape_[n] = shape_[i];
+		strides_[n] = strides_[i];
+		++n;
+	}
+	if(n == 0) {
+		// single element
+		shape_[0] = 1;
+		strides_[0] = last_strides;
+		dimension_ = 1;
+		return;
+	}
+	dimension_ = n;
+	
+	// stable insertion sort, by descending stride of first operand
+	for(std::ptrdiff_t i = 1; i < dimension_; ++i)
+		for(std::ptrdiff_t j = i; j > 0 && strides_[j - 1][0] < strides_[j][0]; --j) swap_axes_(j - 1, j);
+	
+	merge_contiguous_axes_();
+}
+
+
+template<std::size_t Dim, std::size_t Arity>
+std::size_t strided_loop<Dim, Arity>::run_count() const {
+	if(empty_) return 0;
+	std::size_t count = 1;
+	for(std::ptrdiff_t i = 0; i < dimension_ - 1; ++i) count *= shape_[i];
+	return count;
+}
+
+
+template<std::size_t Dim, std::size_t Arity> template<typename Function>
+bool strided_loop<Dim, Arity>::run(Function&& fn) const {
+	if(empty_) return true;
+
+	offsets_type offsets = origin_;
+	std::array<std::size_t, Dim> counters;
+	counters.fill(0);
+
+	const std::ptrdiff_t outer_dim = dimension_ - 1;
+	for(;;) {
+		if(! invoke_run_function(fn, static_cast<const offsets_type&>(offsets))) return false;
+
+		// odometer increment on outer axes
+		std::ptrdiff_t i = outer_dim - 1;
+		for(; i >= 0; --i) {
+			if(++counters[i] < shape_[i]) {
+				for(std::ptrdiff_t k = 0; k < Arity; ++k) offsets[k] += strides_[i][k];
+				break;
+			}
+			counters[i] = 0;
+			for(std::ptrdiff_t k = 0; k < Arity; ++k)
+				offsets[k] -= strides_[i][k] * static_cast<std::ptrdiff_t>(shape_[i] - 1);
+		}
+		if(i < 0) return true;
+	}
+}
+
+}
+
+
+template<std::size_t Dim, typename T, typename Function>
+bool for_each_run(const ndarray_view<Dim, T>& vw, Function&& fn) {
+	detail::strided_loop<Dim, 1> loop(vw.shape(), {{ vw.strides() }});
+	loop.canonicalize();
+
+	const std::ptrdiff_t count = loop.run_length();
+	const std::ptrdiff_t stride = loop.run_strides()[0];
+	T* start = vw.start();
+	return loop.run([&](const auto& offsets) {
+		return detail::invoke_run_function(fn, advance_raw_ptr(start, offsets[0]), count, stride);
+	});
+}
+
+
+template<std::size_t Dim, typename T1, typename T2, typename Function>
+bool for_each_run(const ndarray_view<Dim, T1>& a, const ndarray_view<Dim, T2>& b, Function&& fn) {
+	Assert_crit(a.shape() == b.shape(), "ndarray_view must have same shape for paired traversal");
+	detail::strided_loop<Dim, 2> loop(a.shape(), {{ a.strides(), b.strides() }});
+	loop.canonicalize();
+
+	const std::ptrdiff_t count = loop.run_length();
+	const std::ptrdiff_t a_stride = loop.run_strides()[0];
+	const std::ptrdiff_t b_stride = loop.run_strides()[1];
+	T1* a_start = a.start();
+	T2* b_start = b.start();
+	return loop.run([&](const auto& offsets) {
+		return detail::invoke_run_function(
+			fn,
+			advance_raw_ptr(a_start, offsets[0]),
+			advance_raw_ptr(b_start, offsets[1]),
+			count,
+			a_stride,
+			b_stride
+		);
+	});
+}
+
+}
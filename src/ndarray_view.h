@@ -7,10 +7,15 @@
 #include "common.h"
 #include "ndcoord.h"
 #include "ndspan.h"
+#include "ndarray_order.h"
 #include "detail/ndarray_view_fcall.h"
 #include "pod_array_format.h"
+#include "pod_array_strided.h"
 #include "ndarray_iterator.h"
+#include "ndarray_traversal.h"
 #include "ndarray_traits.h"
+#include "execution.h"
+#include "instrumentation.h"
 
 
 namespace tlz {
@@ -27,6 +32,16 @@ namespace detail {
 	}
 
 	template<std::size_t Dim, typename Elem> struct ndarray_initializer_helper;
+	
+	/// Test if \a View can be converted to a plain `ndarray_view`, i.e. if it has a strided memory layout.
+	template<typename View>
+	using is_strided_ndarray_view = std::is_convertible<
+		View,
+		ndarray_view<View::dimension(), const std::remove_const_t<typename View::value_type>>
+	>;
+	
+	template<std::size_t Dim, typename T, typename Expr>
+	void evaluate_ndarray_expression(const ndarray_view<Dim, T>& vw, const Expr& expr);
 }
 
 
@@ -74,6 +89,7 @@ public:
 	using shape_type = ndsize<Dim>;
 	using strides_type = ndptrdiff<Dim>;
 	using span_type = ndspan<Dim>;
+	using order_type = ndarray_order<Dim>;
 	
 	using iterator = ndarray_iterator<ndarray_view<Dim, T>>;
 	using reverse_iterator = ndarray_iterator<ndarray_view<Dim, T>>;
@@ -92,8 +108,31 @@ private:
 	template<typename Other_view, typename U = void>
 	using enable_if_convertible_ = std::enable_if_t<is_convertible_ndarray_view<Other_view, ndarray_view>::value, U>;
 	
+	template<typename Expr, typename U = void>
+	using enable_if_expression_ = std::enable_if_t<is_ndarray_expression<Expr>::value, U>;
+	
 	using fcall_type = detail::ndarray_view_fcall<ndarray_view<Dim, T>, 1>;
 	
+	using wraparound_other_ = detail::wraparound_operand_constant<detail::wraparound_operand::other>;
+	using wraparound_none_ = detail::wraparound_operand_constant<detail::wraparound_operand::none>;
+	
+	template<typename Other_view> void assign_(const Other_view&, const pod_array_copy_policy&, wraparound_other_) const;
+	template<typename Other_view> void assign_(const Other_view&, const pod_array_copy_policy&, wraparound_none_) const;
+	template<typename Other_view> void assign_(const Other_view&, const pod_array_copy_policy&, std::true_type) const;
+	template<typename Other_view> void assign_(const Other_view&, const pod_array_copy_policy&, std::false_type) const;
+	template<typename Other_view> bool compare_(const Other_view&, wraparound_other_) const;
+	template<typename Other_view> bool compare_(const Other_view&, wraparound_none_) const;
+	template<typename Other_view> bool compare_(const Other_view&, std::true_type) const;
+	template<typename Other_view> bool compare_(const Other_view&, std::false_type) const;
+	
+	struct no_mutable_view_ { };
+	/// View to non-const `T` if `T` is const, otherwise unused type, so that the copy constructor stays defaulted.
+	using mutable_view_type_ = std::conditional_t<
+		std::is_const<T>::value,
+		ndarray_view<Dim, std::remove_const_t<T>>,
+		no_mutable_view_
+	>;
+	
 public:
 	/// \name Construction
 	///@{
@@ -106,9 +145,11 @@ public:
 	/// Create view with explicitly specified start and shape, with default strides (without padding).
 	ndarray_view(pointer start, const shape_type& shape);
 	
-	/// Copy-construct view.
-	/** Does not copy data. Can create `ndarray_view<const T>` from `ndarray_view<T>`. (But not the other way.) */
-	ndarray_view(const ndarray_view<Dim, std::remove_const_t<T>>& arr) :
+	/// Copy-construct view. Does not copy data.
+	ndarray_view(const ndarray_view&) = default;
+	
+	/// Create `ndarray_view<const T>` from `ndarray_view<T>`. (But not the other way.)
+	ndarray_view(const mutable_view_type_& arr) :
 		ndarray_view(arr.start(), arr.shape(), arr.strides()) { }
 	
 	static ndarray_view null() { return ndarray_view(); }
@@ -151,6 +192,24 @@ public:
 	/// Check if view has default strides without padding.
 	/** \param minimal_dimension Like in has_default_strides(). */
 	bool has_default_strides_without_padding(std::ptrdiff_t minimal_dimension = 0) const ;
+	
+	/// Default strides which correspond to storage \a order for specified shape.
+	/** Optionally with \a padding between elements. With row-major order, same as `default_strides(shape, padding)`. */
+	static strides_type default_strides(const shape_type&, const order_type& order, std::size_t elem_padding = 0);
+	
+	/// Check if view has default strides for storage \a order.
+	/** \a minimal_position refers to storage positions in \a order, instead of axes. */
+	bool has_default_strides(const order_type& order, std::ptrdiff_t minimal_position = 0) const;
+	
+	/// Returns padding of the view which has default strides for storage \a order.
+	std::size_t default_strides_padding(const order_type& order, std::ptrdiff_t minimal_position = 0) const;
+
+	/// Check if view has default strides without padding for storage \a order.
+	bool has_default_strides_without_padding(const order_type& order, std::ptrdiff_t minimal_position = 0) const;
+	
+	/// Storage order of the axes of the view, by decreasing stride.
+	/** If the view has default strides for some storage order, returns that order. */
+	order_type strides_order() const { return detail::strides_order(shape_, strides_); }
 	///@}	
 
 
@@ -158,15 +217,43 @@ public:
 	/// \name Deep assignment
 	///@{
 	template<typename Other_view>
-	enable_if_convertible_<Other_view> assign(const Other_view&) const;
+	enable_if_convertible_<Other_view> assign(const Other_view& other) const
+		{ assign(other, default_pod_array_copy_policy()); }
+	
+	/// Assign with explicit copy policy, used when elements get copied as POD data.
+	template<typename Other_view>
+	enable_if_convertible_<Other_view> assign(const Other_view&, const pod_array_copy_policy&) const;
 	
 	void assign(initializer_list_type) const;
 	
+	/// Assign sequentially in calling thread.
+	template<typename Other_view>
+	enable_if_convertible_<Other_view> assign(execution::sequenced_policy, const Other_view& other,
+		const pod_array_copy_policy& policy = default_pod_array_copy_policy()) const { assign(other, policy); }
+
+	/// Assign in parallel, partitioned into blocks along the outermost axis in memory of this view.
+	template<typename Other_view>
+	enable_if_convertible_<Other_view> assign(const execution::parallel_policy&, const Other_view&,
+		const pod_array_copy_policy& = default_pod_array_copy_policy()) const;
+	
+	/// Assign result of element-wise \ref ndarray_expression, evaluated in one pass.
+	template<typename Expr>
+	enable_if_expression_<Expr> assign(const Expr& expr) const {
+		static_assert(! std::is_const<value_type>::value, "cannot assign to const ndarray_view");
+		detail::evaluate_ndarray_expression(*this, expr);
+	}
+	
+	/// Assign result of element-wise \ref ndarray_expression, evaluated in parallel.
+	template<typename Expr>
+	enable_if_expression_<Expr> assign(const execution::parallel_policy&, const Expr&) const;
+	
 	template<typename Arg> const ndarray_view& operator=(Arg&& arg) const { assign(std::forward<Arg>(arg)); return *this; }
 	const ndarray_view& operator=(const ndarray_view& other) const { assign(other); return *this; }
 	const ndarray_view& operator=(initializer_list_type init) const { assign(init); return *this; }
 	
 	void fill(const value_type&) const;
+	void fill(execution::sequenced_policy, const value_type& val) const { fill(val); }
+	void fill(const execution::parallel_policy&, const value_type&) const;
 	///@}
 
 
@@ -177,6 +264,16 @@ public:
 	enable_if_convertible_<Other_view, bool> compare(const Other_view&) const;
 	// TODO initializer list compare
 	
+	template<typename Other_view>
+	enable_if_convertible_<Other_view, bool> compare(execution::sequenced_policy, const Other_view& other) const
+		{ return compare(other); }
+	
+	/// Compare in parallel, partitioned into blocks along the outermost axis in memory of this view.
+	/** Once a difference was found, blocks which have not yet started are skipped. Blocks which are already being
+	 ** compared still run to their end, i.e. there is no cancellation within a block. */
+	template<typename Other_view>
+	enable_if_convertible_<Other_view, bool> compare(const execution::parallel_policy&, const Other_view&) const;
+	
 	template<typename Arg> bool operator==(Arg&& arg) const { return compare(std::forward<Arg>(arg)); }
 	template<typename Arg> bool operator!=(Arg&& arg) const { return ! compare(std::forward<Arg>(arg)); }
 	///@}
@@ -253,8 +350,12 @@ public:
 		return std::is_pod<elem_type>::value && has_default_strides(Dim - Tail_dim);
 	}
 
+	/// Check if view elements form a POD array, with default strides in any storage order.
+	/** Unlike tail_has_pod_format(), also holds for column-major or otherwise permuted default strides. Two views with
+	 ** same pod_format() have the same memory layout only if they also have same shape and strides_order(). */
 	bool has_pod_format() const {
-		return tail_has_pod_format<Dim>();
+		using elem_type = std::remove_cv_t<value_type>;
+		return std::is_pod<elem_type>::value && has_default_strides(strides_order());
 	}
 
 	template<std::size_t Tail_dim>
@@ -267,7 +368,10 @@ public:
 	}
 	
 	pod_array_format pod_format() const {
-		return tail_pod_format<Dim>();
+		using elem_type = std::remove_cv_t<value_type>;
+		Assert(has_pod_format());
+		std::size_t stride = strides()[strides_order().innermost_axis()];
+		return make_pod_array_format<elem_type>(size(), stride);
 	}
 	///@}
 };
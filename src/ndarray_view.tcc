@@ -53,6 +53,36 @@ std::size_t ndarray_view<Dim, T>::default_strides_padding(std::ptrdiff_t minimal
 
 
 
+template<std::size_t Dim, typename T>
+auto ndarray_view<Dim, T>::default_strides(const shape_type& shape, const order_type& order, std::size_t padding)
+-> strides_type {
+	Assert(is_multiple_of(padding, alignof(T)));
+	return detail::ordered_default_strides(shape, order, sizeof(T) + padding);
+}
+
+
+template<std::size_t Dim, typename T>
+bool ndarray_view<Dim, T>::has_default_strides(const order_type& order, std::ptrdiff_t minimal_position) const {
+	return detail::has_ordered_default_strides(shape_, strides_, order, sizeof(T), minimal_position);
+}
+
+
+template<std::size_t Dim, typename T>
+std::size_t ndarray_view<Dim, T>::default_strides_padding(const order_type& order, std::ptrdiff_t minimal_position) const {
+	Assert(has_default_strides(order, minimal_position));
+	return (strides_[order.innermost_axis()] - sizeof(T));
+}
+
+
+template<std::size_t Dim, typename T>
+bool ndarray_view<Dim, T>::has_default_strides_without_padding(const order_type& order, std::ptrdiff_t minimal_position) const {
+	if(has_default_strides(order, minimal_position)) return (default_strides_padding(order, minimal_position) == 0);
+	else return false;
+}
+
+
+
+
 template<std::size_t Dim, typename T>
 ndarray_view<Dim, T>::ndarray_view(pointer start, const shape_type& shape) :
 	ndarray_view(start, shape, default_strides(shape)) { }
@@ -111,22 +141,90 @@ void ndarray_view<Dim, T>::reset(const ndarray_view& other) {
 
 
 template<std::size_t Dim, typename T> template<typename Other_view>
-auto ndarray_view<Dim, T>::assign(const Other_view& other) const -> enable_if_convertible_<Other_view> {
+auto ndarray_view<Dim, T>::assign(const Other_view& other, const pod_array_copy_policy& policy) const
+-> enable_if_convertible_<Other_view> {
 	static_assert(! std::is_const<value_type>::value, "cannot assign to const ndarray_view");
-	
+	Assert_crit(shape() == other.shape(), "ndarray_view must have same shape for assignment");
+	if(shape().product() == 0) return;
+	assign_(other, policy, detail::wraparound_operand_tag<ndarray_view, Other_view>());
+}
+
+
+template<std::size_t Dim, typename T> template<typename Other_view>
+void ndarray_view<Dim, T>::assign_(const Other_view& other, const pod_array_copy_policy& policy, wraparound_other_) const {
+	// assign each non-wrapping segment of other separately
+	TLZ_ND_INSTRUMENT(view_assign_segments, shape().product() * sizeof(value_type));
+	other.for_each_segment([&](const coordinates_type& seg_start, const auto& seg) {
+		section(seg_start, seg_start + coordinates_type(seg.shape())).assign(seg, policy);
+	});
+}
+
+
+template<std::size_t Dim, typename T> template<typename Other_view>
+void ndarray_view<Dim, T>::assign_(const Other_view& other, const pod_array_copy_policy& policy, wraparound_none_) const {
+	assign_(other, policy, detail::is_strided_ndarray_view<Other_view>());
+}
+
+
+template<std::size_t Dim, typename T> template<typename Other_view>
+void ndarray_view<Dim, T>::assign_(const Other_view& other, const pod_array_copy_policy& policy, std::true_type) const {
 	using elem_type = std::remove_cv_t<value_type>;
 	using other_elem_type = std::remove_cv_t<typename Other_view::value_type>;
-	if(std::is_same<elem_type, other_elem_type>::value && has_pod_format() && other.has_pod_format() && pod_format() == other.pod_format()) {
+	ndarray_view<Dim, const other_elem_type> other_vw = other;
+	
+	if(std::is_same<elem_type, other_elem_type>::value && std::is_pod<elem_type>::value) {
 		// optimize when possible
-		pod_array_copy(static_cast<void*>(start()), static_cast<const void*>(other.start()), pod_format());
+		TLZ_ND_INSTRUMENT(view_assign_pod, shape().product() * sizeof(elem_type));
+		pod_array_strided_copy(
+			static_cast<void*>(start()), strides(),
+			static_cast<const void*>(other_vw.start()), other_vw.strides(),
+			shape(), sizeof(elem_type),
+			policy
+		);
 	} else {
-		Assert_crit(shape() == other.shape(), "ndarray_view must have same shape for assignment");
-		if(shape().product() == 0) return;
-		std::copy(other.begin(), other.end(), begin());
+		TLZ_ND_INSTRUMENT(view_assign_runs, shape().product() * sizeof(elem_type));
+		for_each_run(*this, other_vw, [](pointer dst, const other_elem_type* src, std::ptrdiff_t n, std::ptrdiff_t dst_stride, std::ptrdiff_t src_stride) {
+			for(std::ptrdiff_t i = 0; i < n; ++i) {
+				*dst = *src;
+				dst = advance_raw_ptr(dst, dst_stride);
+				src = advance_raw_ptr(src, src_stride);
+			}
+		});
 	}
 }
 
 
+template<std::size_t Dim, typename T> template<typename Other_view>
+void ndarray_view<Dim, T>::assign_(const Other_view& other, const pod_array_copy_policy&, std::false_type) const {
+	TLZ_ND_INSTRUMENT(view_assign_iterator, shape().product() * sizeof(value_type));
+	std::copy(other.begin(), other.end(), begin());
+}
+
+
+template<std::size_t Dim, typename T> template<typename Other_view>
+auto ndarray_view<Dim, T>::assign(const execution::parallel_policy& exec, const Other_view& other, const pod_array_copy_policy& policy) const
+-> enable_if_convertible_<Other_view> {
+	static_assert(! std::is_const<value_type>::value, "cannot assign to const ndarray_view");
+	Assert_crit(shape() == other.shape(), "ndarray_view must have same shape for assignment");
+	if(shape().product() == 0) return;
+	detail::parallel_axis_blocks(exec, shape(), strides(), sizeof(value_type), [&](std::ptrdiff_t axis, std::ptrdiff_t start, std::ptrdiff_t end) {
+		axis_section(axis, start, end, 1).assign(other.axis_section(axis, start, end, 1), policy);
+	});
+}
+
+
+template<std::size_t Dim, typename T> template<typename Expr>
+auto ndarray_view<Dim, T>::assign(const execution::parallel_policy& exec, const Expr& expr) const
+-> enable_if_expression_<Expr> {
+	static_assert(! std::is_const<value_type>::value, "cannot assign to const ndarray_view");
+	Assert_crit(shape() == expr.shape(), "ndarray_view must have same shape as expression for assignment");
+	if(shape().product() == 0) return;
+	detail::parallel_axis_blocks(exec, shape(), strides(), sizeof(value_type), [&](std::ptrdiff_t axis, std::ptrdiff_t start, std::ptrdiff_t end) {
+		axis_section(axis, start, end, 1).assign(expr.axis_section(axis, start, end));
+	});
+}
+
+
 template<std::size_t Dim, typename T>
 void ndarray_view<Dim, T>::assign(initializer_list_type init) const {
 	Assert(initializer_helper_type::is_valid(init), "initializer_list must be valid");
@@ -138,7 +236,38 @@ void ndarray_view<Dim, T>::assign(initializer_list_type init) const {
 template<std::size_t Dim, typename T>
 void ndarray_view<Dim, T>::fill(const value_type& val) const {
 	static_assert(! std::is_const<value_type>::value, "cannot assign to const ndarray_view");
-	std::fill(begin(), end(), val);
+	for_each_run(*this, [&val](pointer dst, std::ptrdiff_t n, std::ptrdiff_t stride) {
+		for(std::ptrdiff_t i = 0; i < n; ++i) {
+			*dst = val;
+			dst = advance_raw_ptr(dst, stride);
+		}
+	});
+}
+
+
+template<std::size_t Dim, typename T>
+void ndarray_view<Dim, T>::fill(const execution::parallel_policy& exec, const value_type& val) const {
+	static_assert(! std::is_const<value_type>::value, "cannot assign to const ndarray_view");
+	if(shape().product() == 0) return;
+	detail::parallel_axis_blocks(exec, shape(), strides(), sizeof(value_type), [&](std::ptrdiff_t axis, std::ptrdiff_t start, std::ptrdiff_t end) {
+		axis_section(axis, start, end, 1).fill(val);
+	});
+}
+
+
+template<std::size_t Dim, typename T> template<typename Other_view>
+auto ndarray_view<Dim, T>::compare(const execution::parallel_policy& exec, const Other_view& other) const
+-> enable_if_convertible_<Other_view, bool> {
+	if(shape() != other.shape()) return false;
+	else if(shape().product() == 0) return true;
+	
+	std::atomic<bool> equal(true);
+	detail::parallel_axis_blocks(exec, shape(), strides(), sizeof(value_type), [&](std::ptrdiff_t axis, std::ptrdiff_t start, std::ptrdiff_t end) {
+		if(! equal.load(std::memory_order_relaxed)) return;
+		if(! axis_section(axis, start, end, 1).compare(other.axis_section(axis, start, end, 1)))
+			equal.store(false, std::memory_order_relaxed);
+	});
+	return equal.load();
 }
 
 
@@ -146,17 +275,60 @@ template<std::size_t Dim, typename T> template<typename Other_view>
 auto ndarray_view<Dim, T>::compare(const Other_view& other) const -> enable_if_convertible_<Other_view, bool> {
 	if(shape() != other.shape()) return false;
 	//else if(same(*this, other)) return true;
+	else if(shape().product() == 0) return true;
+	else return compare_(other, detail::wraparound_operand_tag<ndarray_view, Other_view>());
+}
+
+
+template<std::size_t Dim, typename T> template<typename Other_view>
+bool ndarray_view<Dim, T>::compare_(const Other_view& other, wraparound_other_) const {
+	TLZ_ND_INSTRUMENT(view_compare_segments, shape().product() * sizeof(value_type));
+	return other.for_each_segment([&](const coordinates_type& seg_start, const auto& seg) {
+		return section(seg_start, seg_start + coordinates_type(seg.shape())).compare(seg);
+	});
+}
+
+
+template<std::size_t Dim, typename T> template<typename Other_view>
+bool ndarray_view<Dim, T>::compare_(const Other_view& other, wraparound_none_) const {
+	return compare_(other, detail::is_strided_ndarray_view<Other_view>());
+}
+
 
+template<std::size_t Dim, typename T> template<typename Other_view>
+bool ndarray_view<Dim, T>::compare_(const Other_view& other, std::true_type) const {
 	using elem_type = std::remove_cv_t<value_type>;
 	using other_elem_type = std::remove_cv_t<typename Other_view::value_type>;
-	if(std::is_same<elem_type, other_elem_type>::value && has_pod_format() && other.has_pod_format() && pod_format() == other.pod_format()) {
-		return pod_array_compare(static_cast<const void*>(start()), static_cast<const void*>(other.start()), pod_format());
+	ndarray_view<Dim, const other_elem_type> other_vw = other;
+	
+	if(std::is_same<elem_type, other_elem_type>::value && std::is_pod<elem_type>::value) {
+		TLZ_ND_INSTRUMENT(view_compare_pod, shape().product() * sizeof(elem_type));
+		return pod_array_strided_compare(
+			static_cast<const void*>(start()), strides(),
+			static_cast<const void*>(other_vw.start()), other_vw.strides(),
+			shape(), sizeof(elem_type)
+		);
 	} else {
-		return std::equal(other.begin(), other.end(), begin());
+		TLZ_ND_INSTRUMENT(view_compare_runs, shape().product() * sizeof(elem_type));
+		return for_each_run(*this, other_vw, [](pointer a, const other_elem_type* b, std::ptrdiff_t n, std::ptrdiff_t a_stride, std::ptrdiff_t b_stride) {
+			for(std::ptrdiff_t i = 0; i < n; ++i) {
+				if(! (*b == *a)) return false;
+				a = advance_raw_ptr(a, a_stride);
+				b = advance_raw_ptr(b, b_stride);
+			}
+			return true;
+		});
 	}
 }
 
 
+template<std::size_t Dim, typename T> template<typename Other_view>
+bool ndarray_view<Dim, T>::compare_(const Other_view& other, std::false_type) const {
+	TLZ_ND_INSTRUMENT(view_compare_iterator, shape().product() * sizeof(value_type));
+	return std::equal(other.begin(), other.end(), begin());
+}
+
+
 template<std::size_t Dim, typename T>
 auto ndarray_view<Dim, T>::coordinates_to_pointer(const coordinates_type& coord) const -> pointer {
 	pointer ptr = start_;
@@ -1,6 +1,7 @@
 #ifndef TLZ_NDARRAY_VIEW_OPERATIONS_H_
 #define TLZ_NDARRAY_VIEW_OPERATIONS_H_
 
+#include <utility>
 #include "ndarray_view.h"
 
 namespace tlz {
@@ -14,6 +15,28 @@ ndarray_view<1 + Dim, T> add_front_axis(const ndarray_view<Dim, T>&);
 template<std::size_t Dim, typename T>
 ndarray_view<Dim + 1, T> add_back_axis(const ndarray_view<Dim, T>&);
 
+
+/// Shape to which shapes \a a and \a b broadcast, following _Numpy_ rules.
+/** Shapes are aligned at their last axis, and missing front axes have length 1. On each axis the lengths must be
+ ** equal, or one of them must be 1. */
+template<std::size_t Dim1, std::size_t Dim2>
+ndsize<(Dim1 > Dim2 ? Dim1 : Dim2)> broadcast_shape(const ndsize<Dim1>& a, const ndsize<Dim2>& b);
+
+/// Whether \a shape can be broadcast to \a target_shape.
+template<std::size_t Dim, std::size_t New_dim>
+bool is_broadcastable(const ndsize<Dim>& shape, const ndsize<New_dim>& target_shape);
+
+/// Broadcast \a vw to \a shape, following _Numpy_ rules.
+/** Front axes get prepended, and axes of length 1 get repeated, by giving them stride 0. The returned view refers to
+ ** the same elements multiple times, and so should not be written to. */
+template<std::size_t Dim, typename T, std::size_t New_dim>
+ndarray_view<New_dim, T> broadcast_to(const ndarray_view<Dim, T>& vw, const ndsize<New_dim>& shape);
+
+/// Broadcast \a a and \a b to their common shape.
+template<std::size_t Dim1, typename T1, std::size_t Dim2, typename T2>
+auto broadcast(const ndarray_view<Dim1, T1>& a, const ndarray_view<Dim2, T2>& b);
+
+
 template<std::size_t Dim, typename T>
 ndarray_view<Dim, T> swapaxis(const ndarray_view<Dim, T>&, std::ptrdiff_t axis1, std::ptrdiff_t axis2);
 
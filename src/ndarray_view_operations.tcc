@@ -12,13 +12,59 @@ ndarray_view<1 + Dim, T> add_front_axis(const ndarray_view<Dim, T>& vw) {
 
 
 template<std::size_t Dim, typename T>
-ndarray_view<Dim + 1, T> add_front_axis(const ndarray_view<Dim, T>& vw) {
+ndarray_view<Dim + 1, T> add_back_axis(const ndarray_view<Dim, T>& vw) {
 	auto new_shape = ndcoord_cat(vw.shape(), 1);
 	auto new_strides = ndcoord_cat(vw.strides(), 0);
 	return ndarray_view<Dim + 1, T>(vw.start(), new_shape, new_strides);
 }
 
 
+template<std::size_t Dim1, std::size_t Dim2>
+ndsize<(Dim1 > Dim2 ? Dim1 : Dim2)> broadcast_shape(const ndsize<Dim1>& a, const ndsize<Dim2>& b) {
+	constexpr std::ptrdiff_t dim = (Dim1 > Dim2 ? Dim1 : Dim2);
+	ndsize<dim> shape;
+	for(std::ptrdiff_t i = 0; i < dim; ++i) {
+		std::ptrdiff_t ia = i - (dim - Dim1), ib = i - (dim - Dim2);
+		std::size_t la = (ia >= 0 ? a[ia] : 1), lb = (ib >= 0 ? b[ib] : 1);
+		Assert_crit(la == lb || la == 1 || lb == 1, "shapes cannot be broadcast together");
+		shape[i] = (la == 1 ? lb : la);
+	}
+	return shape;
+}
+
+
+template<std::size_t Dim, std::size_t New_dim>
+bool is_broadcastable(const ndsize<Dim>& shape, const ndsize<New_dim>& target_shape) {
+	if(Dim > New_dim) return false;
+	for(std::ptrdiff_t i = 0; i < Dim; ++i) {
+		std::size_t l = shape[i], target_l = target_shape[i + (New_dim - Dim)];
+		if(l != target_l && l != 1) return false;
+	}
+	return true;
+}
+
+
+template<std::size_t Dim, typename T, std::size_t New_dim>
+ndarray_view<New_dim, T> broadcast_to(const ndarray_view<Dim, T>& vw, const ndsize<New_dim>& shape) {
+	static_assert(New_dim >= Dim, "cannot broadcast ndarray_view to lower dimension");
+	Assert_crit(is_broadcastable(vw.shape(), shape), "ndarray_view cannot be broadcast to shape");
+	ndptrdiff<New_dim> strides;
+	for(std::ptrdiff_t i = 0; i < New_dim; ++i) {
+		std::ptrdiff_t j = i - (New_dim - Dim);
+		if(j >= 0 && vw.shape()[j] == shape[i]) strides[i] = vw.strides()[j];
+		else strides[i] = 0;
+	}
+	return ndarray_view<New_dim, T>(vw.start(), shape, strides);
+}
+
+
+template<std::size_t Dim1, typename T1, std::size_t Dim2, typename T2>
+auto broadcast(const ndarray_view<Dim1, T1>& a, const ndarray_view<Dim2, T2>& b) {
+	auto shape = broadcast_shape(a.shape(), b.shape());
+	return std::make_pair(broadcast_to(a, shape), broadcast_to(b, shape));
+}
+
+
 template<std::size_t Dim, typename T>
 ndarray_view<Dim, T> swapaxis(const ndarray_view<Dim, T>& vw, std::ptrdiff_t axis1, std::ptrdiff_t axis2) {
 	Assert_crit(axis1 >= 0 && axis1 < vw.dimension());
@@ -9,6 +9,7 @@
 #include "ndarray_iterator.h"
 #include "ndarray_traits.h"
 #include "ndarray_view.h"
+#include "instrumentation.h"
 #include <utility>
 
 namespace tlz {
@@ -28,6 +29,11 @@ namespace detail {
 	}
 
 	template<std::size_t Dim, typename Elem> struct ndarray_initializer_helper;
+	
+	/// Number of elements, at most \a n, reachable from \a pos with \a stride without wrapping around.
+	/** \a pos is the offset in `[0, circumference)`, or in `(circumference, 0]` if \a circumference is negative. */
+	std::ptrdiff_t wraparound_segment_length
+		(std::ptrdiff_t pos, std::ptrdiff_t stride, std::ptrdiff_t circumference, std::ptrdiff_t n);
 }
 
 
@@ -44,6 +50,7 @@ public:
 	using typename base::shape_type;
 	using typename base::strides_type;
 	using typename base::span_type;
+	using typename base::order_type;
 	
 	using iterator = ndarray_iterator<ndarray_wraparound_view<Dim, T>>;
 	using reverse_iterator = ndarray_iterator<ndarray_wraparound_view<Dim, T>>;
@@ -62,6 +69,29 @@ private:
 	using enable_if_convertible_ = std::enable_if_t<is_convertible_ndarray_view<Other_view, ndarray_wraparound_view>::value, U>;
 	
 	using fcall_type = detail::ndarray_view_fcall<ndarray_wraparound_view<Dim, T>, 1>;
+	
+	using wraparound_other_ = detail::wraparound_operand_constant<detail::wraparound_operand::other>;
+	using wraparound_self_ = detail::wraparound_operand_constant<detail::wraparound_operand::self>;
+	
+	template<typename Other_view> void assign_(const Other_view&, const pod_array_copy_policy&, wraparound_other_) const;
+	template<typename Other_view> void assign_(const Other_view&, const pod_array_copy_policy&, wraparound_self_) const;
+	template<typename Other_view> void assign_(const Other_view&, const pod_array_copy_policy&, std::true_type) const;
+	template<typename Other_view> void assign_(const Other_view&, const pod_array_copy_policy&, std::false_type) const;
+	template<typename Other_view> bool compare_(const Other_view&, wraparound_other_) const;
+	template<typename Other_view> bool compare_(const Other_view&, wraparound_self_) const;
+	template<typename Other_view> bool compare_(const Other_view&, std::true_type) const;
+	template<typename Other_view> bool compare_(const Other_view&, std::false_type) const;
+	
+	struct no_mutable_view_ { };
+	/// View to non-const `T` if `T` is const, otherwise unused type, so that the copy constructor stays defaulted.
+	using mutable_view_type_ = std::conditional_t<
+		std::is_const<T>::value,
+		ndarray_wraparound_view<Dim, std::remove_const_t<T>>,
+		no_mutable_view_
+	>;
+	
+	template<typename Function>
+	bool for_each_segment_(std::ptrdiff_t axis, coordinates_type& seg_start, shape_type& seg_shape, std::ptrdiff_t offset, Function& fn) const;
 
 public:
 	/// \name Construction
@@ -78,7 +108,10 @@ public:
 	
 	ndarray_wraparound_view(const ndarray_view<Dim, std::remove_const_t<T>>&);
 	
-	ndarray_wraparound_view(const ndarray_wraparound_view<Dim, std::remove_const_t<T>>&);
+	ndarray_wraparound_view(const ndarray_wraparound_view&) = default;
+	
+	/// Create view to `const T` from view to `T`.
+	ndarray_wraparound_view(const mutable_view_type_&);
 	
 	static ndarray_wraparound_view null() { return ndarray_wraparound_view(); }
 	
@@ -108,16 +141,23 @@ public:
 	using base::has_default_strides;
 	using base::default_strides_padding;
 	using base::has_default_strides_without_padding;
+	using base::strides_order;
 	///@}
 	
 	
 	/// \name Deep assignment
 	///@{
 	template<typename Other_view>
-	enable_if_convertible_<Other_view> assign(const Other_view &) const;
+	enable_if_convertible_<Other_view> assign(const Other_view& other) const
+		{ assign(other, default_pod_array_copy_policy()); }
+	
+	template<typename Other_view>
+	enable_if_convertible_<Other_view> assign(const Other_view&, const pod_array_copy_policy&) const;
 	
 	void assign(initializer_list_type) const;
 	
+	void fill(const value_type&) const;
+	
 	template<typename Arg>
 	const ndarray_wraparound_view& operator=(Arg &&arg) const { assign(std::forward<Arg>(arg)); return *this; }
 	const ndarray_wraparound_view& operator=(const ndarray_wraparound_view &other) const { assign(other); return *this; }
@@ -142,7 +182,7 @@ public:
 	///@{
 	static reference dereference(pointer ptr) { return *ptr; }
 
-	std::ptrdiff_t contiguous_length() const { return 1; }
+	std::ptrdiff_t contiguous_length() const;
 	
 	iterator begin() const;
 	iterator end() const;
@@ -188,12 +228,26 @@ public:
 		return *this;
 	}
 	///@}
+	
+	
+	/// \name Segments
+	///@{
+	/// Call \a fn for each non-wrapping segment of the view.
+	/** The view gets partitioned into blocks which are ordinary \ref ndarray_view, by cutting each axis where it wraps
+	 ** around. `fn(const coordinates_type& start, const ndarray_view<Dim, T>& segment)` receives the coordinates of
+	 ** the segment's first element in this view, and the segment. If each axis wraps at most once, there are at most
+	 ** `2^Dim` segments. If `fn` returns `bool`, stops when it returns `false`, and then returns `false`. */
+	template<typename Function> bool for_each_segment(Function&& fn) const;
+	///@}
 };
 
 
 template<std::size_t Dim, typename T>
 struct is_ndarray_view<ndarray_wraparound_view<Dim, T>> : std::true_type {};
 
+template<std::size_t Dim, typename T>
+struct is_ndarray_wraparound_view<ndarray_wraparound_view<Dim, T>> : std::true_type {};
+
 
 
 template<std::size_t Dim, typename T>
@@ -211,7 +265,11 @@ bool same(const ndarray_wraparound_view<Dim, T1>&, const ndarray_wraparound_view
 
 template<std::size_t Dim, typename T>
 bool axis_wraparound(const ndarray_wraparound_view<Dim, T>& vw, std::ptrdiff_t axis) {
-	return (vw.wrap_circumferences()[axis] - vw.wrap_offsets()[axis]) < vw.shape()[axis] * vw.strides()[axis];
+	std::ptrdiff_t circumference = vw.wrap_circumferences()[axis];
+	if(circumference == 0) return false;
+	std::ptrdiff_t pos = positive_modulo(vw.wrap_offsets()[axis], circumference);
+	std::ptrdiff_t n = vw.shape()[axis];
+	return (detail::wraparound_segment_length(pos, vw.strides()[axis], circumference, n) < n);
 }
 
 
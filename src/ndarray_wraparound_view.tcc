@@ -1,7 +1,28 @@
 #include "common.h"
+#include <algorithm>
 
 namespace tlz {
 
+namespace detail {
+
+inline std::ptrdiff_t wraparound_segment_length
+(std::ptrdiff_t pos, std::ptrdiff_t stride, std::ptrdiff_t circumference, std::ptrdiff_t n) {
+	if(circumference < 0) {
+		// mirror, for views with negative strides in underlying view
+		pos = -pos;
+		stride = -stride;
+		circumference = -circumference;
+	}
+	std::ptrdiff_t len;
+	if(stride > 0) len = 1 + (circumference - 1 - pos) / stride;
+	else if(stride < 0) len = 1 + pos / -stride;
+	else len = n;
+	return std::min(len, n);
+}
+
+}
+
+
 template<std::size_t Dim, typename T>
 ndarray_wraparound_view<Dim, T> wraparound(
 	const ndarray_view<Dim, T>& vw,
@@ -76,7 +97,7 @@ ndarray_wraparound_view<Dim, T>::ndarray_wraparound_view(
 
 template<std::size_t Dim, typename T>
 ndarray_wraparound_view<Dim, T>::ndarray_wraparound_view
-(const ndarray_wraparound_view<Dim, std::remove_const_t<T>>& vw) :
+(const mutable_view_type_& vw) :
 	base(vw.non_wraparound()),
 	wrap_offsets_(vw.wrap_offsets()),
 	wrap_circumferences_(vw.wrap_circumferences()) { }
@@ -87,7 +108,7 @@ ndarray_wraparound_view<Dim, T>::ndarray_wraparound_view
 (const ndarray_view<Dim, std::remove_const_t<T>>& vw) :
 	base(vw),
 	wrap_offsets_(0),
-	wrap_circumferences_(vw.shape() * vw.strides()) { }
+	wrap_circumferences_(strides_type(vw.shape()) * vw.strides()) { }
 
 
 template<std::size_t Dim, typename T>
@@ -99,9 +120,42 @@ void ndarray_wraparound_view<Dim, T>::reset(const ndarray_wraparound_view& vw) {
 
 
 template<std::size_t Dim, typename T> template<typename Other_view>
-auto ndarray_wraparound_view<Dim, T>::assign(const Other_view& other) const -> enable_if_convertible_<Other_view> {
+auto ndarray_wraparound_view<Dim, T>::assign(const Other_view& other, const pod_array_copy_policy& policy) const
+-> enable_if_convertible_<Other_view> {
 	Assert_crit(shape() == other.shape(), "ndarray_view must have same shape for assignment");
 	if(shape().product() == 0) return;
+	assign_(other, policy, detail::wraparound_operand_tag<ndarray_wraparound_view, Other_view>());
+}
+
+
+template<std::size_t Dim, typename T> template<typename Other_view>
+void ndarray_wraparound_view<Dim, T>::assign_(const Other_view& other, const pod_array_copy_policy& policy, wraparound_other_) const {
+	TLZ_ND_INSTRUMENT(wraparound_assign_segments, shape().product() * sizeof(value_type));
+	other.for_each_segment([&](const coordinates_type& seg_start, const auto& seg) {
+		section(seg_start, seg_start + coordinates_type(seg.shape())).assign(seg, policy);
+	});
+}
+
+
+template<std::size_t Dim, typename T> template<typename Other_view>
+void ndarray_wraparound_view<Dim, T>::assign_(const Other_view& other, const pod_array_copy_policy& policy, wraparound_self_) const {
+	assign_(other, policy, detail::is_strided_ndarray_view<Other_view>());
+}
+
+
+template<std::size_t Dim, typename T> template<typename Other_view>
+void ndarray_wraparound_view<Dim, T>::assign_(const Other_view& other, const pod_array_copy_policy& policy, std::true_type) const {
+	ndarray_view<Dim, const std::remove_const_t<typename Other_view::value_type>> other_vw = other;
+	TLZ_ND_INSTRUMENT(wraparound_assign_segments, shape().product() * sizeof(value_type));
+	for_each_segment([&](const coordinates_type& seg_start, const base& seg) {
+		seg.assign(other_vw.section(seg_start, seg_start + coordinates_type(seg.shape())), policy);
+	});
+}
+
+
+template<std::size_t Dim, typename T> template<typename Other_view>
+void ndarray_wraparound_view<Dim, T>::assign_(const Other_view& other, const pod_array_copy_policy&, std::false_type) const {
+	TLZ_ND_INSTRUMENT(wraparound_assign_iterator, shape().product() * sizeof(value_type));
 	std::copy(other.begin(), other.end(), begin());
 }
 
@@ -114,10 +168,105 @@ void ndarray_wraparound_view<Dim, T>::assign(initializer_list_type init) const {
 }
 
 
+template<std::size_t Dim, typename T>
+void ndarray_wraparound_view<Dim, T>::fill(const value_type& val) const {
+	for_each_segment([&val](const coordinates_type&, const base& seg) {
+		seg.fill(val);
+	});
+}
+
+
 template<std::size_t Dim, typename T> template<typename Other_view>
 auto ndarray_wraparound_view<Dim, T>::compare(const Other_view& other) const -> enable_if_convertible_<Other_view, bool> {
 	if(shape() != other.shape()) return false;
-	else return std::equal(other.begin(), other.end(), begin());
+	else if(shape().product() == 0) return true;
+	else return compare_(other, detail::wraparound_operand_tag<ndarray_wraparound_view, Other_view>());
+}
+
+
+template<std::size_t Dim, typename T> template<typename Other_view>
+bool ndarray_wraparound_view<Dim, T>::compare_(const Other_view& other, wraparound_other_) const {
+	TLZ_ND_INSTRUMENT(wraparound_compare_segments, shape().product() * sizeof(value_type));
+	return other.for_each_segment([&](const coordinates_type& seg_start, const auto& seg) {
+		return section(seg_start, seg_start + coordinates_type(seg.shape())).compare(seg);
+	});
+}
+
+
+template<std::size_t Dim, typename T> template<typename Other_view>
+bool ndarray_wraparound_view<Dim, T>::compare_(const Other_view& other, wraparound_self_) const {
+	return compare_(other, detail::is_strided_ndarray_view<Other_view>());
+}
+
+
+template<std::size_t Dim, typename T> template<typename Other_view>
+bool ndarray_wraparound_view<Dim, T>::compare_(const Other_view& other, std::true_type) const {
+	ndarray_view<Dim, const std::remove_const_t<typename Other_view::value_type>> other_vw = other;
+	TLZ_ND_INSTRUMENT(wraparound_compare_segments, shape().product() * sizeof(value_type));
+	return for_each_segment([&](const coordinates_type& seg_start, const base& seg) {
+		return seg.compare(other_vw.section(seg_start, seg_start + coordinates_type(seg.shape())));
+	});
+}
+
+
+template<std::size_t Dim, typename T> template<typename Other_view>
+bool ndarray_wraparound_view<Dim, T>::compare_(const Other_view& other, std::false_type) const {
+	TLZ_ND_INSTRUMENT(wraparound_compare_iterator, shape().product() * sizeof(value_type));
+	return std::equal(other.begin(), other.end(), begin());
+}
+
+
+template<std::size_t Dim, typename T> template<typename Function>
+bool ndarray_wraparound_view<Dim, T>::for_each_segment(Function&& fn) const {
+	if(shape().product() == 0) return true;
+	coordinates_type seg_start;
+	shape_type seg_shape;
+	return for_each_segment_(0, seg_start, seg_shape, 0, fn);
+}
+
+
+template<std::size_t Dim, typename T> template<typename Function>
+bool ndarray_wraparound_view<Dim, T>::for_each_segment_
+(std::ptrdiff_t axis, coordinates_type& seg_start, shape_type& seg_shape, std::ptrdiff_t offset, Function& fn) const {
+	if(axis == Dim) {
+		base seg(advance_raw_ptr(start(), offset), seg_shape, strides());
+		return detail::invoke_run_function(fn, static_cast<const coordinates_type&>(seg_start), static_cast<const base&>(seg));
+	}
+	
+	const std::ptrdiff_t n = shape()[axis];
+	const std::ptrdiff_t stride = strides()[axis];
+	const std::ptrdiff_t wrap_offset = wrap_offsets_[axis];
+	const std::ptrdiff_t circumference = wrap_circumferences_[axis];
+	for(std::ptrdiff_t c = 0; c < n;) {
+		// pos = offset of element c in underlying view, the segment ends where it wraps around
+		std::ptrdiff_t pos, len;
+		if(circumference != 0) {
+			pos = positive_modulo(wrap_offset + stride * c, circumference);
+			len = detail::wraparound_segment_length(pos, stride, circumference, n - c);
+		} else {
+			pos = wrap_offset + stride * c;
+			len = n - c;
+		}
+		seg_start[axis] = c;
+		seg_shape[axis] = len;
+		if(! for_each_segment_(axis + 1, seg_start, seg_shape, offset + pos - wrap_offset, fn)) return false;
+		c += len;
+	}
+	return true;
+}
+
+
+template<std::size_t Dim, typename T>
+std::ptrdiff_t ndarray_wraparound_view<Dim, T>::contiguous_length() const {
+	// like ndarray_view::contiguous_length(), but only on axes which do not wrap around
+	if(axis_wraparound(*this, Dim - 1)) return 1;
+	std::ptrdiff_t contiguous_len = shape().back();
+	for(std::ptrdiff_t i = Dim - 1; i > 0; i--) {
+		bool contiguous = (strides()[i - 1] == shape()[i] * strides()[i]);
+		if(contiguous && ! axis_wraparound(*this, i - 1)) contiguous_len *= shape()[i - 1];
+		else break;
+	}
+	return contiguous_len;
 }
 
 
@@ -242,7 +391,7 @@ ndarray_wraparound_view<Dim, T> swapaxis(const ndarray_wraparound_view<Dim, T>&
 	auto new_strides = vw.strides(); std::swap(new_strides[axis1], new_strides[axis2]);
 	auto new_shape = vw.shape(); std::swap(new_shape[axis1], new_shape[axis2]);
 	auto new_wrap_offsets = vw.wrap_offsets(); std::swap(new_wrap_offsets[axis1], new_wrap_offsets[axis2]);
-	auto new_wrap_circumferences = vw.wrap_offsets(); std::swap(new_wrap_circumferences[axis1], new_wrap_circumferences[axis2]);
+	auto new_wrap_circumferences = vw.wrap_circumferences(); std::swap(new_wrap_circumferences[axis1], new_wrap_circumferences[axis2]);
 	return ndarray_wraparound_view<Dim, T>(vw.start(), new_shape, new_strides, new_wrap_offsets, new_wrap_circumferences);
 }
 
@@ -0,0 +1,163 @@
+#ifndef TLZ_ND_BROADCAST_RING_BUFFER_H_
+#define TLZ_ND_BROADCAST_RING_BUFFER_H_
+
+#include "../config.h"
+#if TLZ_ND_WITH_ALLOCATION && TLZ_ND_WITH_OPAQUE && TLZ_ND_WITH_WRAPAROUND
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include "../common.h"
+#include "../detail/ring_wait.h"
+#include "ndarray_opaque.h"
+#include "spsc_ring_buffer.h"
+
+namespace tlz {
+
+/// What the writer of a \ref broadcast_ring_buffer does when the slowest reader lags a full ring behind.
+enum class ring_overflow_policy {
+	block, ///< Writer waits until all readers have read the frames it would overwrite.
+	drop ///< Writer overwrites the frames. Lagging readers skip the lost frames.
+};
+
+
+/// Ring buffer of opaque frames with one writer and multiple readers, which each read all frames.
+/** Each reader has its own atomic read cursor, and reads the frames at its own rate, with zero-copy sections into the
+ ** same buffer. Readers are registered with add_reader(), up to the maximal number given at construction, and start at
+ ** the current write time. Sections are like those of \ref spsc_ring_buffer, with the absolute time span.
+ **
+ ** With ring_overflow_policy::block, the writer can write up to the slowest reader plus the capacity, so the slowest
+ ** reader applies back-pressure. With ring_overflow_policy::drop, the writer never waits. A reader which lags more than
+ ** the capacity behind skips to the oldest frame still in the buffer in begin_read(), and the skipped frames are
+ ** counted in dropped_frames(). Because frames may also get overwritten while a reader is reading them, end_read()
+ ** then returns whether the section was still intact, and the reader should discard its results otherwise.
+ **
+ ** The writer and each reader must each be used by one thread at a time. Frames are constructed when the ring buffer
+ ** is created, and reader state is allocated then too, so that the operations make no allocations and take no locks. */
+template<typename Frame_format, typename Allocator = raw_allocator>
+class broadcast_ring_buffer {
+public:
+	using frame_format_type = Frame_format;
+	using buffer_type = ndarray_opaque<1, Frame_format, Allocator>;
+	using write_section_type = ring_buffer_section<true, Frame_format>;
+	using read_section_type = ring_buffer_section<false, Frame_format>;
+	using reader_id = std::size_t;
+
+private:
+	struct alignas(64) reader_state {
+		std::atomic<bool> claimed {false}; ///< Slot is used by a reader.
+		std::atomic<bool> active {false}; ///< Reader cursor is initialized, and taken into account by writer.
+		std::atomic<time_unit> read_time {0};
+		std::atomic<std::size_t> dropped {0};
+		time_unit cached_write_time = 0; ///< Cached value of write_time_, used by reader thread.
+		std::size_t read_length = 0; ///< Length of section from last begin_read().
+	};
+
+	buffer_type buffer_;
+	std::size_t capacity_;
+	ring_overflow_policy overflow_policy_;
+	ring_wait_strategy wait_strategy_;
+	std::size_t max_readers_;
+	std::unique_ptr<unsigned char[]> readers_storage_; ///< Over-allocated, because `new` ignores alignment in C++14.
+	reader_state* readers_; ///< Cache line aligned array in readers_storage_.
+
+	alignas(64) std::atomic<time_unit> write_time_ {0}; ///< Time of next frame to write. Earlier frames are readable.
+	std::atomic<time_unit> write_reserved_time_ {0}; ///< End of section from last begin_write(), may be overwritten.
+	std::atomic<bool> closed_ {false};
+	detail::ring_wait_event readable_event_;
+	detail::ring_wait_event writable_event_;
+
+	// state of the writer thread
+	alignas(64) time_unit writer_min_read_time_ = 0; ///< Cached slowest read time.
+	std::size_t write_length_ = 0; ///< Length of section from last begin_write().
+
+	reader_state& reader_(reader_id id) const;
+	bool can_write_(std::size_t n);
+	bool can_read_(reader_state& rd, std::size_t n);
+	void skip_dropped_(reader_state& rd); ///< With ring_overflow_policy::drop, skip overwritten frames.
+	write_section_type write_section_(std::size_t n);
+	read_section_type read_section_(reader_state& rd, std::size_t n);
+
+public:
+	/// Create ring buffer for \a capacity frames of format \a frm, for up to \a max_readers readers.
+	broadcast_ring_buffer(const frame_format_type& frm, std::size_t capacity, std::size_t max_readers,
+		ring_overflow_policy = ring_overflow_policy::block, const ring_wait_strategy& = ring_wait_strategy(),
+		const Allocator& = Allocator());
+
+	broadcast_ring_buffer(const broadcast_ring_buffer&) = delete;
+	broadcast_ring_buffer& operator=(const broadcast_ring_buffer&) = delete;
+
+	std::size_t capacity() const { return capacity_; }
+	std::size_t max_readers() const { return max_readers_; }
+	ring_overflow_policy overflow_policy() const { return overflow_policy_; }
+	const frame_format_type& frame_format() const { return buffer_.frame_format(); }
+	const ring_wait_strategy& wait_strategy() const { return wait_strategy_; }
+
+	/// Time of the next frame to be written.
+	time_unit write_time() const { return write_time_.load(std::memory_order_acquire); }
+
+	/// Read time of the slowest active reader, or write_time() if there are no readers.
+	time_unit slowest_read_time() const;
+
+
+	/// \name Writer
+	///@{
+	/// Number of frames which can currently be written without overwriting unread frames.
+	std::size_t writable_frames() const { return capacity_ - (write_time() - slowest_read_time()); }
+
+	/// Get section of \a n frames to write to, or null section if less than \a n frames are writable.
+	/** With ring_overflow_policy::drop, always succeeds. */
+	write_section_type try_begin_write(std::size_t n);
+
+	/// Get section of \a n frames to write to, waiting until they are writable.
+	write_section_type begin_write(std::size_t n);
+
+	/// Make the first \a n frames of the section from the last begin_write() readable.
+	void end_write(std::size_t n);
+
+	/// Mark end of stream. Readers can read the remaining frames, and then stop waiting.
+	void close();
+
+	bool closed() const { return closed_.load(std::memory_order_acquire); }
+	///@}
+
+
+	/// \name Readers
+	///@{
+	/// Register new reader, which starts reading at the current write time.
+	/** Can be called concurrently with the writer and other readers. Throws if max_readers() are already registered. */
+	reader_id add_reader();
+
+	/// Unregister reader \a id. Its slot can be reused by add_reader().
+	void remove_reader(reader_id id);
+
+	/// Time of next frame to be read by reader \a id.
+	time_unit read_time(reader_id id) const { return reader_(id).read_time.load(std::memory_order_acquire); }
+
+	/// Number of frames which can currently be read by reader \a id.
+	std::size_t readable_frames(reader_id id) const { return write_time() - read_time(id); }
+
+	/// Number of frames that reader \a id skipped because they were overwritten.
+	std::size_t dropped_frames(reader_id id) const { return reader_(id).dropped.load(std::memory_order_relaxed); }
+
+	/// Get section of \a n frames for reader \a id, or null section if less than \a n frames are readable.
+	read_section_type try_begin_read(reader_id id, std::size_t n);
+
+	/// Get section of \a n frames for reader \a id, waiting until they are readable.
+	/** If the ring buffer is closed, returns the remaining readable frames, which can be less than \a n, and a null
+	 ** section if there are none. */
+	read_section_type begin_read(reader_id id, std::size_t n);
+
+	/// Advance reader \a id by the first \a n frames of the section from its last begin_read().
+	/** Returns false if the section may have been overwritten by the writer while it was being read, which can happen
+	 ** only with ring_overflow_policy::drop. */
+	bool end_read(reader_id id, std::size_t n);
+	///@}
+};
+
+}
+
+#include "broadcast_ring_buffer.tcc"
+
+#endif
+#endif
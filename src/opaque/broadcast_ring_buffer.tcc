@@ -0,0 +1,228 @@
+#include <algorithm>
+#include <memory>
+#include <new>
+#include <type_traits>
+
+namespace tlz {
+
+template<typename Frame_format, typename Allocator>
+broadcast_ring_buffer<Frame_format, Allocator>::broadcast_ring_buffer(
+	const frame_format_type& frm,
+	std::size_t capacity,
+	std::size_t max_readers,
+	ring_overflow_policy policy,
+	const ring_wait_strategy& strategy,
+	const Allocator& allocator
+) :
+	buffer_(make_ndsize(capacity), frm, 0, allocator),
+	capacity_(capacity),
+	overflow_policy_(policy),
+	wait_strategy_(strategy),
+	max_readers_(max_readers),
+	readers_storage_(new unsigned char[(max_readers + 1) * sizeof(reader_state)])
+{
+	Assert(capacity > 0, "ring buffer capacity must be non-zero");
+	static_assert(std::is_trivially_destructible<reader_state>::value, "reader_state must be trivially destructible");
+	void* ptr = readers_storage_.get();
+	std::size_t space = (max_readers + 1) * sizeof(reader_state);
+	ptr = std::align(alignof(reader_state), max_readers * sizeof(reader_state), ptr, space);
+	readers_ = static_cast<reader_state*>(ptr);
+	for(std::size_t i = 0; i < max_readers; ++i) new (readers_ + i) reader_state;
+}
+
+
+template<typename Frame_format, typename Allocator>
+auto broadcast_ring_buffer<Frame_format, Allocator>::reader_(reader_id id) const -> reader_state& {
+	Assert_crit(id < max_readers_, "invalid ring buffer reader id");
+	return readers_[id];
+}
+
+
+template<typename Frame_format, typename Allocator>
+time_unit broadcast_ring_buffer<Frame_format, Allocator>::slowest_read_time() const {
+	time_unit min_read_time = write_time_.load(std::memory_order_acquire);
+	for(std::size_t i = 0; i < max_readers_; ++i) {
+		const reader_state& rd = readers_[i];
+		if(rd.active.load(std::memory_order_acquire))
+			min_read_time = std::min(min_read_time, rd.read_time.load(std::memory_order_acquire));
+	}
+	return min_read_time;
+}
+
+
+template<typename Frame_format, typename Allocator>
+bool broadcast_ring_buffer<Frame_format, Allocator>::can_write_(std::size_t n) {
+	if(overflow_policy_ == ring_overflow_policy::drop) return true;
+	time_unit write_time = write_time_.load(std::memory_order_relaxed);
+	if(write_time + n <= writer_min_read_time_ + capacity_) return true;
+	writer_min_read_time_ = slowest_read_time();
+	return (write_time + n <= writer_min_read_time_ + capacity_);
+}
+
+
+template<typename Frame_format, typename Allocator>
+auto broadcast_ring_buffer<Frame_format, Allocator>::write_section_(std::size_t n) -> write_section_type {
+	time_unit start_time = write_time_.load(std::memory_order_relaxed);
+	write_length_ = n;
+	if(n == 0) return write_section_type(write_section_type::view_type::null(), start_time);
+
+	// announce the frames that get overwritten before writing them, for validation in end_read()
+	write_reserved_time_.store(start_time + n, std::memory_order_relaxed);
+	std::atomic_thread_fence(std::memory_order_seq_cst);
+
+	std::ptrdiff_t start = start_time % capacity_;
+	return write_section_type(wraparound(buffer_.view(), make_ndptrdiff(start), make_ndptrdiff(start + n)), start_time);
+}
+
+
+template<typename Frame_format, typename Allocator>
+auto broadcast_ring_buffer<Frame_format, Allocator>::try_begin_write(std::size_t n) -> write_section_type {
+	Assert(n <= capacity_, "cannot write more frames than ring buffer capacity");
+	if(! can_write_(n)) return write_section_type();
+	return write_section_(n);
+}
+
+
+template<typename Frame_format, typename Allocator>
+auto broadcast_ring_buffer<Frame_format, Allocator>::begin_write(std::size_t n) -> write_section_type {
+	Assert(n <= capacity_, "cannot write more frames than ring buffer capacity");
+	if(! can_write_(n)) writable_event_.wait(wait_strategy_, [this, n] { return can_write_(n); });
+	return write_section_(n);
+}
+
+
+template<typename Frame_format, typename Allocator>
+void broadcast_ring_buffer<Frame_format, Allocator>::end_write(std::size_t n) {
+	Assert(n <= write_length_, "cannot end write of more frames than begun");
+	write_length_ = 0;
+	if(n == 0) return;
+	write_time_.store(write_time_.load(std::memory_order_relaxed) + n, std::memory_order_release);
+	readable_event_.signal();
+}
+
+
+template<typename Frame_format, typename Allocator>
+void broadcast_ring_buffer<Frame_format, Allocator>::close() {
+	closed_.store(true, std::memory_order_release);
+	readable_event_.signal();
+}
+
+
+template<typename Frame_format, typename Allocator>
+auto broadcast_ring_buffer<Frame_format, Allocator>::add_reader() -> reader_id {
+	for(reader_id id = 0; id < max_readers_; ++id) {
+		reader_state& rd = readers_[id];
+		bool expected = false;
+		if(! rd.claimed.compare_exchange_strong(expected, true)) continue;
+		time_unit write_time = write_time_.load(std::memory_order_acquire);
+		rd.read_time.store(write_time, std::memory_order_relaxed);
+		rd.cached_write_time = write_time;
+		rd.dropped.store(0, std::memory_order_relaxed);
+		rd.read_length = 0;
+		rd.active.store(true, std::memory_order_seq_cst);
+
+		// the writer may have taken slowest_read_time() before this reader became active, and advanced past
+		// write_time: start at the write time observed after activation, which cannot be overwritten before it is read
+		write_time = write_time_.load(std::memory_order_seq_cst);
+		rd.read_time.store(write_time, std::memory_order_release);
+		rd.cached_write_time = write_time;
+		return id;
+	}
+	Assert(false, "too many ring buffer readers");
+	return max_readers_;
+}
+
+
+template<typename Frame_format, typename Allocator>
+void broadcast_ring_buffer<Frame_format, Allocator>::remove_reader(reader_id id) {
+	reader_state& rd = reader_(id);
+	rd.active.store(false, std::memory_order_seq_cst);
+	rd.claimed.store(false, std::memory_order_release);
+	writable_event_.signal();
+}
+
+
+template<typename Frame_format, typename Allocator>
+bool broadcast_ring_buffer<Frame_format, Allocator>::can_read_(reader_state& rd, std::size_t n) {
+	time_unit read_time = rd.read_time.load(std::memory_order_relaxed);
+	if(read_time + n <= rd.cached_write_time) return true;
+	rd.cached_write_time = write_time_.load(std::memory_order_acquire);
+	return (read_time + n <= rd.cached_write_time);
+}
+
+
+template<typename Frame_format, typename Allocator>
+auto broadcast_ring_buffer<Frame_format, Allocator>::read_section_(reader_state& rd, std::size_t n) -> read_section_type {
+	time_unit start_time = rd.read_time.load(std::memory_order_relaxed);
+	rd.read_length = n;
+	if(n == 0) return read_section_type(read_section_type::view_type::null(), start_time);
+	std::ptrdiff_t start = start_time % capacity_;
+	return read_section_type(wraparound(buffer_.cview(), make_ndptrdiff(start), make_ndptrdiff(start + n)), start_time);
+}
+
+
+template<typename Frame_format, typename Allocator>
+void broadcast_ring_buffer<Frame_format, Allocator>::skip_dropped_(reader_state& rd) {
+	// skip frames which were overwritten, or are being overwritten
+	if(overflow_policy_ != ring_overflow_policy::drop) return;
+	time_unit read_time = rd.read_time.load(std::memory_order_relaxed);
+	time_unit oldest_time = write_reserved_time_.load(std::memory_order_acquire) - time_unit(capacity_);
+	if(read_time < oldest_time) {
+		rd.dropped.fetch_add(oldest_time - read_time, std::memory_order_relaxed);
+		rd.read_time.store(oldest_time, std::memory_order_release);
+	}
+}
+
+
+template<typename Frame_format, typename Allocator>
+auto broadcast_ring_buffer<Frame_format, Allocator>::try_begin_read(reader_id id, std::size_t n) -> read_section_type {
+	Assert(n <= capacity_, "cannot read more frames than ring buffer capacity");
+	reader_state& rd = reader_(id);
+	skip_dropped_(rd);
+	if(! can_read_(rd, n)) return read_section_type();
+	return read_section_(rd, n);
+}
+
+
+template<typename Frame_format, typename Allocator>
+auto broadcast_ring_buffer<Frame_format, Allocator>::begin_read(reader_id id, std::size_t n) -> read_section_type {
+	Assert(n <= capacity_, "cannot read more frames than ring buffer capacity");
+	reader_state& rd = reader_(id);
+	for(;;) {
+		if(! can_read_(rd, n)) readable_event_.wait(wait_strategy_, [this, &rd, n] { return can_read_(rd, n) || closed(); });
+
+		// skipping moves the read time forward, so that the n frames may no longer be readable. then wait again
+		skip_dropped_(rd);
+		if(can_read_(rd, n)) return read_section_(rd, n);
+
+		if(closed()) {
+			// frames written before close() are visible after observing closed: return all remaining frames
+			rd.cached_write_time = write_time_.load(std::memory_order_acquire);
+			if(! can_read_(rd, n)) n = rd.cached_write_time - rd.read_time.load(std::memory_order_relaxed);
+			if(n == 0) return read_section_type();
+			return read_section_(rd, n);
+		}
+	}
+}
+
+
+template<typename Frame_format, typename Allocator>
+bool broadcast_ring_buffer<Frame_format, Allocator>::end_read(reader_id id, std::size_t n) {
+	reader_state& rd = reader_(id);
+	Assert(n <= rd.read_length, "cannot end read of more frames than begun");
+	time_unit read_time = rd.read_time.load(std::memory_order_relaxed);
+	bool intact = true;
+	if(overflow_policy_ == ring_overflow_policy::drop && rd.read_length > 0) {
+		// the frames were read before this point. check that the writer had not started overwriting them
+		std::atomic_thread_fence(std::memory_order_acquire);
+		intact = (read_time >= write_reserved_time_.load(std::memory_order_relaxed) - time_unit(capacity_));
+	}
+	rd.read_length = 0;
+	if(n > 0) {
+		rd.read_time.store(read_time + n, std::memory_order_release);
+		if(overflow_policy_ == ring_overflow_policy::block) writable_event_.signal();
+	}
+	return intact;
+}
+
+}
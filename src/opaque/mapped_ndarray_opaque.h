@@ -0,0 +1,57 @@
+#ifndef TLZ_ND_MAPPED_NDARRAY_OPAQUE_H_
+#define TLZ_ND_MAPPED_NDARRAY_OPAQUE_H_
+
+#include "../config.h"
+#if TLZ_ND_WITH_MMAP && TLZ_ND_WITH_OPAQUE
+
+#include <string>
+#include "../common.h"
+#include "ndarray_opaque_view.h"
+#include "../mapped_file.h"
+#include "../detail/ndarray_mapped_wrapper.h"
+
+namespace tlz {
+
+/// \ref ndarray_opaque_view to content of memory-mapped file.
+/** Like \ref mapped_ndarray, but with opaque frames. The frame format must be POD. */
+template<std::size_t Dim, bool Mutable, typename Frame_format>
+class mapped_ndarray_opaque : public detail::ndarray_mapped_wrapper<
+	ndarray_opaque_view<Dim, Mutable, Frame_format>,
+	ndarray_opaque_view<Dim, false, Frame_format>
+> {
+	using base = detail::ndarray_mapped_wrapper<
+		ndarray_opaque_view<Dim, Mutable, Frame_format>,
+		ndarray_opaque_view<Dim, false, Frame_format>
+	>;
+
+public:
+	using typename base::view_type;
+	using typename base::const_view_type;
+	using typename base::shape_type;
+	using typename base::strides_type;
+	using frame_format_type = Frame_format;
+	
+	/// Default mode, read-only if not \a Mutable.
+	static constexpr mapped_file_mode default_mode = Mutable ? mapped_file_mode::read_write : mapped_file_mode::read_only;
+
+	/// Map array with given shape and strides from file at \a path.
+	mapped_ndarray_opaque(const std::string& path, const shape_type& shape, const strides_type& strides, const frame_format_type& frm, mapped_file_mode mode = default_mode, std::size_t offset = 0) :
+	base(path, mode, offset, shape, strides, frm.size(), frm.alignment_requirement(), frm) {
+		Assert(frm.is_pod(), "mapped_ndarray_opaque frame format must be POD");
+		Assert(! Mutable || mode != mapped_file_mode::read_only, "mutable mapped_ndarray_opaque cannot be read-only");
+	}
+	
+	/// Map array with given shape and default strides from file at \a path.
+	mapped_ndarray_opaque(const std::string& path, const shape_type& shape, const frame_format_type& frm, mapped_file_mode mode = default_mode, std::size_t offset = 0, std::size_t frame_padding = 0) :
+		mapped_ndarray_opaque(path, shape, view_type::default_strides(shape, frm, frame_padding), frm, mode, offset) { }
+	
+	mapped_ndarray_opaque(mapped_ndarray_opaque&&) = default;
+	mapped_ndarray_opaque& operator=(mapped_ndarray_opaque&&) = default;
+	
+	frame_format_type frame_format() const { return base::cview().frame_format(); }
+};
+
+}
+
+#endif
+#endif
@@ -32,6 +32,7 @@ public:
 	using typename base::const_view_type;
 	using typename base::shape_type;
 	using typename base::strides_type;
+	using order_type = typename view_type::order_type;
 	using frame_format_type = Frame_format;
 	using frame_handle_type = typename view_type::frame_handle_type;
 	using const_frame_handle_type = typename const_view_type::frame_handle_type;
@@ -39,6 +40,7 @@ public:
 	using const_frame_pointer_type = typename const_view_type::frame_pointer_type;
 	
 	ndarray_opaque(const shape_type&, const frame_format_type&, std::size_t frame_padding = 0, const Allocator& = Allocator());
+	ndarray_opaque(const shape_type&, const frame_format_type&, const order_type&, std::size_t frame_padding = 0, const Allocator& = Allocator());
 	explicit ndarray_opaque(const const_view_type& vw, std::size_t frame_padding = 0, const Allocator& = Allocator());
 	ndarray_opaque(const ndarray_opaque&);
 	ndarray_opaque(ndarray_opaque&&);
@@ -24,9 +24,15 @@ void ndarray_opaque<Dim, Frame_format, Allocator>::destruct_frames_() {
 template<std::size_t Dim, typename Frame_format, typename Allocator>
 ndarray_opaque<Dim, Frame_format, Allocator>::ndarray_opaque
 (const shape_type& shape, const frame_format_type& frm, std::size_t frame_padding, const Allocator& alloc) :
+	ndarray_opaque(shape, frm, order_type(), frame_padding, alloc) { }
+
+
+template<std::size_t Dim, typename Frame_format, typename Allocator>
+ndarray_opaque<Dim, Frame_format, Allocator>::ndarray_opaque
+(const shape_type& shape, const frame_format_type& frm, const order_type& order, std::size_t frame_padding, const Allocator& alloc) :
 base(
 	shape,
-	view_type::default_strides(shape, frm, frame_padding),
+	view_type::default_strides(shape, frm, order, frame_padding),
 	(frm.size() + frame_padding) * shape.product(),
 	frm.alignment_requirement(),
 	alloc,
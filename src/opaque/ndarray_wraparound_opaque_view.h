@@ -16,7 +16,7 @@ using ndarray_wraparound_opaque_view = detail::ndarray_opaque_view_wrapper<Dim,
 
 template<std::size_t Dim, bool Mutable, typename Frame_format>
 bool axis_wraparound(const ndarray_wraparound_opaque_view<Dim, Mutable, Frame_format>& vw, std::ptrdiff_t axis) {
-	return (vw.base_view().wrap_circumferences()[axis] - vw.base_view().wrap_offsets()[axis]) < vw.shape()[axis] * vw.strides()[axis];
+	return axis_wraparound(vw.base_view(), axis);
 }
 
 
@@ -72,6 +72,9 @@ ndarray_wraparound_opaque_view<Dim, Mutable, Frame_format> wraparound(
 template<std::size_t Dim, bool Mutable, typename Frame_format>
 struct is_ndarray_opaque_view<ndarray_wraparound_opaque_view<Dim, Mutable, Frame_format>> : std::true_type {};
 
+template<std::size_t Dim, bool Mutable, typename Frame_format>
+struct is_ndarray_wraparound_view<ndarray_wraparound_opaque_view<Dim, Mutable, Frame_format>> : std::true_type {};
+
 
 
 }
@@ -0,0 +1,171 @@
+#ifndef TLZ_ND_SPSC_RING_BUFFER_H_
+#define TLZ_ND_SPSC_RING_BUFFER_H_
+
+#include "../config.h"
+#if TLZ_ND_WITH_ALLOCATION && TLZ_ND_WITH_OPAQUE && TLZ_ND_WITH_WRAPAROUND
+
+#include <atomic>
+#include <cstddef>
+#include "../common.h"
+#include "../detail/ring_wait.h"
+#include "ndarray_opaque.h"
+#include "ndarray_wraparound_opaque_view.h"
+
+namespace tlz {
+
+/// Section of frames of a ring buffer, with the absolute time index of its first frame.
+/** The time index counts frames since the ring buffer was created. The view is a 1-D wraparound opaque view, which
+ ** can be casted to a concrete `ndarray_wraparound_view<1 + Frame_dim, T>` with `from_opaque`. */
+template<bool Mutable, typename Frame_format>
+class ring_buffer_section {
+public:
+	using view_type = ndarray_wraparound_opaque_view<1, Mutable, Frame_format>;
+
+private:
+	view_type view_;
+	time_unit start_time_;
+
+public:
+	/// Create null section.
+	ring_buffer_section() : view_(view_type::null()), start_time_(undefined_time) { }
+
+	ring_buffer_section(const view_type& vw, time_unit start_time) :
+		view_(vw), start_time_(start_time) { }
+
+	ring_buffer_section(const ring_buffer_section&) = default;
+
+	/// Make this section refer to the same frames as \a sec. Unlike views, assignment is not deep.
+	ring_buffer_section& operator=(const ring_buffer_section& sec) {
+		view_.reset(sec.view_);
+		start_time_ = sec.start_time_;
+		return *this;
+	}
+
+	const view_type& view() const { return view_; }
+	operator const view_type& () const { return view_; }
+
+	bool is_null() const { return view_.is_null(); }
+	explicit operator bool () const { return ! is_null(); }
+
+	time_unit start_time() const { return start_time_; }
+	time_unit end_time() const { return start_time_ + duration(); }
+	time_unit duration() const { return is_null() ? 0 : view_.shape().front(); }
+	time_span span() const { return time_span(start_time(), end_time()); }
+
+	/// Frame at absolute time \a t, which must be inside span().
+	decltype(auto) at_time(time_unit t) const {
+		Assert_crit(t >= start_time() && t < end_time(), "time index outside ring buffer section");
+		return view_[t - start_time_];
+	}
+};
+
+
+/// Single-producer, single-consumer ring buffer of opaque frames.
+/** Frames are stored in an \ref ndarray_opaque of \a capacity frames. One producer thread writes frames with
+ ** begin_write() and end_write(), and one consumer thread reads them with begin_read() and end_read(), concurrently.
+ ** The sections are wraparound views into the buffer, which carry the absolute time index of their first frame.
+ **
+ ** The read and write positions are atomic counters, and each side caches the other's position, so that it only
+ ** needs to load it when the cached value does not allow the request. The operations make no allocations and take no
+ ** locks. When not enough frames are readable or writable, the blocking functions wait with the \ref
+ ** ring_wait_strategy, and the try_ functions return a null section.
+ **
+ ** Frames are constructed when the ring buffer is created, and are overwritten when the ring wraps around. After
+ ** close(), begin_read() returns the remaining frames even if they are fewer than requested. */
+template<typename Frame_format, typename Allocator = raw_allocator>
+class spsc_ring_buffer {
+public:
+	using frame_format_type = Frame_format;
+	using buffer_type = ndarray_opaque<1, Frame_format, Allocator>;
+	using write_section_type = ring_buffer_section<true, Frame_format>;
+	using read_section_type = ring_buffer_section<false, Frame_format>;
+
+private:
+	buffer_type buffer_;
+	std::size_t capacity_;
+	ring_wait_strategy wait_strategy_;
+
+	alignas(64) std::atomic<time_unit> write_time_ {0}; ///< Time of next frame to write. Earlier frames are readable.
+	alignas(64) std::atomic<time_unit> read_time_ {0}; ///< Time of next frame to read. Earlier frames are writable.
+	std::atomic<bool> closed_ {false};
+	detail::ring_wait_event readable_event_;
+	detail::ring_wait_event writable_event_;
+
+	// state of the producer thread
+	alignas(64) time_unit producer_read_time_ = 0; ///< Cached value of read_time_.
+	std::size_t write_length_ = 0; ///< Length of section from last begin_write().
+
+	// state of the consumer thread
+	alignas(64) time_unit consumer_write_time_ = 0; ///< Cached value of write_time_.
+	std::size_t read_length_ = 0; ///< Length of section from last begin_read().
+
+	bool can_write_(std::size_t n);
+	bool can_read_(std::size_t n);
+	write_section_type write_section_(std::size_t n);
+	read_section_type read_section_(std::size_t n);
+
+public:
+	/// Create ring buffer for \a capacity frames of format \a frm.
+	spsc_ring_buffer(const frame_format_type& frm, std::size_t capacity, const ring_wait_strategy& = ring_wait_strategy(),
+		const Allocator& = Allocator());
+
+	spsc_ring_buffer(const spsc_ring_buffer&) = delete;
+	spsc_ring_buffer& operator=(const spsc_ring_buffer&) = delete;
+
+	std::size_t capacity() const { return capacity_; }
+	const frame_format_type& frame_format() const { return buffer_.frame_format(); }
+	const ring_wait_strategy& wait_strategy() const { return wait_strategy_; }
+
+	/// Time of the next frame to be written.
+	time_unit write_time() const { return write_time_.load(std::memory_order_acquire); }
+
+	/// Time of the next frame to be read.
+	time_unit read_time() const { return read_time_.load(std::memory_order_acquire); }
+
+
+	/// \name Producer
+	///@{
+	/// Number of frames which can currently be written.
+	std::size_t writable_frames() const { return capacity_ - (write_time() - read_time()); }
+
+	/// Get section of \a n frames to write to, or null section if less than \a n frames are writable.
+	write_section_type try_begin_write(std::size_t n);
+
+	/// Get section of \a n frames to write to, waiting until they are writable.
+	write_section_type begin_write(std::size_t n);
+
+	/// Make the first \a n frames of the section from the last begin_write() readable.
+	void end_write(std::size_t n);
+
+	/// Mark end of stream. The consumer can read the remaining frames, and then stops waiting.
+	void close();
+	///@}
+
+
+	/// \name Consumer
+	///@{
+	/// Number of frames which can currently be read.
+	std::size_t readable_frames() const { return write_time() - read_time(); }
+
+	/// Get section of \a n frames to read, or null section if less than \a n frames are readable.
+	read_section_type try_begin_read(std::size_t n);
+
+	/// Get section of \a n frames to read, waiting until they are readable.
+	/** If the ring buffer is closed, returns the remaining readable frames, which can be less than \a n, and a null
+	 ** section if there are none. */
+	read_section_type begin_read(std::size_t n);
+
+	/// Make the first \a n frames of the section from the last begin_read() writable again.
+	void end_read(std::size_t n);
+
+	/// Whether close() was called by the producer.
+	bool closed() const { return closed_.load(std::memory_order_acquire); }
+	///@}
+};
+
+}
+
+#include "spsc_ring_buffer.tcc"
+
+#endif
+#endif
@@ -0,0 +1,115 @@
+namespace tlz {
+
+template<typename Frame_format, typename Allocator>
+spsc_ring_buffer<Frame_format, Allocator>::spsc_ring_buffer
+(const frame_format_type& frm, std::size_t capacity, const ring_wait_strategy& strategy, const Allocator& allocator) :
+	buffer_(make_ndsize(capacity), frm, 0, allocator),
+	capacity_(capacity),
+	wait_strategy_(strategy)
+{
+	Assert(capacity > 0, "ring buffer capacity must be non-zero");
+}
+
+
+template<typename Frame_format, typename Allocator>
+bool spsc_ring_buffer<Frame_format, Allocator>::can_write_(std::size_t n) {
+	time_unit write_time = write_time_.load(std::memory_order_relaxed);
+	if(write_time + n <= producer_read_time_ + capacity_) return true;
+	producer_read_time_ = read_time_.load(std::memory_order_acquire);
+	return (write_time + n <= producer_read_time_ + capacity_);
+}
+
+
+template<typename Frame_format, typename Allocator>
+bool spsc_ring_buffer<Frame_format, Allocator>::can_read_(std::size_t n) {
+	time_unit read_time = read_time_.load(std::memory_order_relaxed);
+	if(read_time + n <= consumer_write_time_) return true;
+	consumer_write_time_ = write_time_.load(std::memory_order_acquire);
+	return (read_time + n <= consumer_write_time_);
+}
+
+
+template<typename Frame_format, typename Allocator>
+auto spsc_ring_buffer<Frame_format, Allocator>::write_section_(std::size_t n) -> write_section_type {
+	time_unit start_time = write_time_.load(std::memory_order_relaxed);
+	write_length_ = n;
+	if(n == 0) return write_section_type(write_section_type::view_type::null(), start_time);
+	std::ptrdiff_t start = start_time % capacity_;
+	return write_section_type(wraparound(buffer_.view(), make_ndptrdiff(start), make_ndptrdiff(start + n)), start_time);
+}
+
+
+template<typename Frame_format, typename Allocator>
+auto spsc_ring_buffer<Frame_format, Allocator>::read_section_(std::size_t n) -> read_section_type {
+	time_unit start_time = read_time_.load(std::memory_order_relaxed);
+	read_length_ = n;
+	if(n == 0) return read_section_type(read_section_type::view_type::null(), start_time);
+	std::ptrdiff_t start = start_time % capacity_;
+	return read_section_type(wraparound(buffer_.cview(), make_ndptrdiff(start), make_ndptrdiff(start + n)), start_time);
+}
+
+
+template<typename Frame_format, typename Allocator>
+auto spsc_ring_buffer<Frame_format, Allocator>::try_begin_write(std::size_t n) -> write_section_type {
+	Assert(n <= capacity_, "cannot write more frames than ring buffer capacity");
+	if(! can_write_(n)) return write_section_type();
+	return write_section_(n);
+}
+
+
+template<typename Frame_format, typename Allocator>
+auto spsc_ring_buffer<Frame_format, Allocator>::begin_write(std::size_t n) -> write_section_type {
+	Assert(n <= capacity_, "cannot write more frames than ring buffer capacity");
+	if(! can_write_(n)) writable_event_.wait(wait_strategy_, [this, n] { return can_write_(n); });
+	return write_section_(n);
+}
+
+
+template<typename Frame_format, typename Allocator>
+void spsc_ring_buffer<Frame_format, Allocator>::end_write(std::size_t n) {
+	Assert(n <= write_length_, "cannot end write of more frames than begun");
+	write_length_ = 0;
+	if(n == 0) return;
+	write_time_.store(write_time_.load(std::memory_order_relaxed) + n, std::memory_order_release);
+	readable_event_.signal();
+}
+
+
+template<typename Frame_format, typename Allocator>
+void spsc_ring_buffer<Frame_format, Allocator>::close() {
+	closed_.store(true, std::memory_order_release);
+	readable_event_.signal();
+}
+
+
+template<typename Frame_format, typename Allocator>
+auto spsc_ring_buffer<Frame_format, Allocator>::try_begin_read(std::size_t n) -> read_section_type {
+	Assert(n <= capacity_, "cannot read more frames than ring buffer capacity");
+	if(! can_read_(n)) return read_section_type();
+	return read_section_(n);
+}
+
+
+template<typename Frame_format, typename Allocator>
+auto spsc_ring_buffer<Frame_format, Allocator>::begin_read(std::size_t n) -> read_section_type {
+	Assert(n <= capacity_, "cannot read more frames than ring buffer capacity");
+	if(! can_read_(n)) readable_event_.wait(wait_strategy_, [this, n] { return can_read_(n) || closed(); });
+	if(! can_read_(n)) {
+		// closed: write_time_ is final, and was loaded by can_read_() after closed_
+		n = consumer_write_time_ - read_time_.load(std::memory_order_relaxed);
+		if(n == 0) return read_section_type();
+	}
+	return read_section_(n);
+}
+
+
+template<typename Frame_format, typename Allocator>
+void spsc_ring_buffer<Frame_format, Allocator>::end_read(std::size_t n) {
+	Assert(n <= read_length_, "cannot end read of more frames than begun");
+	read_length_ = 0;
+	if(n == 0) return;
+	read_time_.store(read_time_.load(std::memory_order_relaxed) + n, std::memory_order_release);
+	writable_event_.signal();
+}
+
+}
@@ -6,6 +6,7 @@
 
 #include "../pod_array_format.h"
 #include "../ndcoord_dyn.h"
+#include "../instrumentation.h"
 #include <type_traits>
 
 namespace tlz {
@@ -87,16 +88,23 @@ public:
 	const opaque_ndarray_format& frame_format() const { return frame_format_; }
 	
 	void assign(const opaque_ndarray_frame_handle<false>& vw) {
+		assign(vw, default_pod_array_copy_policy());
+	}
+	
+	void assign(const opaque_ndarray_frame_handle<false>& vw, const pod_array_copy_policy& policy) {
 		Assert(frame_format_.is_pod());
 		Assert(frame_format() == vw.frame_format());
-		if(ptr() != vw.ptr()) pod_array_copy(ptr(), vw.ptr(), frame_format_.pod_format());
+		if(ptr() == vw.ptr()) return;
+		TLZ_ND_INSTRUMENT(frame_handle_assign, frame_format_.size());
+		pod_array_copy(ptr(), vw.ptr(), frame_format_.pod_format(), policy);
 	}
 	
 	bool compare(const opaque_ndarray_frame_handle<false>& vw) const {
 		Assert(frame_format_.is_pod());
 		Assert(frame_format() == vw.frame_format());
-		if(ptr() != vw.ptr()) return pod_array_compare(ptr(), vw.ptr(), frame_format_.pod_format());
-		else return true;
+		if(ptr() == vw.ptr()) return true;
+		TLZ_ND_INSTRUMENT(frame_handle_compare, frame_format_.size());
+		return pod_array_compare(ptr(), vw.ptr(), frame_format_.pod_format());
 	}
 		
 	void construct() const { }
@@ -6,6 +6,8 @@
 
 #include <cstring>
 #include "../ndcoord_dyn.h"
+#include "../pod_array_format.h"
+#include "../instrumentation.h"
 
 namespace tlz {
 	
@@ -71,14 +73,22 @@ public:
 	std::size_t content_size() const { return content_size_; }
 
 	void assign(const opaque_raw_frame_handle<false>& hd) {
+		assign(hd, default_pod_array_copy_policy());
+	}
+	
+	void assign(const opaque_raw_frame_handle<false>& hd, const pod_array_copy_policy& policy) {
 		Assert(content_size() == hd.content_size());
-		if(ptr() != hd.ptr()) std::memcpy(ptr(), hd.ptr(), content_size());
+		if(ptr() == hd.ptr()) return;
+		TLZ_ND_INSTRUMENT(frame_handle_assign, content_size());
+		if(policy.is_streaming(content_size())) detail::pod_array_stream_copy(ptr(), hd.ptr(), content_size());
+		else std::memcpy(ptr(), hd.ptr(), content_size());
 	}
 	
 	bool compare(const opaque_raw_frame_handle<false>& hd) const {		
 		Assert(content_size() == hd.content_size());
-		if(ptr() != hd.ptr()) return (std::memcmp(ptr(), hd.ptr(), content_size()) == 0);
-		else return true;
+		if(ptr() == hd.ptr()) return true;
+		TLZ_ND_INSTRUMENT(frame_handle_compare, content_size());
+		return (std::memcmp(ptr(), hd.ptr(), content_size()) == 0);
 	}
 	
 	void construct() const { }
@@ -4,6 +4,7 @@
 #include <cstdlib>
 #include <type_traits>
 #include "common.h"
+#include "detail/pod_array_simd.h"
 
 namespace tlz {
 
@@ -39,12 +40,45 @@ public:
 };
 
 
+/// Selects how pod_array_copy() writes to the destination memory.
+/** Copies of at least streaming_threshold() bytes use non-temporal (streaming) stores, and prefetch the origin with
+ ** non-temporal hint. They bypass the cache hierarchy, and so do not evict the working set from the last-level cache.
+ ** Worth it for large transfers whose destination does not get read again soon. Only contiguous data gets streamed.
+ ** The default policy, used when none is given explicitly, can be set globally. Initially it never streams. */
+class pod_array_copy_policy {
+private:
+	std::size_t streaming_threshold_;
+
+public:
+	explicit pod_array_copy_policy(std::size_t streaming_threshold) :
+		streaming_threshold_(streaming_threshold) { }
+	
+	/// Policy that never uses streaming stores.
+	static pod_array_copy_policy cached() { return pod_array_copy_policy(std::size_t(-1)); }
+	
+	/// Policy that uses streaming stores for copies of at least \a threshold bytes.
+	static pod_array_copy_policy streaming(std::size_t threshold = 0) { return pod_array_copy_policy(threshold); }
+	
+	std::size_t streaming_threshold() const { return streaming_threshold_; }
+	bool is_streaming(std::size_t size) const { return (size >= streaming_threshold_); }
+};
+
+/// Get default copy policy, used when none is passed explicitly.
+pod_array_copy_policy default_pod_array_copy_policy();
+
+/// Set default copy policy, for all threads.
+void set_default_pod_array_copy_policy(const pod_array_copy_policy&);
+
+
 /// Compare two data stored in \a a and \a b, both having format \a frame_format.
 bool pod_array_compare(const void* a, const void* b, const pod_array_format&);
 
 /// Copy data at \a origin having format \a frame_format to \a destination.
 void pod_array_copy(void* destination, const void* origin, const pod_array_format&);
 
+/// Copy data at \a origin having format \a frame_format to \a destination, using copy policy \a policy.
+void pod_array_copy(void* destination, const void* origin, const pod_array_format&, const pod_array_copy_policy& policy);
+
 
 bool operator==(const pod_array_format&, const pod_array_format&);
 bool operator!=(const pod_array_format&, const pod_array_format&);
@@ -0,0 +1,41 @@
+#ifndef TLZ_NDARRAY_POD_ARRAY_STRIDED_H_
+#define TLZ_NDARRAY_POD_ARRAY_STRIDED_H_
+
+#include <cstdlib>
+#include "common.h"
+#include "ndcoord.h"
+#include "pod_array_format.h"
+
+namespace tlz {
+
+/// Copy `Dim`-dimensional strided POD data from \a origin to \a destination.
+/** Elements have size \a elem_size, and are laid out with \a shape, and with strides \a dest_strides and
+ ** \a origin_strides (in bytes) respectively. Strides may differ between the two, be negative, and be larger than
+ ** \a elem_size (padding bytes are left untouched). Axes are reordered and merged as much as possible, and the inner
+ ** loop is specialized for element sizes 1, 2, 4, 8 and 16. If \a policy streams copies of the total size, contiguous
+ ** runs get written with non-temporal stores. Origin strides may be 0 (broadcast origin): then the inner loop loads the
+ ** origin element once per run. When the origin is contiguous on another axis than the destination, as for a
+ ** transposed view, the copy is done in cache-sized tiles with pod_array_transpose_copy(). */
+template<std::size_t Dim>
+void pod_array_strided_copy(
+	void* destination, const ndptrdiff<Dim>& dest_strides,
+	const void* origin, const ndptrdiff<Dim>& origin_strides,
+	const ndsize<Dim>& shape, std::size_t elem_size,
+	const pod_array_copy_policy& policy = default_pod_array_copy_policy()
+);
+
+/// Compare `Dim`-dimensional strided POD data at \a a and \a b.
+/** Same layout parameters as pod_array_strided_copy(). Padding bytes are ignored. When one of the operands has stride 0
+ ** on the inner loop, its element is loaded once per run. */
+template<std::size_t Dim>
+bool pod_array_strided_compare(
+	const void* a, const ndptrdiff<Dim>& a_strides,
+	const void* b, const ndptrdiff<Dim>& b_strides,
+	const ndsize<Dim>& shape, std::size_t elem_size
+);
+
+}
+
+#include "pod_array_strided.tcc"
+
+#endif
@@ -0,0 +1,248 @@
+#include <algorithm>
+#include <array>
+#include <cstdlib>
+#include <cstring>
+#include <utility>
+#include "ndarray_traversal.h"
+
+namespace tlz {
+
+namespace detail {
+
+using pod_strided_copy_run_function =
+	void (*)(byte*, const byte*, std::ptrdiff_t, std::ptrdiff_t, std::ptrdiff_t, std::size_t);
+
+using pod_strided_compare_run_function =
+	bool (*)(const byte*, const byte*, std::ptrdiff_t, std::ptrdiff_t, std::ptrdiff_t, std::size_t);
+
+
+inline void pod_strided_copy_contiguous_run_
+(byte* dst, const byte* src, std::ptrdiff_t n, std::ptrdiff_t, std::ptrdiff_t, std::size_t elem_size) {
+	std::memcpy(dst, src, n * elem_size);
+}
+
+inline void pod_strided_stream_copy_contiguous_run_
+(byte* dst, const byte* src, std::ptrdiff_t n, std::ptrdiff_t, std::ptrdiff_t, std::size_t elem_size) {
+	pod_array_stream_copy(dst, src, n * elem_size);
+}
+
+template<std::size_t Elem_size>
+void pod_strided_copy_run_
+(byte* dst, const byte* src, std::ptrdiff_t n, std::ptrdiff_t dst_stride, std::ptrdiff_t src_stride, std::size_t) {
+	// constant size memcpy gets compiled into plain load/store
+	for(std::ptrdiff_t i = 0; i < n; ++i, dst += dst_stride, src += src_stride)
+		std::memcpy(dst, src, Elem_size);
+}
+
+inline void pod_strided_copy_generic_run_
+(byte* dst, const byte* src, std::ptrdiff_t n, std::ptrdiff_t dst_stride, std::ptrdiff_t src_stride, std::size_t elem_size) {
+	for(std::ptrdiff_t i = 0; i < n; ++i, dst += dst_stride, src += src_stride)
+		std::memcpy(dst, src, elem_size);
+}
+
+
+template<std::size_t Elem_size>
+void pod_strided_broadcast_run_
+(byte* dst, const byte* src, std::ptrdiff_t n, std::ptrdiff_t dst_stride, std::ptrdiff_t, std::size_t) {
+	// source has stride 0: load it once, outside of the loop
+	byte value[Elem_size];
+	std::memcpy(value, src, Elem_size);
+	for(std::ptrdiff_t i = 0; i < n; ++i, dst += dst_stride)
+		std::memcpy(dst, value, Elem_size);
+}
+
+inline void pod_strided_broadcast_contiguous_generic_run_
+(byte* dst, const byte* src, std::ptrdiff_t n, std::ptrdiff_t, std::ptrdiff_t, std::size_t elem_size) {
+	// copy first element, then repeatedly double the filled part
+	std::size_t total = n * elem_size;
+	std::memcpy(dst, src, elem_size);
+	for(std::size_t filled = elem_size; filled < total; filled *= 2)
+		std::memcpy(dst + filled, dst, std::min(filled, total - filled));
+}
+
+
+inline bool pod_strided_compare_contiguous_run_
+(const byte* a, const byte* b, std::ptrdiff_t n, std::ptrdiff_t, std::ptrdiff_t, std::size_t elem_size) {
+	return (std::memcmp(a, b, n * elem_size) == 0);
+}
+
+template<std::size_t Elem_size>
+bool pod_strided_compare_run_
+(const byte* a, const byte* b, std::ptrdiff_t n, std::ptrdiff_t a_stride, std::ptrdiff_t b_stride, std::size_t) {
+	for(std::ptrdiff_t i = 0; i < n; ++i, a += a_stride, b += b_stride)
+		if(std::memcmp(a, b, Elem_size) != 0) return false;
+	return true;
+}
+
+template<std::size_t Elem_size>
+bool pod_strided_compare_broadcast_run_
+(const byte* a, const byte* b, std::ptrdiff_t n, std::ptrdiff_t a_stride, std::ptrdiff_t b_stride, std::size_t) {
+	// one operand has stride 0: load it once, outside of the loop
+	if(b_stride != 0) { std::swap(a, b); std::swap(a_stride, b_stride); }
+	byte value[Elem_size];
+	std::memcpy(value, b, Elem_size);
+	for(std::ptrdiff_t i = 0; i < n; ++i, a += a_stride)
+		if(std::memcmp(a, value, Elem_size) != 0) return false;
+	return true;
+}
+
+inline bool pod_strided_compare_generic_run_
+(const byte* a, const byte* b, std::ptrdiff_t n, std::ptrdiff_t a_stride, std::ptrdiff_t b_stride, std::size_t elem_size) {
+	for(std::ptrdiff_t i = 0; i < n; ++i, a += a_stride, b += b_stride)
+		if(std::memcmp(a, b, elem_size) != 0) return false;
+	return true;
+}
+
+
+inline pod_strided_copy_run_function select_pod_strided_copy_run_
+(std::size_t elem_size, std::ptrdiff_t dst_stride, std::ptrdiff_t src_stride, bool streaming) {
+	std::ptrdiff_t sz = elem_size;
+	if(dst_stride == sz && src_stride == sz)
+		return (streaming ? &pod_strided_stream_copy_contiguous_run_ : &pod_strided_copy_contiguous_run_);
+	if(src_stride == 0 && dst_stride != 0) switch(elem_size) {
+		case 1: return &pod_strided_broadcast_run_<1>;
+		case 2: return &pod_strided_broadcast_run_<2>;
+		case 4: return &pod_strided_broadcast_run_<4>;
+		case 8: return &pod_strided_broadcast_run_<8>;
+		case 16: return &pod_strided_broadcast_run_<16>;
+		default: if(dst_stride == sz) return &pod_strided_broadcast_contiguous_generic_run_; else break;
+	}
+	switch(elem_size) {
+		case 1: return &pod_strided_copy_run_<1>;
+		case 2: return &pod_strided_copy_run_<2>;
+		case 4: return &pod_strided_copy_run_<4>;
+		case 8: return &pod_strided_copy_run_<8>;
+		case 16: return &pod_strided_copy_run_<16>;
+		default: return &pod_strided_copy_generic_run_;
+	}
+}
+
+inline pod_strided_compare_run_function select_pod_strided_compare_run_
+(std::size_t elem_size, std::ptrdiff_t a_stride, std::ptrdiff_t b_stride) {
+	std::ptrdiff_t sz = elem_size;
+	if(a_stride == sz && b_stride == sz) return &pod_strided_compare_contiguous_run_;
+	if((a_stride == 0) != (b_stride == 0)) switch(elem_size) {
+		case 1: return &pod_strided_compare_broadcast_run_<1>;
+		case 2: return &pod_strided_compare_broadcast_run_<2>;
+		case 4: return &pod_strided_compare_broadcast_run_<4>;
+		case 8: return &pod_strided_compare_broadcast_run_<8>;
+		case 16: return &pod_strided_compare_broadcast_run_<16>;
+	}
+	switch(elem_size) {
+		case 1: return &pod_strided_compare_run_<1>;
+		case 2: return &pod_strided_compare_run_<2>;
+		case 4: return &pod_strided_compare_run_<4>;
+		case 8: return &pod_strided_compare_run_<8>;
+		case 16: return &pod_strided_compare_run_<16>;
+		default: return &pod_strided_compare_generic_run_;
+	}
+}
+
+
+/// Copy for canonicalized \a loop, where destination is contiguous on the run axis, and origin on \a axis.
+/** Iterates over the other axes, and copies the 2D sections with pod_array_transpose_copy(). */
+template<std::size_t Dim>
+void pod_array_strided_transpose_copy_(
+	const strided_loop<Dim, 2>& loop, std::ptrdiff_t axis,
+	byte* dst_start, const byte* src_start, std::size_t elem_size
+) {
+	const std::ptrdiff_t run_axis = loop.dimension() - 1;
+	ndsize<Dim> outer_shape;
+	std::array<ndptrdiff<Dim>, 2> outer_strides;
+	for(std::ptrdiff_t i = 0; i < Dim; ++i) {
+		bool outer = (i < run_axis && i != axis);
+		outer_shape[i] = (outer ? loop.shape(i) : 1);
+		for(std::ptrdiff_t k = 0; k < 2; ++k) outer_strides[k][i] = (outer ? loop.strides(i)[k] : 0);
+	}
+	strided_loop<Dim, 2> outer_loop(outer_shape, outer_strides);
+
+	dst_start += loop.origin()[0];
+	src_start += loop.origin()[1];
+	const std::ptrdiff_t count = outer_loop.run_length();
+	const auto& outer_run_strides = outer_loop.run_strides();
+	outer_loop.run([&](const auto& offsets) {
+		for(std::ptrdiff_t i = 0; i < count; ++i) pod_array_transpose_copy(
+			dst_start + offsets[0] + i * outer_run_strides[0], loop.strides(axis)[0],
+			src_start + offsets[1] + i * outer_run_strides[1], loop.run_strides()[1],
+			loop.shape(axis), loop.run_length(), elem_size
+		);
+	});
+}
+
+}
+
+
+template<std::size_t Dim>
+void pod_array_strided_copy(
+	void* destination, const ndptrdiff<Dim>& dest_strides,
+	const void* origin, const ndptrdiff<Dim>& origin_strides,
+	const ndsize<Dim>& shape, std::size_t elem_size,
+	const pod_array_copy_policy& policy
+) {
+	detail::strided_loop<Dim, 2> loop(shape, {{ dest_strides, origin_strides }});
+	loop.canonicalize();
+	if(loop.is_empty()) return;
+
+	byte* dst_start = static_cast<byte*>(destination);
+	const byte* src_start = static_cast<const byte*>(origin);
+	const std::ptrdiff_t count = loop.run_length();
+	const std::ptrdiff_t dst_stride = loop.run_strides()[0];
+	const std::ptrdiff_t src_stride = loop.run_strides()[1];
+
+	if(loop.dimension() == 1 && dst_stride == src_stride && dst_stride >= elem_size) {
+		pod_array_copy(
+			dst_start + loop.origin()[0],
+			src_start + loop.origin()[1],
+			pod_array_format(elem_size, 1, count, dst_stride),
+			policy
+		);
+		return;
+	}
+
+	if(dst_stride == std::ptrdiff_t(elem_size) && std::abs(src_stride) > std::ptrdiff_t(elem_size)) {
+		// origin contiguous along another axis: transposed copy in tiles
+		for(std::ptrdiff_t axis = 0; axis < loop.dimension() - 1; ++axis) if(loop.strides(axis)[1] == std::ptrdiff_t(elem_size)) {
+			detail::pod_array_strided_transpose_copy_(loop, axis, dst_start, src_start, elem_size);
+			return;
+		}
+	}
+
+	const bool streaming = policy.is_streaming(shape.product() * elem_size);
+	auto copy_run = detail::select_pod_strided_copy_run_(elem_size, dst_stride, src_stride, streaming);
+	loop.run([&](const auto& offsets) {
+		copy_run(dst_start + offsets[0], src_start + offsets[1], count, dst_stride, src_stride, elem_size);
+	});
+}
+
+
+template<std::size_t Dim>
+bool pod_array_strided_compare(
+	const void* a, const ndptrdiff<Dim>& a_strides,
+	const void* b, const ndptrdiff<Dim>& b_strides,
+	const ndsize<Dim>& shape, std::size_t elem_size
+) {
+	detail::strided_loop<Dim, 2> loop(shape, {{ a_strides, b_strides }});
+	loop.canonicalize();
+	if(loop.is_empty()) return true;
+
+	const byte* a_start = static_cast<const byte*>(a);
+	const byte* b_start = static_cast<const byte*>(b);
+	const std::ptrdiff_t count = loop.run_length();
+	const std::ptrdiff_t a_stride = loop.run_strides()[0];
+	const std::ptrdiff_t b_stride = loop.run_strides()[1];
+
+	if(loop.dimension() == 1 && a_stride == b_stride && a_stride >= elem_size) {
+		return pod_array_compare(
+			a_start + loop.origin()[0],
+			b_start + loop.origin()[1],
+			pod_array_format(elem_size, 1, count, a_stride)
+		);
+	}
+
+	auto compare_run = detail::select_pod_strided_compare_run_(elem_size, a_stride, b_stride);
+	return loop.run([&](const auto& offsets) {
+		return compare_run(a_start + offsets[0], b_start + offsets[1], count, a_stride, b_stride, elem_size);
+	});
+}
+
+}
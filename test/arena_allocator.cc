@@ -0,0 +1,103 @@
+#include <catch.hpp>
+#include <string>
+#include "../src/allocator/arena_allocator.h"
+#include "../src/ndarray.h"
+#include "../src/opaque/ndarray_opaque.h"
+#include "../src/opaque_format/raw.h"
+#include "support/ndarray.h"
+
+using namespace tlz;
+using namespace tlz::test;
+
+TEST_CASE("monotonic_arena", "[nd][arena_allocator]") {
+	SECTION("bump allocation") {
+		monotonic_arena arena(1024, false);
+		REQUIRE(arena.capacity() == 1024);
+		void* a = arena.allocate(10, 1);
+		void* b = arena.allocate(8, 8);
+		void* c = arena.allocate(1, 64);
+		REQUIRE(is_aligned(b, 8));
+		REQUIRE(is_aligned(c, 64));
+		REQUIRE(raw_ptr_difference(b, a) >= 10);
+		REQUIRE(raw_ptr_difference(b, a) < 18);
+		REQUIRE(raw_ptr_difference(c, b) >= 8);
+		REQUIRE(arena.used() == raw_ptr_difference(c, a) + 1);
+
+		REQUIRE_THROWS_AS(arena.allocate(2000), const std::bad_alloc&);
+
+		arena.reset();
+		REQUIRE(arena.used() == 0);
+		REQUIRE(arena.allocate(10, 1) == a);
+	}
+
+	SECTION("external buffer") {
+		alignas(16) char buffer[256];
+		monotonic_arena arena(buffer, sizeof(buffer));
+		REQUIRE(arena.allocate(100, 16) == buffer);
+		REQUIRE(arena.allocate(100, 16) == buffer + 112);
+		REQUIRE_THROWS_AS(arena.allocate(100, 16), const std::bad_alloc&);
+	}
+
+	SECTION("overflow") {
+		monotonic_arena arena(256);
+		for(int cycle = 0; cycle < 3; ++cycle) {
+			for(int i = 0; i < 10; ++i) {
+				int* ptr = static_cast<int*>(arena.allocate(100 * sizeof(int), alignof(int)));
+				for(int j = 0; j < 100; ++j) ptr[j] = j;
+			}
+			if(cycle == 0) REQUIRE(arena.overflow_count() > 0);
+			else REQUIRE(arena.overflow_count() == 0);
+			arena.reset();
+		}
+		REQUIRE(arena.capacity() >= 10 * 100 * sizeof(int));
+		REQUIRE(arena.peak_used() >= 10 * 100 * sizeof(int));
+	}
+}
+
+
+TEST_CASE("arena_allocator", "[nd][arena_allocator]") {
+	monotonic_arena arena(64 * 1024);
+
+	SECTION("ndarray") {
+		using array_type = ndarray<2, int, arena_allocator<int>>;
+		{
+			array_type arr(make_ndsize(10, 20), 0, arena_allocator<int>(arena));
+			REQUIRE(arena.used() >= 200 * sizeof(int));
+			for(auto coord : make_ndspan(arr.shape())) arr.at(coord) = coord[0] * 20 + coord[1];
+
+			// copy and move keep the arena
+			array_type arr2 = arr;
+			REQUIRE(arr2.get_allocator().arena() == &arena);
+			REQUIRE(arr2 == arr);
+			array_type arr3 = std::move(arr2);
+			REQUIRE(arr3.get_allocator().arena() == &arena);
+			REQUIRE(arr3 == arr);
+			arr3 = array_type(make_ndsize(3, 3), 0, arena_allocator<int>(arena));
+			REQUIRE(arr3.get_allocator().arena() == &arena);
+		}
+		arena.reset();
+		REQUIRE(arena.used() == 0);
+	}
+
+	SECTION("ndarray non-POD") {
+		ndarray<1, std::string, arena_allocator<std::string>> arr(make_ndsize(10), 0, arena_allocator<std::string>(arena));
+		arr[3] = "a string which is too long for the small string optimization";
+		REQUIRE(arr[3] == "a string which is too long for the small string optimization");
+	}
+
+	SECTION("default-constructed") {
+		ndarray<1, int, arena_allocator<int>> arr(make_ndsize(10));
+		REQUIRE(arr.get_allocator().arena() == nullptr);
+		REQUIRE(arena.used() == 0);
+		arr[0] = 1;
+	}
+
+	SECTION("ndarray_opaque") {
+		opaque_raw_format frm(sizeof(int), 32);
+		ndarray_opaque<1, opaque_raw_format, raw_arena_allocator> arr(make_ndsize(10), frm, 0, raw_arena_allocator(arena));
+		REQUIRE(arena.used() >= 10 * sizeof(int));
+		REQUIRE(is_aligned(arr.start(), 32));
+		auto frame = make_ndarray_opaque_frame(frm, raw_arena_allocator(arena));
+		REQUIRE(is_aligned(frame.frame_handle().ptr(), 32));
+	}
+}
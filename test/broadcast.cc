@@ -0,0 +1,152 @@
+#include <catch.hpp>
+#include <array>
+#include <string>
+#include "../src/ndarray_view.h"
+#include "../src/ndarray.h"
+#include "../src/ndarray_view_operations.h"
+#include "../src/ndarray_expression.h"
+#include "support/ndarray.h"
+
+using namespace tlz;
+using namespace tlz::test;
+
+TEST_CASE("ndarray_broadcast", "[nd][ndarray_broadcast]") {
+	SECTION("add axis") {
+		ndarray<2, int> arr(make_ndsize(3, 4));
+		auto front = add_front_axis(arr.view());
+		REQUIRE(front.shape() == make_ndsize(1, 3, 4));
+		REQUIRE(front.strides() == make_ndptrdiff(0, arr.strides()[0], arr.strides()[1]));
+		auto back = add_back_axis(arr.view());
+		REQUIRE(back.shape() == make_ndsize(3, 4, 1));
+		REQUIRE(back.strides() == make_ndptrdiff(arr.strides()[0], arr.strides()[1], 0));
+	}
+
+	SECTION("broadcast shape") {
+		REQUIRE(broadcast_shape(make_ndsize(3, 1, 5), make_ndsize(3, 4, 1)) == make_ndsize(3, 4, 5));
+		REQUIRE(broadcast_shape(make_ndsize(4, 5), make_ndsize(3, 1, 5)) == make_ndsize(3, 4, 5));
+		REQUIRE(broadcast_shape(make_ndsize(1), make_ndsize(2, 3)) == make_ndsize(2, 3));
+		REQUIRE_THROWS_AS(broadcast_shape(make_ndsize(3, 4), make_ndsize(3, 5)), const failed_assertion&);
+
+		REQUIRE(is_broadcastable(make_ndsize(4, 1), make_ndsize(3, 4, 5)));
+		REQUIRE(is_broadcastable(make_ndsize(5), make_ndsize(3, 4, 5)));
+		REQUIRE_FALSE(is_broadcastable(make_ndsize(4, 2), make_ndsize(3, 4, 5)));
+		REQUIRE_FALSE(is_broadcastable(make_ndsize(3, 4, 5), make_ndsize(4, 5)));
+	}
+
+	SECTION("broadcast_to") {
+		ndarray<1, int> row(make_ndsize(5));
+		for(std::ptrdiff_t i = 0; i < 5; ++i) row[i] = 10 * i;
+
+		auto b = broadcast_to(row.cview(), make_ndsize(3, 4, 5));
+		REQUIRE(b.shape() == make_ndsize(3, 4, 5));
+		REQUIRE(b.strides() == make_ndptrdiff(0, 0, sizeof(int)));
+		for(const auto& c : make_ndspan(b.shape())) REQUIRE(b.at(c) == 10 * c[2]);
+
+		ndarray<2, int> col(make_ndsize(4, 1));
+		for(std::ptrdiff_t i = 0; i < 4; ++i) col[i][0] = i;
+		auto bc = broadcast_to(col.cview(), make_ndsize(4, 6));
+		REQUIRE(bc.strides() == make_ndptrdiff(sizeof(int), 0));
+		for(const auto& c : make_ndspan(bc.shape())) REQUIRE(bc.at(c) == c[0]);
+
+		REQUIRE_THROWS_AS(broadcast_to(col.cview(), make_ndsize(5, 6)), const failed_assertion&);
+
+		auto both = broadcast(col.cview(), row.cview());
+		REQUIRE(both.first.shape() == make_ndsize(4, 5));
+		REQUIRE(both.second.shape() == make_ndsize(4, 5));
+		for(const auto& c : make_ndspan(make_ndsize(4, 5))) {
+			REQUIRE(both.first.at(c) == c[0]);
+			REQUIRE(both.second.at(c) == 10 * c[1]);
+		}
+	}
+
+	SECTION("assign and compare") {
+		auto shape = make_ndsize(6, 7, 9);
+		ndarray<1, int> bias(make_ndsize(6));
+		for(std::ptrdiff_t i = 0; i < 6; ++i) bias[i] = 3 * i + 1;
+		auto bias_b = swapaxis(broadcast_to(bias.cview(), make_ndsize(9, 7, 6)), 0, 2);
+		REQUIRE(bias_b.shape() == shape);
+
+		ndarray<3, int> arr(shape);
+		arr.view().assign(bias_b);
+		for(const auto& c : make_ndspan(shape)) REQUIRE(arr.at(c) == 3 * c[0] + 1);
+		REQUIRE(arr.view() == bias_b);
+		REQUIRE(bias_b == arr.view());
+		arr[2][3][4] = 0;
+		REQUIRE_FALSE(arr.view() == bias_b);
+		REQUIRE_FALSE(bias_b == arr.view());
+
+		// reversed destination
+		arr.view().fill(0);
+		reverse(arr.view(), 2).assign(bias_b);
+		REQUIRE(arr.view() == bias_b);
+
+		// element sizes without specialized kernel
+		using elem = std::array<char, 5>;
+		ndarray<1, elem> strs(make_ndsize(3));
+		strs[0] = elem{{'a', 'b', 'c', 'd', 'e'}};
+		strs[1] = elem{{'f', 'g', 'h', 'i', 'j'}};
+		strs[2] = elem{{'k', 'l', 'm', 'n', 'o'}};
+		auto strs_b = swapaxis(broadcast_to(strs.cview(), make_ndsize(11, 3)), 0, 1);
+		ndarray<2, elem> strs_arr(make_ndsize(3, 11));
+		strs_arr.view().assign(strs_b);
+		for(const auto& c : make_ndspan(strs_arr.shape())) REQUIRE(strs_arr.at(c) == strs[c[0]]);
+		REQUIRE(strs_arr.view() == strs_b);
+
+		// non-POD
+		ndarray<1, std::string> words(make_ndsize(2));
+		words[0] = "one";
+		words[1] = "two";
+		auto words_b = broadcast_to(words.cview(), make_ndsize(3, 2));
+		ndarray<2, std::string> words_arr(make_ndsize(3, 2));
+		words_arr.view().assign(words_b);
+		REQUIRE(words_arr[2][1] == "two");
+		REQUIRE(words_arr.view() == words_b);
+	}
+
+	SECTION("expression") {
+		auto shape = make_ndsize(5, 8, 33);
+		ndarray<3, int> img(shape);
+		int i = 0;
+		for(int& v : img) v = i++;
+		ndarray<3, int> row_bias(make_ndsize(5, 8, 1)), col_bias(make_ndsize(1, 1, 33));
+		i = 0;
+		for(int& v : row_bias) v = 1000 * (i++);
+		i = 0;
+		for(int& v : col_bias) v = -(i++);
+
+		auto expr = img.cview() + row_bias.cview() + col_bias.cview();
+		REQUIRE(expr.shape() == shape);
+		REQUIRE(expr.at(make_ndptrdiff(1, 2, 3)) == img[1][2][3] + row_bias[1][2][0] + col_bias[0][0][3]);
+
+		auto expect = [&](const auto& result) {
+			for(const auto& c : make_ndspan(shape))
+				REQUIRE(result.at(c) == img.at(c) + row_bias[c[0]][c[1]][0] + col_bias[0][0][c[2]]);
+		};
+
+		ndarray<3, int> out(shape);
+		out.view() = expr;
+		expect(out);
+
+		out.view().fill(0);
+		out.view().assign(execution::par.with_min_block_size(64), expr);
+		expect(out);
+
+		ndarray<3, int> out2(expr);
+		expect(out2);
+
+		// both operands broadcast
+		ndarray<3, int> outer(row_bias.cview() * col_bias.cview());
+		REQUIRE(outer.shape() == make_ndsize(5, 8, 33));
+		for(const auto& c : make_ndspan(outer.shape()))
+			REQUIRE(outer.at(c) == row_bias[c[0]][c[1]][0] * col_bias[0][0][c[2]]);
+
+		// nested broadcast expression, and explicitly broadcast view
+		auto bias_b = broadcast_to(ndarray_view<1, const int>(&row_bias[0][0][0], make_ndsize(40)), make_ndsize(33, 40));
+		ndarray<2, int> nested(make_ndsize(33, 40));
+		nested.view() = (bias_b + 1) * ndarray_view<2, const int>(&col_bias[0][0][0], make_ndsize(33, 1));
+		for(const auto& c : make_ndspan(nested.shape()))
+			REQUIRE(nested.at(c) == (1000 * int(c[1]) + 1) * -int(c[0]));
+
+		REQUIRE_THROWS_AS(img.cview() + row_bias.cview()(0, 2), const failed_assertion&);
+	}
+}
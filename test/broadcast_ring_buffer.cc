@@ -0,0 +1,209 @@
+#include <catch.hpp>
+#include <thread>
+#include <vector>
+#include "../src/opaque/broadcast_ring_buffer.h"
+#include "../src/opaque_format/raw.h"
+#include "support/ndarray.h"
+
+using namespace tlz;
+using namespace tlz::test;
+
+namespace {
+
+using ring_type = broadcast_ring_buffer<opaque_raw_format>;
+
+void write_frames(ring_type& ring, int first, std::size_t n) {
+	auto w = ring.begin_write(n);
+	for(std::size_t i = 0; i < n; ++i) *reinterpret_cast<int*>(w.view()[i].start()) = first + i;
+	ring.end_write(n);
+}
+
+int frame_value(const ring_type::read_section_type& r, time_unit t) {
+	return *reinterpret_cast<const int*>(r.at_time(t).start());
+}
+
+}
+
+
+TEST_CASE("broadcast_ring_buffer", "[nd][broadcast_ring_buffer]") {
+	opaque_raw_format frm(sizeof(int), alignof(int));
+
+	SECTION("block") {
+		ring_type ring(frm, 8, 3);
+		REQUIRE(ring.overflow_policy() == ring_overflow_policy::block);
+		auto a = ring.add_reader();
+		auto b = ring.add_reader();
+		REQUIRE(a != b);
+
+		write_frames(ring, 0, 6);
+		REQUIRE(ring.readable_frames(a) == 6);
+
+		auto r = ring.begin_read(a, 6);
+		REQUIRE(r.span().begin == 0);
+		REQUIRE(r.span().end == 6);
+		for(time_unit t = 0; t < 6; ++t) REQUIRE(frame_value(r, t) == t);
+		REQUIRE(ring.end_read(a, 6));
+
+		// b is slowest reader, and blocks writer
+		REQUIRE(ring.slowest_read_time() == 0);
+		REQUIRE(ring.writable_frames() == 2);
+		REQUIRE(ring.try_begin_write(3).is_null());
+
+		r = ring.begin_read(b, 4);
+		REQUIRE(r.start_time() == 0);
+		REQUIRE(ring.end_read(b, 4));
+		REQUIRE(ring.slowest_read_time() == 4);
+		write_frames(ring, 6, 6); // wraps around
+		REQUIRE(ring.try_begin_write(1).is_null());
+
+		r = ring.begin_read(b, 8);
+		REQUIRE(r.start_time() == 4);
+		for(time_unit t = 4; t < 12; ++t) REQUIRE(frame_value(r, t) == t);
+		REQUIRE(ring.end_read(b, 8));
+
+		// removed reader does not block writer
+		ring.remove_reader(a);
+		REQUIRE(ring.slowest_read_time() == 12);
+		REQUIRE(ring.writable_frames() == 8);
+
+		// new reader starts at write time
+		auto c = ring.add_reader();
+		REQUIRE(ring.read_time(c) == 12);
+		REQUIRE(ring.try_begin_read(c, 1).is_null());
+		ring.add_reader();
+		REQUIRE_THROWS(ring.add_reader());
+	}
+
+	SECTION("drop") {
+		ring_type ring(frm, 8, 2, ring_overflow_policy::drop);
+		auto fast = ring.add_reader();
+		auto slow = ring.add_reader();
+
+		for(int i = 0; i < 20; i += 4) {
+			write_frames(ring, i, 4);
+			auto r = ring.begin_read(fast, 4);
+			REQUIRE(frame_value(r, i) == i);
+			REQUIRE(ring.end_read(fast, 4));
+		}
+		REQUIRE(ring.dropped_frames(fast) == 0);
+
+		// slow reader lost frames 0 to 12
+		auto r = ring.begin_read(slow, 2);
+		REQUIRE(r.start_time() == 12);
+		REQUIRE(ring.dropped_frames(slow) == 12);
+		REQUIRE(frame_value(r, 12) == 12);
+		REQUIRE(ring.end_read(slow, 2));
+
+		// section gets overwritten while being read
+		r = ring.begin_read(slow, 2);
+		REQUIRE(r.start_time() == 14);
+		write_frames(ring, 20, 8);
+		REQUIRE_FALSE(ring.end_read(slow, 2));
+	}
+
+	SECTION("drop, wait after skip") {
+		ring_type ring(frm, 8, 1, ring_overflow_policy::drop);
+		auto a = ring.add_reader();
+		write_frames(ring, 0, 8);
+
+		// pending write overwrites frames 0 to 6, so after skipping them only 2 frames are readable
+		auto w = ring.begin_write(6);
+		REQUIRE(ring.try_begin_read(a, 4).is_null());
+		REQUIRE(ring.dropped_frames(a) == 6);
+		REQUIRE(ring.read_time(a) == 6);
+
+		// begin_read waits until the 4 frames are readable
+		ring_type::read_section_type r;
+		std::thread reader([&] { r = ring.begin_read(a, 4); });
+		for(std::size_t i = 0; i < 6; ++i) *reinterpret_cast<int*>(w.view()[i].start()) = 8 + i;
+		ring.end_write(6);
+		reader.join();
+		REQUIRE_FALSE(ring.closed());
+		REQUIRE(r.start_time() == 6);
+		REQUIRE(r.duration() == 4);
+		for(time_unit t = 6; t < 10; ++t) REQUIRE(frame_value(r, t) == t);
+		REQUIRE(ring.end_read(a, 4));
+	}
+
+	SECTION("close") {
+		ring_type ring(frm, 8, 1);
+		auto a = ring.add_reader();
+		write_frames(ring, 0, 3);
+		ring.close();
+		auto r = ring.begin_read(a, 5);
+		REQUIRE(r.duration() == 3);
+		ring.end_read(a, 3);
+		REQUIRE(ring.begin_read(a, 1).is_null());
+	}
+
+	SECTION("threads") {
+		constexpr int total = 20000;
+		constexpr std::size_t readers_count = 3;
+		ring_wait_strategy strategy;
+		strategy.spin_iterations = 50;
+		ring_type ring(frm, 32, readers_count, ring_overflow_policy::block, strategy);
+
+		std::vector<ring_type::reader_id> ids;
+		for(std::size_t i = 0; i < readers_count; ++i) ids.push_back(ring.add_reader());
+
+		std::vector<bool> ok(readers_count, false);
+		std::vector<std::thread> readers;
+		for(std::size_t k = 0; k < readers_count; ++k) readers.emplace_back([&, k] {
+			bool valid = true;
+			int expected = 0;
+			for(;;) {
+				auto r = ring.begin_read(ids[k], 1 + (expected + k) % (3 + 5 * k));
+				if(r.is_null()) break;
+				valid = valid && (r.start_time() == expected);
+				for(time_unit t = r.start_time(); t < r.end_time(); ++t) valid = valid && (frame_value(r, t) == t);
+				expected += r.duration();
+				valid = ring.end_read(ids[k], r.duration()) && valid;
+			}
+			ok[k] = valid && (expected == total);
+		});
+
+		for(int i = 0; i < total; i += 10) write_frames(ring, i, 10);
+		ring.close();
+		for(std::thread& th : readers) th.join();
+		for(std::size_t k = 0; k < readers_count; ++k) REQUIRE(ok[k]);
+	}
+
+	SECTION("readers added while writing") {
+		constexpr int total = 20000;
+		ring_type ring(frm, 16, 2, ring_overflow_policy::block);
+		ring_type::reader_id main_id = ring.add_reader();
+
+		bool main_ok = false, late_ok = true;
+		std::thread main_reader([&] {
+			bool valid = true;
+			int expected = 0;
+			for(;;) {
+				auto r = ring.begin_read(main_id, 4);
+				if(r.is_null()) break;
+				for(time_unit t = r.start_time(); t < r.end_time(); ++t) valid = valid && (frame_value(r, t) == t);
+				expected += r.duration();
+				ring.end_read(main_id, r.duration());
+			}
+			main_ok = valid && (expected == total);
+		});
+		std::thread late_reader([&] {
+			while(! ring.closed()) {
+				ring_type::reader_id id = ring.add_reader();
+				for(int i = 0; i < 8; ++i) {
+					auto r = ring.begin_read(id, 1);
+					if(r.is_null()) break;
+					late_ok = late_ok && (frame_value(r, r.start_time()) == r.start_time());
+					ring.end_read(id, 1);
+				}
+				ring.remove_reader(id);
+			}
+		});
+
+		for(int i = 0; i < total; i += 4) write_frames(ring, i, 4);
+		ring.close();
+		main_reader.join();
+		late_reader.join();
+		REQUIRE(main_ok);
+		REQUIRE(late_ok);
+	}
+}
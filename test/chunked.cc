@@ -0,0 +1,110 @@
+#include <catch.hpp>
+#include "../src/config.h"
+#if TLZ_ND_WITH_MMAP
+#include <cstdio>
+#include <string>
+#include <unistd.h>
+#include "../src/chunked_ndarray.h"
+#include "support/ndarray.h"
+
+using namespace tlz;
+using namespace tlz::test;
+
+TEST_CASE("chunked_ndarray", "[nd][chunked_ndarray]") {
+	char path_buf[] = "/tmp/tlz_nd_test_XXXXXX";
+	int fd = ::mkstemp(path_buf);
+	REQUIRE(fd != -1);
+	::close(fd);
+	std::string path = path_buf;
+	
+	auto shape = make_ndsize(5, 7, 9);
+	auto chunk_shape = make_ndsize(2, 3, 4);
+	auto value = [](const ndptrdiff<3>& c) { return int(100*c[0] + 10*c[1] + c[2]); };
+	
+	ndarray<3, int> ref(shape);
+	for(const auto& c : make_ndspan(shape)) ref.at(c) = value(c);
+
+	{
+		auto arr = chunked_ndarray<3, int>::create(path, shape, chunk_shape, 4);
+		REQUIRE(arr.chunks_shape() == make_ndsize(3, 3, 3));
+		REQUIRE(arr.chunk_span(make_ndptrdiff(2, 2, 2)) == make_ndspan(make_ndptrdiff(4, 6, 8), make_ndptrdiff(5, 7, 9)));
+		REQUIRE(arr.chunk_position(make_ndptrdiff(3, 3, 3)) == make_ndptrdiff(1, 1, 0));
+		
+		// initially zero
+		auto ch = arr.cchunk(make_ndptrdiff(0, 0, 0));
+		REQUIRE(ch.shape() == chunk_shape);
+		for(int v : ch) REQUIRE(v == 0);
+		REQUIRE(arr.cache_stats().misses == 1);
+		
+		arr.write(make_ndptrdiff(0, 0, 0), ref.cview());
+		REQUIRE(arr.resident_chunks() == 4);
+		REQUIRE(arr.cache_stats().evictions > 0);
+		REQUIRE(arr.cache_stats().writebacks > 0);
+		
+		REQUIRE(arr.read(arr.full_span()).compare(ref));
+	}
+	
+	chunked_ndarray<3, int> arr(path, shape, chunk_shape, 2);
+	REQUIRE(arr.cache_stats().misses == 0);
+	
+	SECTION("read") {
+		auto span = make_ndspan(make_ndptrdiff(1, 2, 3), make_ndptrdiff(4, 7, 8));
+		REQUIRE(arr.read(span).compare(ref.cview().section(span)));
+		REQUIRE(arr.read(arr.full_span()).compare(ref));
+		REQUIRE(arr.cache_stats().evictions == arr.cache_stats().misses - 2);
+		REQUIRE(arr.cache_stats().writebacks == 0);
+	}
+	
+	SECTION("chunk") {
+		auto edge = arr.cchunk(make_ndptrdiff(2, 2, 2));
+		REQUIRE(edge.shape() == make_ndsize(1, 1, 1));
+		REQUIRE(edge[0][0][0] == value(make_ndptrdiff(4, 6, 8)));
+		
+		auto sec_span = make_ndspan(make_ndptrdiff(2, 3, 4), make_ndptrdiff(4, 5, 7));
+		auto sec = arr.csection(sec_span);
+		REQUIRE(sec.compare(ref.cview().section(sec_span)));
+		REQUIRE(arr.cache_stats().misses == 2);
+		
+		arr.csection(sec_span);
+		REQUIRE(arr.cache_stats().hits == 1);
+		
+		REQUIRE_THROWS(arr.csection(make_ndspan(make_ndptrdiff(1, 3, 4), make_ndptrdiff(3, 5, 7))));
+	}
+	
+	SECTION("write back") {
+		arr.section(make_ndspan(make_ndptrdiff(0, 0, 0), make_ndptrdiff(1, 1, 1)))[0][0][0] = -1;
+		ref[0][0][0] = -1;
+		arr.chunk(make_ndptrdiff(1, 0, 0))[1][2][3] = -2;
+		ref[3][2][3] = -2;
+		REQUIRE(arr.cache_stats().writebacks == 0);
+		arr.cchunk(make_ndptrdiff(2, 0, 0));
+		REQUIRE(arr.cache_stats().evictions == 1);
+		REQUIRE(arr.cache_stats().writebacks == 1);
+		arr.flush();
+		REQUIRE(arr.cache_stats().writebacks == 2);
+		
+		chunked_ndarray<3, int> arr2(path, shape, chunk_shape, 1);
+		REQUIRE(arr2.read(arr2.full_span()).compare(ref));
+		
+		arr.reset_cache_stats();
+		REQUIRE(arr.cache_stats().hits == 0);
+	}
+
+	SECTION("errors") {
+		using array_type = chunked_ndarray<3, int>;
+		REQUIRE_THROWS_AS(array_type(path, shape, make_ndsize(2, 2, 2), 1), const std::system_error&);
+		REQUIRE_THROWS_AS(array_type("/nonexistent/tlz_nd_test", shape, chunk_shape, 1), const std::system_error&);
+
+		// chunk that cannot be read does not stay in cache
+		REQUIRE(::truncate(path.c_str(), 2 * 3 * 4 * sizeof(int)) == 0);
+		arr.cchunk(make_ndptrdiff(0, 0, 0));
+		REQUIRE_THROWS_AS(arr.cchunk(make_ndptrdiff(2, 2, 2)), const std::system_error&);
+		REQUIRE(arr.resident_chunks() == 1);
+		REQUIRE_THROWS_AS(arr.cchunk(make_ndptrdiff(2, 2, 2)), const std::system_error&);
+		REQUIRE(arr.cache_stats().hits == 0);
+	}
+	
+	std::remove(path.c_str());
+}
+
+#endif
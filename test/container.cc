@@ -2,6 +2,7 @@
 #include <algorithm>
 #include "../src/ndarray.h"
 #include "../src/ndarray_view.h"
+#include "../src/ndarray_view_operations.h"
 #include "support/ndarray.h"
 
 using namespace tlz;
@@ -260,3 +261,235 @@ TEST_CASE("ndarray", "[nd][ndarray]") {
 		REQUIRE(obj_t::counter == 2*arr.size());
 	}
 }
+
+
+TEST_CASE("ndarray storage order", "[nd][ndarray]") {
+	constexpr std::ptrdiff_t l = sizeof(int);
+	auto shape = make_ndsize(3, 4, 5);
+
+	SECTION("order") {
+		ndarray_order<3> c;
+		REQUIRE(c.is_row_major());
+		REQUIRE(c.axes() == make_ndptrdiff(0, 1, 2));
+		ndarray_order<3> f = storage_order::column_major;
+		REQUIRE(f.is_column_major());
+		REQUIRE(f.axes() == make_ndptrdiff(2, 1, 0));
+		REQUIRE(f.innermost_axis() == 0);
+		REQUIRE(f.position(2) == 0);
+		REQUIRE(c != f);
+		ndarray_order<3> p(make_ndptrdiff(1, 0, 2));
+		REQUIRE(p.position(0) == 1);
+		REQUIRE_THROWS_AS(ndarray_order<3>(make_ndptrdiff(1, 1, 2)), const failed_assertion&);
+	}
+
+	SECTION("default strides") {
+		using view_type = ndarray_view<3, int>;
+		REQUIRE(view_type::default_strides(shape, storage_order::row_major) == view_type::default_strides(shape));
+		REQUIRE(view_type::default_strides(shape, storage_order::column_major) == make_ndptrdiff(l, 3*l, 3*4*l));
+		REQUIRE(view_type::default_strides(shape, storage_order::column_major, l) == make_ndptrdiff(2*l, 3*2*l, 3*4*2*l));
+		ndarray_order<3> p(make_ndptrdiff(1, 0, 2));
+		REQUIRE(view_type::default_strides(shape, p) == make_ndptrdiff(5*l, 3*5*l, l));
+
+		std::vector<int> raw(shape.product());
+		view_type vw(raw.data(), shape, view_type::default_strides(shape, p, l));
+		REQUIRE_FALSE(vw.has_default_strides());
+		REQUIRE(vw.has_default_strides(p));
+		REQUIRE(vw.default_strides_padding(p) == l);
+		REQUIRE_FALSE(vw.has_default_strides_without_padding(p));
+		REQUIRE(vw.strides_order() == p);
+
+		// axes of extent 1 do not change order
+		auto shape1 = make_ndsize(3, 1, 5);
+		REQUIRE(view_type(raw.data(), shape1).strides_order().is_row_major());
+		view_type vw1(raw.data(), shape1, view_type::default_strides(shape1, storage_order::column_major));
+		REQUIRE(vw1.has_default_strides(vw1.strides_order()));
+	}
+
+	SECTION("column-major ndarray") {
+		ndarray<3, int> arr(shape, storage_order::column_major);
+		REQUIRE(arr.shape() == shape);
+		REQUIRE(arr.strides() == make_ndptrdiff(l, 3*l, 3*4*l));
+		REQUIRE(arr.view().strides_order().is_column_major());
+		REQUIRE(arr.allocated_byte_size() == shape.product() * l);
+		int i = 0;
+		for(int& v : arr) v = i++;
+
+		// same layout as transposed row-major view
+		ndarray<3, int> row(shape);
+		row.view().assign(arr.view());
+		auto tr = swapaxis(ndarray_view<3, int>(arr.view().start(), make_ndsize(5, 4, 3)), 0, 2);
+		REQUIRE(tr.shape() == shape);
+		REQUIRE(tr == row.view());
+
+		// has POD format, compatible only with same order
+		REQUIRE(arr.has_pod_format());
+		REQUIRE(arr.pod_format() == row.pod_format());
+		REQUIRE(arr.view().strides_order() != row.view().strides_order());
+		REQUIRE(swapaxis(row.view(), 0, 1).has_pod_format());
+		REQUIRE_FALSE(row.view()(0, 3, 2).has_pod_format());
+
+		// copy keeps order
+		ndarray<3, int> copy = arr;
+		REQUIRE(copy.strides() == arr.strides());
+		REQUIRE(copy == arr);
+
+		ndarray<3, int> from_view(row.cview(), storage_order::column_major);
+		REQUIRE(from_view.strides() == arr.strides());
+		REQUIRE(from_view == row);
+	}
+}
+
+
+TEST_CASE("ndarray capacity", "[nd][ndarray]") {
+	constexpr std::size_t l = sizeof(int);
+	auto fill_index = [](ndarray<3, int>& arr) {
+		for(const auto& c : make_ndspan(arr.shape())) arr.at(c) = 10000 * c[0] + 100 * c[1] + c[2];
+	};
+	auto index_value = [](const ndptrdiff<3>& c) { return int(10000 * c[0] + 100 * c[1] + c[2]); };
+
+	SECTION("assign reuses buffer") {
+		ndarray<3, int> src(make_ndsize(4, 5, 6));
+		fill_index(src);
+		ndarray<3, int> arr(make_ndsize(4, 5, 6));
+		const int* buf = arr.start();
+		REQUIRE(arr.capacity() == 4*5*6);
+
+		arr.assign(src.cview().section(make_ndptrdiff(0, 0, 0), make_ndptrdiff(3, 5, 6)));
+		REQUIRE(arr.shape() == make_ndsize(3, 5, 6));
+		REQUIRE(arr.start() == buf);
+		REQUIRE(arr.capacity() == 4*5*6);
+		arr.assign(src.cview());
+		REQUIRE(arr.start() == buf);
+		REQUIRE(arr == src);
+
+		arr.shrink_to_fit();
+		REQUIRE(arr.capacity() == 4*5*6);
+		arr.assign(src.cview().section(make_ndptrdiff(0, 0, 0), make_ndptrdiff(2, 2, 2)));
+		arr.shrink_to_fit();
+		REQUIRE(arr.capacity() == 8);
+		REQUIRE(arr.allocated_byte_size() == 8*l);
+		REQUIRE(arr == src.cview().section(make_ndptrdiff(0, 0, 0), make_ndptrdiff(2, 2, 2)));
+
+		// copy allocates only what is needed
+		arr.reserve(100);
+		REQUIRE(arr.capacity() >= 100);
+		REQUIRE(arr == src.cview().section(make_ndptrdiff(0, 0, 0), make_ndptrdiff(2, 2, 2)));
+		ndarray<3, int> copy = arr;
+		REQUIRE(copy.allocated_byte_size() == 8*l);
+		copy = src;
+		REQUIRE(copy.allocated_byte_size() == 4*5*6*l);
+		REQUIRE(copy == src);
+
+		// capacity counts elements with padding
+		ndarray<3, int> padded(make_ndsize(4, 5, 6), l);
+		REQUIRE(padded.capacity() == 4*5*6);
+		padded.reserve(200);
+		REQUIRE(padded.allocated_byte_size() >= 200*2*l);
+		REQUIRE(padded.capacity() >= 200);
+		const int* padded_buf = padded.start();
+		padded.resize(make_ndsize(5, 5, 8));
+		REQUIRE(padded.start() == padded_buf);
+	}
+
+	SECTION("resize") {
+		ndarray<3, int> arr(make_ndsize(4, 5, 6));
+		const int* buf = arr.start();
+		arr.resize(make_ndsize(2, 3, 3));
+		REQUIRE(arr.shape() == make_ndsize(2, 3, 3));
+		REQUIRE((arr.strides() == ndarray_view<3, int>::default_strides(arr.shape())));
+		REQUIRE(arr.start() == buf);
+
+		// preserve, in place on outermost axis
+		arr.resize(make_ndsize(4, 5, 6));
+		REQUIRE(arr.start() == buf);
+		fill_index(arr);
+		arr.resize(make_ndsize(2, 5, 6), true);
+		REQUIRE(arr.start() == buf);
+		arr.resize(make_ndsize(3, 5, 6), true);
+		REQUIRE(arr.start() == buf);
+		for(const auto& c : make_ndspan(make_ndptrdiff(2, 5, 6))) REQUIRE(arr.at(c) == index_value(c));
+
+		// preserve, with other axes changing
+		arr.resize(make_ndsize(2, 7, 4), true);
+		REQUIRE(arr.shape() == make_ndsize(2, 7, 4));
+		for(const auto& c : make_ndspan(make_ndptrdiff(2, 5, 4))) REQUIRE(arr.at(c) == index_value(c));
+
+		// preserve, with other axes shrinking or growing, in place while the buffer is large enough
+		arr.resize(make_ndsize(4, 5, 6));
+		fill_index(arr);
+		buf = arr.start();
+		std::size_t allocated = arr.allocated_byte_size();
+		arr.resize(make_ndsize(3, 4, 2), true);
+		REQUIRE(arr.start() == buf);
+		REQUIRE(arr.allocated_byte_size() == allocated);
+		REQUIRE((arr.strides() == ndarray_view<3, int>::default_strides(arr.shape())));
+		for(const auto& c : make_ndspan(make_ndptrdiff(3, 4, 2))) REQUIRE(arr.at(c) == index_value(c));
+		arr.resize(make_ndsize(2, 5, 5), true);
+		REQUIRE(arr.start() == buf);
+		REQUIRE(arr.allocated_byte_size() == allocated);
+		for(const auto& c : make_ndspan(make_ndptrdiff(2, 4, 2))) REQUIRE(arr.at(c) == index_value(c));
+		arr.resize(make_ndsize(1, 3, 7), true);
+		REQUIRE(arr.start() == buf);
+		for(const auto& c : make_ndspan(make_ndptrdiff(1, 3, 2))) REQUIRE(arr.at(c) == index_value(c));
+		arr.resize(make_ndsize(2, 8, 8), true);
+		REQUIRE(arr.start() != buf);
+		for(const auto& c : make_ndspan(make_ndptrdiff(1, 3, 2))) REQUIRE(arr.at(c) == index_value(c));
+
+		// keeps storage order and padding
+		ndarray<3, int> f(make_ndsize(2, 3, 4), storage_order::column_major, l);
+		f.resize(make_ndsize(5, 3, 4));
+		REQUIRE((f.strides() == ndarray_view<3, int>::default_strides(make_ndsize(5, 3, 4), storage_order::column_major, l)));
+		fill_index(f);
+		f.resize(make_ndsize(5, 3, 2), true); // outermost axis in column-major order
+		for(const auto& c : make_ndspan(make_ndptrdiff(5, 3, 2))) REQUIRE(f.at(c) == index_value(c));
+		buf = f.start();
+		f.resize(make_ndsize(4, 2, 2), true);
+		REQUIRE(f.start() == buf);
+		REQUIRE((f.strides() == ndarray_view<3, int>::default_strides(make_ndsize(4, 2, 2), storage_order::column_major, l)));
+		for(const auto& c : make_ndspan(make_ndptrdiff(4, 2, 2))) REQUIRE(f.at(c) == index_value(c));
+		f.resize(make_ndsize(6, 3, 1), true);
+		REQUIRE(f.start() == buf);
+		for(const auto& c : make_ndspan(make_ndptrdiff(4, 2, 1))) REQUIRE(f.at(c) == index_value(c));
+	}
+
+	SECTION("non-POD") {
+		int counter = obj_t::counter;
+		{
+			ndarray<2, obj_t> arr(make_ndsize(4, 5));
+			REQUIRE(obj_t::counter == counter + 20);
+			for(auto& o : arr) o.i = 7;
+			arr.resize(make_ndsize(2, 5), true);
+			REQUIRE(obj_t::counter == counter + 10);
+			arr.resize(make_ndsize(3, 5), true);
+			REQUIRE(obj_t::counter == counter + 15);
+			REQUIRE(arr[1][4].i == 7);
+			arr.resize(make_ndsize(3, 6), true);
+			REQUIRE(obj_t::counter == counter + 18);
+			REQUIRE(arr[1][4].i == 7);
+			REQUIRE(arr[1][5].i == 0);
+			const obj_t* buf = arr.start();
+			arr.resize(make_ndsize(4, 4), true);
+			REQUIRE(arr.start() == buf);
+			REQUIRE(obj_t::counter == counter + 16);
+			REQUIRE(arr[1][3].i == 7);
+			REQUIRE(arr[3][0].i == 0);
+			arr.resize(make_ndsize(3, 5), true);
+			REQUIRE(arr.start() == buf);
+			REQUIRE(obj_t::counter == counter + 15);
+			REQUIRE(arr[1][3].i == 7);
+			REQUIRE(arr[1][4].i == 0);
+			for(auto& o : arr) o.i = 7;
+			arr.resize(make_ndsize(3, 6), true);
+			arr.reserve(100);
+			arr.shrink_to_fit();
+			REQUIRE(obj_t::counter == counter + 18);
+
+			ndarray<2, obj_t> other(make_ndsize(1, 1));
+			arr.assign(other.cview());
+			REQUIRE(obj_t::counter == counter + 2);
+			arr = ndarray<2, obj_t>(make_ndsize(2, 2));
+			REQUIRE(obj_t::counter == counter + 5);
+		}
+		REQUIRE(obj_t::counter == counter);
+	}
+}
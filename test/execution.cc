@@ -0,0 +1,147 @@
+#include <catch.hpp>
+#include <atomic>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "../src/ndarray_view.h"
+#include "../src/ndarray.h"
+#include "../src/ndarray_wraparound_view.h"
+#include "../src/ndarray_view_operations.h"
+#include "../src/execution.h"
+#include "support/ndarray.h"
+
+using namespace tlz;
+using namespace tlz::test;
+
+TEST_CASE("thread_pool", "[nd][execution]") {
+	thread_pool pool(3);
+	REQUIRE(pool.concurrency() == 4);
+	
+	SECTION("parallel_for") {
+		std::vector<int> done(1000, 0);
+		pool.parallel_for(done.size(), [&](std::size_t i) { done[i]++; });
+		for(int d : done) REQUIRE(d == 1);
+		
+		pool.parallel_for(0, [&](std::size_t) { FAIL(); });
+	}
+	
+	SECTION("nested") {
+		std::atomic<int> count(0);
+		pool.parallel_for(8, [&](std::size_t) {
+			pool.parallel_for(8, [&](std::size_t) { count++; });
+		});
+		REQUIRE(count == 64);
+	}
+	
+	SECTION("exception") {
+		std::atomic<int> count(0);
+		REQUIRE_THROWS_AS(pool.parallel_for(100, [&](std::size_t i) {
+			count++;
+			if(i == 10) throw std::runtime_error("test");
+		}), const std::runtime_error&);
+		
+		// without helpers, remaining indices are skipped after the exception
+		thread_pool serial_pool(0);
+		count = 0;
+		REQUIRE_THROWS_AS(serial_pool.parallel_for(100, [&](std::size_t i) {
+			count++;
+			if(i == 10) throw std::runtime_error("test");
+		}), const std::runtime_error&);
+		REQUIRE(count == 11);
+	}
+	
+	SECTION("default pool") {
+		REQUIRE(thread_pool::default_pool().concurrency() >= 1);
+	}
+}
+
+
+TEST_CASE("ndarray_view parallel execution", "[nd][execution]") {
+	thread_pool pool(3);
+	auto exec = execution::par.on(pool).with_min_block_size(64);
+	REQUIRE(&exec.pool() == &pool);
+	
+	auto shape = make_ndsize(1, 40, 30, 3);
+	ndarray<4, int> a(shape), b(shape);
+	int i = 0;
+	for(int& v : a) v = i++;
+	
+	SECTION("assign, compare") {
+		b.view().assign(exec, a.cview());
+		REQUIRE(b.cview().compare(a.cview()));
+		REQUIRE(b.cview().compare(exec, a.cview()));
+		REQUIRE(b.cview().compare(execution::seq, a.cview()));
+		REQUIRE(b.cview().compare(execution::par_unseq.on(pool).with_min_block_size(64), a.cview()));
+		
+		b.view()[0][39][29][2] = -1;
+		REQUIRE_FALSE(b.cview().compare(exec, a.cview()));
+		b.view()[0][0][0][0] = -1;
+		REQUIRE_FALSE(b.cview().compare(exec, a.cview()));
+		REQUIRE_FALSE(b.cview().compare(exec, a.cview()()(0, 20)));
+		
+		b.view().assign(execution::seq, a.cview());
+		REQUIRE(b.cview().compare(a.cview()));
+	}
+	
+	SECTION("strided") {
+		b.view().fill(-1);
+		auto b_sec = b.view()()(0, 20, 2);
+		auto a_sec = a.cview()()(10, 30, 2);
+		b_sec.assign(exec, a_sec);
+		REQUIRE(b_sec.compare(exec, a_sec));
+		REQUIRE_FALSE(b.cview()()(1, 20, 2).compare(exec, a_sec));
+	}
+	
+	SECTION("partition axis") {
+		// blocks are cut along the outermost non-degenerate axis in memory of the written view
+		auto a3 = a.view()[0];
+		REQUIRE(detail::make_axis_partition(exec, a3.shape(), a3.strides(), sizeof(int)).axis == 0);
+		REQUIRE(detail::make_axis_partition(exec, a3.shape(), sizeof(int)).axis == 0);
+		auto swp = swapaxis(a3, 0, 2);
+		REQUIRE(detail::make_axis_partition(exec, swp.shape(), swp.strides(), sizeof(int)).axis == 2);
+		REQUIRE(detail::make_axis_partition(exec, swp.shape(), sizeof(int)).axis == 0);
+		auto rev = reverse(swp, 2);
+		REQUIRE(detail::make_axis_partition(exec, rev.shape(), rev.strides(), sizeof(int)).axis == 2);
+		REQUIRE(detail::make_axis_partition(exec, a.shape(), a.strides(), sizeof(int)).axis == 1);
+
+		ndarray<3, int> f(a3.shape(), storage_order::column_major);
+		REQUIRE(detail::make_axis_partition(exec, f.shape(), f.strides(), sizeof(int)).axis == 2);
+		f.view().assign(exec, a3);
+		REQUIRE(f.cview().compare(exec, a3));
+		auto b_swp = swapaxis(b.view()[0], 0, 2);
+		b_swp.assign(exec, swapaxis(a.cview()[0], 0, 2));
+		REQUIRE(b.cview().compare(a.cview()));
+	}
+
+	SECTION("wraparound") {
+		auto a3 = a.cview()[0];
+		auto w = wraparound(a3, make_ndptrdiff(35, 20, 1), make_ndptrdiff(75, 50, 4));
+		ndarray<3, int> c(w.shape());
+		c.view().assign(exec, w);
+		REQUIRE(c.cview().compare(w));
+		REQUIRE(c.cview().compare(exec, w));
+	}
+	
+	SECTION("fill") {
+		b.view().fill(exec, 7);
+		for(int v : b.cview()) REQUIRE(v == 7);
+		b.view().fill(execution::seq, 8);
+		for(int v : b.cview()) REQUIRE(v == 8);
+	}
+	
+	SECTION("non-POD") {
+		ndarray<2, std::string> s1(make_ndsize(50, 10)), s2(make_ndsize(50, 10));
+		s1.view().fill(exec, "abc");
+		s2.view().assign(exec, s1.cview());
+		REQUIRE(s2.cview().compare(exec, s1.cview()));
+		s2.view()[49][9] = "def";
+		REQUIRE_FALSE(s2.cview().compare(exec, s1.cview()));
+	}
+	
+	SECTION("small views serial") {
+		auto small = execution::par.on(pool);
+		REQUIRE(small.min_block_size() > shape.product() * sizeof(int));
+		b.view().assign(small, a.cview());
+		REQUIRE(b.cview().compare(small, a.cview()));
+	}
+}
@@ -0,0 +1,118 @@
+#include <catch.hpp>
+#include <cstdint>
+#include <string>
+#include "../src/ndarray_view.h"
+#include "../src/ndarray.h"
+#include "../src/ndarray_wraparound_view.h"
+#include "../src/ndarray_view_operations.h"
+#include "../src/ndarray_expression.h"
+#include "support/ndarray.h"
+
+using namespace tlz;
+using namespace tlz::test;
+
+TEST_CASE("ndarray_expression", "[nd][ndarray_expression]") {
+	auto shape = make_ndsize(3, 4, 5);
+	ndarray<3, int> a(shape), b(shape);
+	int i = 0;
+	for(int& v : a) v = i++;
+	for(int& v : b) v = 2 * (i--);
+	
+	auto expect = [&](const auto& result, auto func) {
+		for(const auto& c : make_ndspan(shape)) REQUIRE(result.at(c) == func(a.at(c), b.at(c)));
+	};
+	
+	SECTION("lazy") {
+		auto expr = a.cview() + b.cview() * 2;
+		REQUIRE(is_ndarray_expression<decltype(expr)>::value);
+		REQUIRE(expr.shape() == shape);
+		REQUIRE(expr.at(make_ndptrdiff(1, 2, 3)) == a[1][2][3] + b[1][2][3] * 2);
+		REQUIRE(decltype(expr)::leaf_count == 2);
+		REQUIRE(decltype(expr)::is_strided);
+	}
+	
+	SECTION("arithmetic") {
+		ndarray<3, int> c(shape);
+		c.view() = a.cview() + b.cview() * 2;
+		expect(c, [](int x, int y) { return x + y * 2; });
+		
+		c.view() = 3 - a + (b / 2) % 7;
+		expect(c, [](int x, int y) { return 3 - x + (y / 2) % 7; });
+		
+		c.view() = -a ^ (b & 0xff) | 1;
+		expect(c, [](int x, int y) { return -x ^ (y & 0xff) | 1; });
+		
+		c.view().assign(~a);
+		expect(c, [](int x, int) { return ~x; });
+	}
+	
+	SECTION("construct ndarray") {
+		ndarray<3, int> c(a * b);
+		expect(c, [](int x, int y) { return x * y; });
+		REQUIRE(c.view().has_default_strides());
+		
+		auto d = evaluate(a - b);
+		REQUIRE((std::is_same<decltype(d), ndarray<3, int>>::value));
+		expect(d, [](int x, int y) { return x - y; });
+		
+		ndarray<2, int> e(make_ndsize(2, 2));
+		e = a[0] + a[1];
+		REQUIRE(e.shape() == make_ndsize(4, 5));
+		REQUIRE(e[3][4] == a[0][3][4] + a[1][3][4]);
+		
+		// in place
+		ndarray<3, int> f = a;
+		const int* f_start = f.start();
+		f = f + f * b;
+		REQUIRE(f.start() == f_start);
+		expect(f, [](int x, int y) { return x + x * y; });
+	}
+	
+	SECTION("where, cast, comparison") {
+		ndarray<3, int> c(where(a < b, a, b));
+		expect(c, [](int x, int y) { return x < y ? x : y; });
+		
+		ndarray<3, bool> m(elementwise_equal(a % 3, 0));
+		for(const auto& co : make_ndspan(shape)) REQUIRE(m.at(co) == (a.at(co) % 3 == 0));
+		
+		ndarray<3, float> fl(elementwise_cast<float>(a) / 2.0f);
+		for(const auto& co : make_ndspan(shape)) REQUIRE(fl.at(co) == a.at(co) / 2.0f);
+		
+		ndarray<3, std::uint8_t> u8(elementwise_cast<std::uint8_t>(where(a > 255, 255, a)));
+		for(const auto& co : make_ndspan(shape)) REQUIRE(u8.at(co) == std::min(a.at(co), 255));
+		
+		ndarray<3, std::string> s(elementwise([](int x) { return std::to_string(x); }, a));
+		REQUIRE(s[1][2][3] == std::to_string(a[1][2][3]));
+	}
+	
+	SECTION("strided operands") {
+		auto a_sec = swapaxis(a.cview()(0, 3)(0, 4, 2)(1, 5), 0, 2);
+		auto b_sec = reverse(swapaxis(b.cview()()(2, 4)(0, 4), 0, 2), 1);
+		REQUIRE(a_sec.shape() == b_sec.shape());
+		ndarray<3, int> c(a_sec.shape());
+		auto c_sec = reverse(c.view());
+		c_sec = a_sec * 3 + b_sec;
+		for(const auto& co : make_ndspan(a_sec.shape())) REQUIRE(c_sec.at(co) == a_sec.at(co) * 3 + b_sec.at(co));
+	}
+	
+	SECTION("wraparound operands") {
+		auto w = wraparound(a.cview(), make_ndptrdiff(1, 2, 3), make_ndptrdiff(4, 6, 8));
+		auto expr = w + a.cview();
+		REQUIRE_FALSE(decltype(expr)::is_strided);
+		ndarray<3, int> c(expr);
+		for(const auto& co : make_ndspan(shape)) REQUIRE(c.at(co) == w.at(co) + a.at(co));
+	}
+	
+	SECTION("parallel") {
+		thread_pool pool(2);
+		ndarray<3, int> c(shape);
+		c.view().assign(execution::par.on(pool).with_min_block_size(16), a * 2 + b);
+		expect(c, [](int x, int y) { return x * 2 + y; });
+	}
+	
+	SECTION("shape mismatch") {
+		REQUIRE_THROWS(a.cview() + a.cview()(0, 2));
+		ndarray<3, int> c(make_ndsize(3, 4, 4));
+		REQUIRE_THROWS(c.view().assign(a + b));
+	}
+}
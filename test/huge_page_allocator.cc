@@ -0,0 +1,68 @@
+#include <catch.hpp>
+#include "../src/config.h"
+#if TLZ_ND_WITH_MMAP
+#include "../src/allocator/huge_page_allocator.h"
+#include "../src/ndarray.h"
+#include "../src/opaque/ndarray_opaque.h"
+#include "../src/opaque_format/raw.h"
+#include "support/ndarray.h"
+#include <cstring>
+
+using namespace tlz;
+using namespace tlz::test;
+
+TEST_CASE("huge_page_allocator", "[nd][huge_page_allocator]") {
+	std::size_t huge_page = huge_page_allocator::huge_page_size();
+	REQUIRE(is_power_of_two(huge_page));
+
+	SECTION("raw allocation") {
+		for(huge_page_mode mode : { huge_page_mode::normal, huge_page_mode::transparent, huge_page_mode::hugetlb }) {
+			huge_page_allocator alloc(mode, true, true);
+			std::size_t size = huge_page + 100;
+			int* buf = static_cast<int*>(alloc.raw_allocate(size, alignof(int)));
+			REQUIRE(is_aligned(buf, huge_page));
+
+			// obtained mode is at most the requested one
+			const huge_page_allocation& obtained = alloc.last_allocation();
+			REQUIRE(static_cast<int>(obtained.mode) <= static_cast<int>(mode));
+			if(mode == huge_page_mode::normal) REQUIRE(obtained.mode == huge_page_mode::normal);
+			REQUIRE(obtained.populated);
+
+			std::size_t n = size / sizeof(int);
+			bool zero = true, equal = true;
+			for(std::size_t i = 0; i < n; ++i) zero = zero && (buf[i] == 0);
+			for(std::size_t i = 0; i < n; ++i) buf[i] = i;
+			for(std::size_t i = 0; i < n; ++i) equal = equal && (buf[i] == i);
+			REQUIRE(zero);
+			REQUIRE(equal);
+			alloc.raw_deallocate(buf, size);
+		}
+	}
+
+	SECTION("not populated") {
+		huge_page_allocator alloc;
+		void* buf = alloc.raw_allocate(10);
+		REQUIRE_FALSE(alloc.last_allocation().populated);
+		REQUIRE_FALSE(alloc.last_allocation().locked);
+		alloc.raw_deallocate(buf, 10);
+	}
+
+	SECTION("ndarray") {
+		ndarray<2, int, huge_page_allocator> arr(make_ndsize(300, 300), 0, huge_page_allocator(huge_page_mode::transparent, true));
+		REQUIRE(arr.get_allocator().last_allocation().populated);
+		REQUIRE(is_aligned(arr.start(), huge_page));
+		for(auto coord : make_ndspan(arr.shape())) arr.at(coord) = coord[0] + coord[1];
+		ndarray<2, int, huge_page_allocator> arr2 = std::move(arr);
+		REQUIRE(arr2.get_allocator().requested_mode() == huge_page_mode::transparent);
+		REQUIRE(arr2[299][299] == 598);
+	}
+
+	SECTION("ndarray_opaque") {
+		opaque_raw_format frm(1000, 64);
+		ndarray_opaque<1, opaque_raw_format, huge_page_allocator> arr(make_ndsize(100), frm, 0, huge_page_allocator(huge_page_mode::hugetlb));
+		REQUIRE(is_aligned(arr.start(), 64));
+		std::memset(arr.start(), 1, 100 * 1000);
+	}
+}
+
+#endif
@@ -0,0 +1,128 @@
+#include <catch.hpp>
+#include <thread>
+#include "../src/instrumentation.h"
+#include "../src/ndarray.h"
+#include "../src/ndarray_wraparound_view.h"
+#include "../src/ndarray_tiled.h"
+#include "../src/opaque/ndarray_opaque.h"
+#include "../src/opaque_format/raw.h"
+#include "../src/opaque_format/ndarray.h"
+#include "support/ndarray.h"
+
+using namespace tlz;
+using namespace tlz::test;
+
+#if TLZ_ND_WITH_INSTRUMENTATION
+
+TEST_CASE("instrumentation", "[nd][instrumentation]") {
+	REQUIRE(instrumentation_enabled);
+	REQUIRE(std::string(instrumented_path_name(instrumented_path::view_assign_pod)) == "view_assign_pod");
+	REQUIRE(std::string(instrumented_path_name(instrumented_path::deallocation)) == "deallocation");
+
+	reset_instrumentation();
+	REQUIRE(thread_instrumentation_totals()[instrumented_path::view_assign_pod].calls == 0);
+
+	SECTION("view") {
+		ndarray<2, int> a(make_ndsize(4, 5)), b(make_ndsize(4, 5));
+		auto alloc = thread_instrumentation_totals()[instrumented_path::allocation];
+		REQUIRE(alloc.calls == 2);
+		REQUIRE(alloc.bytes >= 2 * 4 * 5 * sizeof(int));
+
+		a.view().assign(b.cview());
+		REQUIRE(a.view().compare(b.cview()));
+		auto snap = thread_instrumentation_totals();
+		REQUIRE(snap[instrumented_path::view_assign_pod].calls == 1);
+		REQUIRE(snap[instrumented_path::view_assign_pod].bytes == 4 * 5 * sizeof(int));
+		REQUIRE(snap[instrumented_path::view_compare_pod].calls == 1);
+		REQUIRE(snap[instrumented_path::view_assign_runs].calls == 0);
+
+		// non-POD elements
+		std::vector<obj_t> raw1(6), raw2(6);
+		ndarray_view<2, obj_t> o1(raw1.data(), make_ndsize(2, 3)), o2(raw2.data(), make_ndsize(2, 3));
+		o1.assign(o2);
+		snap = thread_instrumentation_totals();
+		REQUIRE(snap[instrumented_path::view_assign_runs].calls == 1);
+		REQUIRE(snap[instrumented_path::view_assign_runs].bytes == 6 * sizeof(obj_t));
+
+		// wraparound operand gets split into segments, which are assigned with POD path
+		a.view().assign(wraparound(b.cview(), make_ndptrdiff(2, 2), make_ndptrdiff(6, 7)));
+		snap = thread_instrumentation_totals();
+		REQUIRE(snap[instrumented_path::view_assign_segments].calls == 1);
+		REQUIRE(snap[instrumented_path::view_assign_pod].calls == 1 + 4);
+
+		// iterating over non-contiguous section recomputes pointer at each row
+		int sum = 0;
+		for(int x : a.view()()(1, 3)) sum += x;
+		REQUIRE(thread_instrumentation_totals()[instrumented_path::iterator_recompute].calls == 4);
+
+		// tiled arrays allocate through the same buffer
+		{
+			ndarray_tiled<2, int> tiled(make_ndsize(5, 5), make_ndsize(4, 4));
+			snap = thread_instrumentation_totals();
+			REQUIRE(snap[instrumented_path::allocation].calls == 3);
+			REQUIRE(snap[instrumented_path::allocation].bytes == 2 * 4 * 5 * sizeof(int) + 4 * 16 * sizeof(int));
+		}
+		REQUIRE(thread_instrumentation_totals()[instrumented_path::deallocation].calls == 1);
+	}
+
+	SECTION("opaque") {
+		opaque_raw_format frm(sizeof(int), alignof(int));
+		ndarray_opaque<1, opaque_raw_format> a(make_ndsize(10), frm), b(make_ndsize(10), frm);
+		a.view().assign(b.cview());
+		auto snap = thread_instrumentation_totals();
+		REQUIRE(snap[instrumented_path::opaque_assign_pod_strided].calls == 1);
+		REQUIRE(snap[instrumented_path::opaque_assign_pod_strided].bytes == 10 * sizeof(int));
+
+		// single frame
+		a.view()[1] = b.cview()[2];
+		REQUIRE(a.view()[1] == b.cview()[2]);
+		snap = thread_instrumentation_totals();
+		REQUIRE(snap[instrumented_path::opaque_assign_pod_contiguous].calls == 1);
+		REQUIRE(snap[instrumented_path::opaque_assign_pod_contiguous].bytes == sizeof(int));
+		REQUIRE(snap[instrumented_path::opaque_compare_pod_contiguous].calls == 1);
+	}
+
+	SECTION("frame handles") {
+		// self-assignment and self-comparison are not counted, with both frame formats
+		int raw[2] = { 1, 2 };
+		opaque_raw_format raw_frm(sizeof(int), alignof(int));
+		opaque_raw_frame_handle<true> r0(&raw[0], raw_frm), r1(&raw[1], raw_frm);
+		r0.assign(r0);
+		REQUIRE(r0.compare(r0));
+		r0.assign(r1);
+		REQUIRE(r0.compare(r1));
+
+		opaque_ndarray_format nd_frm = default_opaque_ndarray_format<int>(make_ndsize(1));
+		opaque_ndarray_frame_handle<true> n0(&raw[0], nd_frm), n1(&raw[1], nd_frm);
+		n0.assign(n0);
+		REQUIRE(n0.compare(n0));
+		n0.assign(n1);
+		REQUIRE(n0.compare(n1));
+
+		auto snap = thread_instrumentation_totals();
+		REQUIRE(snap[instrumented_path::frame_handle_assign].calls == 2);
+		REQUIRE(snap[instrumented_path::frame_handle_assign].bytes == 2 * sizeof(int));
+		REQUIRE(snap[instrumented_path::frame_handle_compare].calls == 2);
+		REQUIRE(snap[instrumented_path::frame_handle_compare].bytes == 2 * sizeof(int));
+	}
+
+	SECTION("threads") {
+		std::thread thread([] {
+			ndarray<1, float> a(make_ndsize(100)), b(make_ndsize(100));
+			a.view().assign(b.cview());
+		});
+		thread.join();
+
+		// counters of the ended thread are included in totals, but not in those of this thread
+		auto totals = instrumentation_totals();
+		REQUIRE(totals[instrumented_path::view_assign_pod].calls >= 1);
+		REQUIRE(totals[instrumented_path::view_assign_pod].bytes >= 100 * sizeof(float));
+		REQUIRE(totals[instrumented_path::deallocation].calls >= 2);
+		REQUIRE(thread_instrumentation_totals()[instrumented_path::view_assign_pod].calls == 0);
+
+		reset_instrumentation();
+		REQUIRE(instrumentation_totals()[instrumented_path::view_assign_pod].calls == 0);
+	}
+}
+
+#endif
@@ -0,0 +1,174 @@
+#include <catch.hpp>
+#include "../src/config.h"
+#if TLZ_ND_WITH_MMAP
+#include <cstdint>
+#include <cstdlib>
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <system_error>
+#include <unistd.h>
+#include "../src/mapped_file.h"
+#include "../src/mapped_ndarray.h"
+#include "../src/ndarray_view_operations.h"
+#include "../src/opaque/mapped_ndarray_opaque.h"
+#include "../src/opaque/ndarray_opaque_view_cast.h"
+#include "../src/opaque_format/ndarray.h"
+#include "support/ndarray.h"
+
+using namespace tlz;
+using namespace tlz::test;
+
+namespace {
+
+class temporary_file_ {
+private:
+	std::string path_;
+
+public:
+	temporary_file_() {
+		char path[] = "/tmp/tlz_nd_test_XXXXXX";
+		int fd = ::mkstemp(path);
+		REQUIRE(fd != -1);
+		::close(fd);
+		path_ = path;
+	}
+	~temporary_file_() { std::remove(path_.c_str()); }
+	
+	const std::string& path() const { return path_; }
+	
+	template<typename T>
+	void write(const std::vector<T>& data, std::size_t header = 0) {
+		std::ofstream str(path_, std::ios::binary | std::ios::trunc);
+		std::vector<char> head(header, 'x');
+		str.write(head.data(), header);
+		str.write(reinterpret_cast<const char*>(data.data()), data.size() * sizeof(T));
+	}
+	
+	template<typename T>
+	T read(std::size_t offset) const {
+		std::ifstream str(path_, std::ios::binary);
+		str.seekg(offset);
+		T value;
+		str.read(reinterpret_cast<char*>(&value), sizeof(T));
+		return value;
+	}
+};
+
+}
+
+
+TEST_CASE("mapped_file", "[nd][mapped_file]") {
+	temporary_file_ tmp;
+	std::vector<std::int32_t> raw(5000);
+	for(std::size_t i = 0; i < raw.size(); ++i) raw[i] = i;
+	tmp.write(raw);
+	
+	SECTION("read-only") {
+		mapped_file file(tmp.path(), mapped_file_mode::read_only, 3 * sizeof(std::int32_t));
+		REQUIRE(file.size() == (5000 - 3) * sizeof(std::int32_t));
+		REQUIRE_FALSE(file.is_writable());
+		const std::int32_t* data = static_cast<const std::int32_t*>(file.data());
+		REQUIRE(data[0] == 3);
+		REQUIRE(data[4000] == 4003);
+		file.advise(mapped_access_hint::sequential);
+		file.advise(mapped_access_hint::random, 100, 5000);
+		
+		mapped_file moved = std::move(file);
+		REQUIRE(file.is_null());
+		REQUIRE(static_cast<const std::int32_t*>(moved.data())[1] == 4);
+	}
+	
+	SECTION("read-write") {
+		mapped_file file(tmp.path(), mapped_file_mode::read_write, 2000 * sizeof(std::int32_t), 10 * sizeof(std::int32_t));
+		REQUIRE(file.size() == 10 * sizeof(std::int32_t));
+		static_cast<std::int32_t*>(file.data())[1] = -1;
+		file.flush();
+		REQUIRE(tmp.read<std::int32_t>(2001 * sizeof(std::int32_t)) == -1);
+	}
+	
+	SECTION("copy-on-write") {
+		mapped_file file(tmp.path(), mapped_file_mode::copy_on_write);
+		static_cast<std::int32_t*>(file.data())[1] = -1;
+		file.flush();
+		REQUIRE(tmp.read<std::int32_t>(sizeof(std::int32_t)) == 1);
+	}
+	
+	SECTION("create") {
+		temporary_file_ tmp2;
+		mapped_file file = mapped_file::create(tmp2.path(), 100);
+		REQUIRE(file.size() == 100);
+		static_cast<char*>(file.data())[99] = 'a';
+		file.flush();
+		REQUIRE(tmp2.read<char>(99) == 'a');
+	}
+	
+	SECTION("errors") {
+		REQUIRE_THROWS_AS(mapped_file("/nonexistent/tlz_nd_test"), const std::system_error&);
+		REQUIRE_THROWS_AS(mapped_file(tmp.path(), mapped_file_mode::read_only, 4000 * 4, 2000 * 4), const std::system_error&);
+	}
+}
+
+
+TEST_CASE("mapped_ndarray", "[nd][mapped_ndarray]") {
+	temporary_file_ tmp;
+	auto shape = make_ndsize(4, 5, 6);
+	std::size_t header = 10;
+	std::vector<std::int16_t> raw(shape.product());
+	for(std::size_t i = 0; i < raw.size(); ++i) raw[i] = i;
+	tmp.write(raw, header);
+	ndarray_view<3, std::int16_t> raw_vw(raw.data(), shape);
+	
+	using const_array_type = mapped_ndarray<3, const std::int16_t>;
+	using array_type = mapped_ndarray<3, std::int16_t>;
+	
+	SECTION("read-only") {
+		const_array_type arr(tmp.path(), shape, mapped_file_mode::read_only, header);
+		REQUIRE(arr.shape() == shape);
+		REQUIRE(arr.view().compare(raw_vw));
+		REQUIRE(arr.view()[2][3][4] == raw_vw[2][3][4]);
+		arr.advise(mapped_access_hint::sequential);
+		
+		REQUIRE_THROWS(const_array_type(tmp.path(), shape, mapped_file_mode::read_only, header + 1));
+		REQUIRE_THROWS(const_array_type(tmp.path(), shape, mapped_file_mode::read_only, header + 2));
+		REQUIRE_THROWS(array_type(tmp.path(), shape, mapped_file_mode::read_only, header));
+	}
+	
+	SECTION("strides") {
+		auto raw_sec = reverse(swapaxis(raw_vw()()(1, 4), 0, 2), 1);
+		std::ptrdiff_t offset = header + raw_ptr_difference(raw_sec.start(), raw.data());
+		mapped_ndarray<3, const std::int16_t> arr(tmp.path(), raw_sec.shape(), raw_sec.strides(), mapped_file_mode::read_only, offset);
+		REQUIRE(arr.view().compare(raw_sec));
+	}
+	
+	SECTION("read-write") {
+		mapped_ndarray<3, std::int16_t> arr(tmp.path(), shape, mapped_file_mode::read_write, header);
+		arr.view()[1][2][3] = -1;
+		arr.flush();
+		REQUIRE(tmp.read<std::int16_t>(header + sizeof(std::int16_t) * (1*30 + 2*6 + 3)) == -1);
+	}
+	
+	SECTION("create") {
+		temporary_file_ tmp2;
+		auto arr = mapped_ndarray<3, std::int16_t>::create(tmp2.path(), shape);
+		arr.view().assign(raw_vw);
+		arr.flush();
+		mapped_ndarray<3, const std::int16_t> arr2(tmp2.path(), shape);
+		REQUIRE(arr2.view().compare(raw_vw));
+	}
+	
+	SECTION("opaque") {
+		opaque_ndarray_format frm = default_opaque_ndarray_format<std::int16_t>(make_ndsize(5, 6));
+		mapped_ndarray_opaque<1, false, opaque_ndarray_format> arr(tmp.path(), make_ndsize(4), frm, mapped_file_mode::read_only, header);
+		REQUIRE(arr.shape() == make_ndsize(4));
+		ndarray_view<3, const std::int16_t> arr_c = from_opaque<3, const std::int16_t>(arr.view());
+		REQUIRE(arr_c.compare(raw_vw));
+		
+		mapped_ndarray_opaque<1, true, opaque_ndarray_format> arr_w(tmp.path(), make_ndsize(4), frm, mapped_file_mode::copy_on_write, header);
+		from_opaque<3, std::int16_t>(arr_w.view())[0][0][1] = -1;
+		REQUIRE(tmp.read<std::int16_t>(header + sizeof(std::int16_t)) == 1);
+	}
+}
+
+#endif
@@ -0,0 +1,105 @@
+#include <catch.hpp>
+#include "../src/config.h"
+#if TLZ_ND_WITH_MMAP
+#include "../src/allocator/mirrored_ring_allocator.h"
+#include "../src/ndarray_wraparound_view.h"
+#include "../src/opaque/ndarray_wraparound_opaque_view.h"
+#include "../src/opaque/ndarray_wraparound_opaque_view_cast.h"
+#include "../src/opaque/ndarray_opaque_view_cast.h"
+#include "../src/opaque_format/ndarray.h"
+#include "support/ndarray.h"
+
+using namespace tlz;
+using namespace tlz::test;
+
+TEST_CASE("mirrored_ring_allocator", "[nd][mirrored_ring_allocator]") {
+	std::size_t page = mirrored_ring_allocator::size_granularity();
+	REQUIRE(is_power_of_two(page));
+	
+	SECTION("raw allocation") {
+		mirrored_ring_allocator alloc;
+		std::size_t size = 2 * page;
+		int* buf = static_cast<int*>(alloc.raw_allocate(size, alignof(int)));
+		int* mirror = advance_raw_ptr(buf, size);
+		std::size_t n = size / sizeof(int);
+		for(std::size_t i = 0; i < n; ++i) buf[i] = i;
+		for(std::size_t i = 0; i < n; ++i) REQUIRE(mirror[i] == i);
+		mirror[3] = -1;
+		REQUIRE(buf[3] == -1);
+		alloc.raw_deallocate(buf, size);
+		
+		REQUIRE_THROWS(alloc.raw_allocate(page + 1));
+		REQUIRE_THROWS(alloc.raw_allocate(0));
+	}
+	
+	SECTION("ring length") {
+		REQUIRE(mirrored_ring_length(1, 1) == page);
+		REQUIRE(mirrored_ring_length(page + 1, 1) == 2*page);
+		REQUIRE(mirrored_ring_length(1, page) == 1);
+		REQUIRE(mirrored_ring_length(5, 2*page) == 5);
+		REQUIRE(mirrored_ring_length(10, sizeof(int)) == page / sizeof(int));
+		std::size_t len = mirrored_ring_length(100, 12);
+		REQUIRE(len >= 100);
+		REQUIRE(is_multiple_of(len * 12, page));
+		REQUIRE_FALSE(is_multiple_of((len - 1) * 12, page));
+	}
+}
+
+
+TEST_CASE("mirrored_section", "[nd][mirrored_ring_allocator]") {
+	SECTION("ndarray") {
+		std::size_t n = mirrored_ring_length(100, sizeof(int));
+		ndarray<1, int, mirrored_ring_allocator> ring(make_ndsize(n));
+		for(std::ptrdiff_t i = 0; i < n; ++i) ring[i] = i;
+		
+		ndarray_view<1, int> sec = mirrored_section(ring, n - 3, n + 5);
+		REQUIRE(sec.shape().front() == 8);
+		REQUIRE(sec.has_default_strides());
+		REQUIRE(sec.compare(wraparound(ring.view(), make_ndptrdiff(n - 3), make_ndptrdiff(n + 5))));
+		for(std::ptrdiff_t i = 0; i < 8; ++i) REQUIRE(sec[i] == positive_modulo(n - 3 + i, n));
+		
+		sec[5] = -1;
+		REQUIRE(ring[2] == -1);
+		
+		REQUIRE(mirrored_section(ring, -3, 5).start() == sec.start());
+		REQUIRE(mirrored_section(ring, 2*n - 3, 2*n + 5).start() == sec.start());
+		REQUIRE(mirrored_section(ring, 4, 4 + n).shape().front() == n);
+		REQUIRE_THROWS(mirrored_section(ring, 4, 5 + n));
+		
+		const auto& cring = ring;
+		ndarray_view<1, const int> csec = mirrored_section(cring, n - 3, n + 5);
+		REQUIRE(same(csec, ndarray_view<1, const int>(sec)));
+	}
+	
+	SECTION("ndarray_opaque") {
+		auto frame_shape = make_ndsize(3, 5);
+		opaque_ndarray_format frm = default_opaque_ndarray_format<int>(frame_shape);
+		std::size_t pad = sizeof(int);
+		std::size_t n = mirrored_ring_length(10, frm.size() + pad);
+		REQUIRE(is_multiple_of(n * (frm.size() + pad), mirrored_ring_allocator::size_granularity()));
+		
+		ndarray_opaque<1, opaque_ndarray_format, mirrored_ring_allocator> ring(make_ndsize(n), frm, pad);
+		ndarray_view<3, int> ring_c = from_opaque<3, int>(ring.view());
+		for(std::ptrdiff_t i = 0; i < n; ++i)
+			for(const auto& c : make_ndspan(frame_shape)) ring_c[i][c[0]][c[1]] = 100*i + 10*c[0] + c[1];
+		
+		std::ptrdiff_t start = n - 2, end = n + 4;
+		auto sec = mirrored_section(ring, start, end);
+		auto sec_w = wraparound(ring.view(), make_ndptrdiff(start), make_ndptrdiff(end));
+		REQUIRE(sec.shape().front() == 6);
+		REQUIRE(sec.compare(sec_w));
+		
+		ndarray_view<3, int> sec_c = from_opaque<3, int>(sec);
+		ndarray_wraparound_view<3, int> sec_wc = from_opaque<3, int>(sec_w);
+		REQUIRE(sec_c.compare(sec_wc));
+		REQUIRE(sec_c[3][2][4] == 100*1 + 10*2 + 4);
+		
+		sec_c[4][0][0] = -1;
+		REQUIRE(ring_c[2][0][0] == -1);
+		
+		auto csec = mirrored_section(static_cast<const decltype(ring)&>(ring), start, end);
+		REQUIRE(csec.start() == sec.start());
+	}
+}
+
+#endif
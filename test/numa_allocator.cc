@@ -0,0 +1,82 @@
+#include <catch.hpp>
+#include <atomic>
+#include "../src/config.h"
+#if TLZ_ND_WITH_MMAP
+#include "../src/allocator/numa_allocator.h"
+#include "../src/ndarray.h"
+#include "../src/ndarray_view_operations.h"
+#include "support/ndarray.h"
+#include <cstring>
+#include <unistd.h>
+
+using namespace tlz;
+using namespace tlz::test;
+
+TEST_CASE("numa_allocator", "[nd][numa_allocator]") {
+	std::size_t nodes = numa_node_count();
+	REQUIRE(nodes >= 1);
+
+	SECTION("run on nodes") {
+		std::vector<std::atomic<int>> calls(nodes);
+		for(auto& c : calls) c = 0;
+		numa_run_on_nodes([&](std::size_t node) { calls[node]++; });
+		for(auto& c : calls) REQUIRE(c == 1);
+
+		REQUIRE_THROWS_AS(numa_run_on_nodes([](std::size_t) { throw std::runtime_error("test"); }), const std::runtime_error&);
+	}
+
+	SECTION("partition") {
+		std::size_t size = 1000 * 1000 + 3;
+		std::size_t expected_start = 0;
+		for(std::size_t node = 0; node < nodes; ++node) {
+			std::size_t start, end;
+			numa_allocator::partition(size, node, start, end);
+			REQUIRE(start == expected_start);
+			REQUIRE(start <= end);
+			expected_start = end;
+		}
+		REQUIRE(expected_start == size);
+	}
+
+	SECTION("raw allocation") {
+		for(numa_policy policy : { numa_policy::local, numa_policy::interleave, numa_policy::partitioned }) {
+			numa_allocator alloc(policy);
+			std::size_t size = 1024 * 1024 + 10;
+			char* buf = static_cast<char*>(alloc.raw_allocate(size, 64));
+			REQUIRE(is_aligned(buf, 64));
+			const numa_allocation& obtained = alloc.last_allocation();
+			if(nodes == 1 || policy == numa_policy::local) {
+				REQUIRE(obtained.policy == numa_policy::local);
+				REQUIRE(obtained.nodes == 1);
+			} else {
+				REQUIRE(obtained.policy == policy);
+				REQUIRE(obtained.first_touched);
+			}
+			std::memset(buf, 1, size);
+
+			numa_page_placement placement = numa_placement(buf, size);
+			REQUIRE(placement.node_pages.size() == nodes);
+			std::size_t pages = placement.unknown_pages;
+			for(std::size_t n : placement.node_pages) pages += n;
+			std::size_t page_size = ::sysconf(_SC_PAGESIZE);
+			REQUIRE(pages == (size + page_size - 1) / page_size);
+			alloc.raw_deallocate(buf, size);
+		}
+	}
+
+	SECTION("ndarray") {
+		auto shape = make_ndsize(100, 200);
+		ndarray<2, int> src(shape);
+		for(auto coord : make_ndspan(shape)) src.at(coord) = coord[0] * 200 + coord[1];
+
+		ndarray<2, int, numa_allocator> arr(shape, 0, numa_allocator(numa_policy::partitioned));
+		numa_assign(arr.view(), src.cview());
+		REQUIRE(arr == src);
+
+		ndarray<2, int, numa_allocator> arr2(shape, 0, numa_allocator(numa_policy::interleave));
+		numa_assign(flip(arr2.view()), flip(src.cview()));
+		REQUIRE(arr2 == src);
+	}
+}
+
+#endif
@@ -99,6 +99,11 @@ TEST_CASE("opaque_raw_format", "[nd][opaque_raw_format]") {
 		REQUIRE(vw2.compare(vw));
 
 		vw.assign(vw);
+		
+		std::vector<byte> raw3(sz, 3);
+		opaque_raw_frame_handle<true> vw3(raw3.data(), frm);
+		vw3.assign(vw2, pod_array_copy_policy::streaming());
+		REQUIRE(vw3.compare(vw2));
 	}
 
 	SECTION("cast, pod") {
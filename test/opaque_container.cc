@@ -169,3 +169,35 @@ TEST_CASE("ndarray_opaque", "[nd][ndarray_opaque]") {
 		REQUIRE(nonpod_frame_handle::counter == 0);
 	}
 }
+
+
+TEST_CASE("ndarray_opaque storage order", "[nd][ndarray_opaque]") {
+	constexpr std::size_t l = sizeof(int);
+	auto shape = make_ndsize(3, 4);
+	opaque_raw_format frm(l);
+
+	using array_type = ndarray_opaque<2, opaque_raw_format>;
+	using view_type = ndarray_opaque_view<2, true, opaque_raw_format>;
+
+	array_type arr(shape, frm, storage_order::column_major);
+	REQUIRE(arr.strides() == make_ndptrdiff(l, 3*l));
+	REQUIRE((arr.strides() == view_type::default_strides(shape, frm, storage_order::column_major)));
+	REQUIRE(arr.view().strides_order().is_column_major());
+	REQUIRE_FALSE(arr.view().has_default_strides());
+	REQUIRE(arr.view().has_default_strides(storage_order::column_major));
+	REQUIRE(arr.view().has_pod_format());
+	REQUIRE(arr.view().pod_format().length() == shape.product());
+
+	int i = 0;
+	for(const auto& coord : make_ndspan(shape)) *reinterpret_cast<int*>(arr.at(coord).start()) = i++;
+
+	array_type copy = arr;
+	REQUIRE(copy.strides() == arr.strides());
+	REQUIRE(copy == arr);
+
+	array_type row(arr.cview());
+	REQUIRE((row.strides() == view_type::default_strides(shape, frm)));
+	REQUIRE(row == arr);
+	i = 0;
+	for(const auto& coord : make_ndspan(shape)) REQUIRE(*reinterpret_cast<const int*>(row.at(coord).start()) == i++);
+}
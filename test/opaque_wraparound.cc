@@ -40,6 +40,48 @@ TEST_CASE("ndarray_wraparound_opaque_view", "[nd][ndarray_wraparound_opaque_view
 	}
 	
 	
+	SECTION("assign, compare") {
+		auto shp = make_ndsize(10, 3);
+		auto len = shp.product();
+		std::vector<std::uint32_t> raw(len), raw2(len, 0), raw3(len, 0);
+		for(int i = 0; i < len; ++i) raw[i] = i;
+		
+		opaque_raw_format frm(4);
+		ndarray_opaque_view<2, true, opaque_raw_format> vw(raw.data(), shp, frm);
+		ndarray_opaque_view<2, true, opaque_raw_format> vw2(raw2.data(), shp, frm);
+		ndarray_opaque_view<2, true, opaque_raw_format> vw3(raw3.data(), shp, frm);
+		
+		auto vw_w = wraparound(vw, make_ndptrdiff(7, 2), make_ndptrdiff(17, 5));
+		REQUIRE(axis_wraparound(vw_w, 0));
+		REQUIRE(axis_wraparound(vw_w, 1));
+		int count = 0;
+		vw_w.for_each_segment([&](const ndptrdiff<2>&, const ndarray_opaque_view<2, true, opaque_raw_format>&) { ++count; });
+		REQUIRE(count == 4);
+		
+		// wraparound to plain
+		vw2.assign(vw_w);
+		REQUIRE(vw2.compare(vw_w));
+		REQUIRE(vw_w.compare(vw2));
+		REQUIRE(raw2[0] == 7 * 3 + 2);
+		REQUIRE(raw2[1] == 7 * 3 + 0);
+		REQUIRE(raw2[3 * 3] == 0 * 3 + 2);
+		
+		// wraparound to wraparound
+		auto vw3_w = wraparound(vw3, make_ndptrdiff(-4, 1), make_ndptrdiff(6, 4));
+		vw3_w.assign(vw_w);
+		REQUIRE(vw3_w.compare(vw_w));
+		for(int r = 0; r < 10; ++r) for(int c = 0; c < 3; ++c)
+			REQUIRE(raw3[r * 3 + c] == ((r + 1) % 10) * 3 + (c + 1) % 3);
+		
+		// plain to wraparound
+		raw2[4] = 1000;
+		vw_w.assign(vw2);
+		REQUIRE(vw_w[1][1].compare(vw2[1][1]));
+		REQUIRE(raw[8 * 3 + 0] == 1000);
+		REQUIRE_FALSE(vw3_w.compare(vw_w));
+	}
+	
+	
 	SECTION("cast") {
 		auto concrete_shp = make_ndsize(2, 3, 3, 4);
 		std::size_t concrete_len = concrete_shp.product();
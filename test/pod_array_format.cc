@@ -1,7 +1,11 @@
 #include <catch.hpp>
 #include <array>
+#include <vector>
+#include <algorithm>
 #include "../src/ndarray_view.h"
 #include "../src/pod_array_format.h"
+#include "../src/pod_array_strided.h"
+#include "../src/ndarray_view_operations.h"
 #include "support/ndarray.h"
 
 using namespace tlz;
@@ -12,7 +16,7 @@ ndsize<3> shp{3, 4, 4};
 
 
 template<std::size_t Elem_size, std::size_t Padding_size>
-void test_non_contiguous_() {
+void test_non_contiguous_at_simd_level_() {
 	struct elem_t {
 		std::array<byte, Elem_size> data;
 		bool operator==(const elem_t& other) const
@@ -71,6 +75,29 @@ void test_non_contiguous_() {
 		static_cast<const void*>(raw2.data()),
 		frm
 	));
+	for(int i : { 0, 17, (int)len - 1 }) {
+		raw2[i].elem.data[Elem_size - 1] ^= 1;
+		REQUIRE_FALSE(pod_array_compare(
+			static_cast<const void*>(raw1.data()),
+			static_cast<const void*>(raw2.data()),
+			frm
+		));
+		raw2[i].elem.data[Elem_size - 1] ^= 1;
+	}
+}
+
+
+template<std::size_t Elem_size, std::size_t Padding_size>
+void test_non_contiguous_() {
+	// test scalar and all SIMD kernels supported by the CPU
+	simd_level levels[] = { simd_level::none, simd_level::sse2, simd_level::avx2, simd_level::avx512bw };
+	for(simd_level level : levels) {
+		if(level > supported_simd_level()) break;
+		set_pod_array_simd_level(level);
+		REQUIRE(pod_array_simd_level() == level);
+		test_non_contiguous_at_simd_level_<Elem_size, Padding_size>();
+	}
+	set_pod_array_simd_level(supported_simd_level());
 }
 
 
@@ -116,6 +143,10 @@ TEST_CASE("pod_array_format", "[nd][pod_array_format]") {
 			SECTION("int64 boundary") { test_non_contiguous_<8, 16>(); }
 			SECTION("irregular") { test_non_contiguous_<105, 13>(); }
 			SECTION("not int32 boundary") { test_non_contiguous_<4, 5>(); }
+			SECTION("int24 boundary") { test_non_contiguous_<3, 1>(); }
+			SECTION("int32 multiple") { test_non_contiguous_<12, 4>(); }
+			SECTION("sparse") { test_non_contiguous_<4, 60>(); }
+			SECTION("dense") { test_non_contiguous_<31, 1>(); }
 		}
 	}
 	
@@ -125,6 +156,60 @@ TEST_CASE("pod_array_format", "[nd][pod_array_format]") {
 }
 
 
+template<std::size_t Elem_size>
+void test_strided_() {
+	struct elem_t {
+		std::array<byte, Elem_size> data;
+		bool operator==(const elem_t& other) const
+			{ return (data == other.data); }
+	};
+	std::vector<elem_t> raw1(len), raw2(len);
+	for(int i = 0; i < len; ++i) for(int j = 0; j < Elem_size; ++j) {
+		raw1[i].data[j] = i + j;
+		raw2[i].data[j] = 0;
+	}
+	ndarray_view<3, elem_t> vw1(raw1.data(), shp);
+	ndarray_view<3, elem_t> vw2(raw2.data(), make_ndsize(4, 4, 3));
+	auto src = reverse(step(vw1, 1, 2), 2);
+	auto dst = swapaxis(vw2, 0, 2).section(make_ndptrdiff(0, 0, 0), src.shape());
+	
+	REQUIRE_FALSE(pod_array_strided_compare(
+		static_cast<const void*>(dst.start()), dst.strides(),
+		static_cast<const void*>(src.start()), src.strides(),
+		src.shape(), Elem_size
+	));
+	pod_array_strided_copy(
+		static_cast<void*>(dst.start()), dst.strides(),
+		static_cast<const void*>(src.start()), src.strides(),
+		src.shape(), Elem_size
+	);
+	REQUIRE(std::equal(dst.begin(), dst.end(), src.begin()));
+	REQUIRE(pod_array_strided_compare(
+		static_cast<const void*>(dst.start()), dst.strides(),
+		static_cast<const void*>(src.start()), src.strides(),
+		src.shape(), Elem_size
+	));
+	REQUIRE(vw2[0][2][0] == elem_t()); // outside section
+	
+	dst[1][1][1].data[0] = 77;
+	REQUIRE_FALSE(pod_array_strided_compare(
+		static_cast<const void*>(dst.start()), dst.strides(),
+		static_cast<const void*>(src.start()), src.strides(),
+		src.shape(), Elem_size
+	));
+}
+
+
+TEST_CASE("pod_array_strided", "[nd][pod_array_format]") {
+	SECTION("int8") { test_strided_<1>(); }
+	SECTION("int16") { test_strided_<2>(); }
+	SECTION("int32") { test_strided_<4>(); }
+	SECTION("int64") { test_strided_<8>(); }
+	SECTION("int128") { test_strided_<16>(); }
+	SECTION("irregular") { test_strided_<13>(); }
+}
+
+
 TEST_CASE("pod_array_format coverage", "[nd][pod_array_format]") {	
 	auto req = [](const pod_array_format& a, const pod_array_format& b) {
 		REQUIRE(same_coverage(a, b));
@@ -165,3 +250,105 @@ TEST_CASE("pod_array_format coverage", "[nd][pod_array_format]") {
 		req_false(make_pod_array_format<int>(1), make_pod_array_format<byte>(l+1));
 	}
 }
+
+
+TEST_CASE("pod_array_copy streaming", "[nd][pod_array_format]") {
+	std::vector<byte> raw1(5000), raw2(5000);
+	for(int i = 0; i < raw1.size(); ++i) raw1[i] = i % 251;
+	
+	SECTION("policy") {
+		REQUIRE_FALSE(pod_array_copy_policy::cached().is_streaming(1 << 30));
+		REQUIRE(pod_array_copy_policy::streaming().is_streaming(1));
+		REQUIRE(pod_array_copy_policy::streaming(100).is_streaming(100));
+		REQUIRE_FALSE(pod_array_copy_policy::streaming(100).is_streaming(99));
+		
+		REQUIRE_FALSE(default_pod_array_copy_policy().is_streaming(1 << 30));
+		set_default_pod_array_copy_policy(pod_array_copy_policy::streaming(1000));
+		REQUIRE(default_pod_array_copy_policy().streaming_threshold() == 1000);
+		set_default_pod_array_copy_policy(pod_array_copy_policy::cached());
+	}
+	
+	SECTION("contiguous") {
+		simd_level levels[] = { simd_level::none, simd_level::sse2, simd_level::avx2, simd_level::avx512bw };
+		for(simd_level level : levels) {
+			if(level > supported_simd_level()) break;
+			set_pod_array_simd_level(level);
+			for(std::size_t offset : { 0, 1, 17, 64 }) for(std::size_t size : { 10, 256, 1000, 4096 }) {
+				std::fill(raw2.begin(), raw2.end(), 0);
+				pod_array_copy(
+					static_cast<void*>(raw2.data() + offset),
+					static_cast<const void*>(raw1.data() + 3),
+					make_pod_array_format<byte>(size),
+					pod_array_copy_policy::streaming()
+				);
+				REQUIRE(std::equal(raw2.begin() + offset, raw2.begin() + offset + size, raw1.begin() + 3));
+				REQUIRE(raw2[offset + size] == 0);
+				if(offset > 0) REQUIRE(raw2[offset - 1] == 0);
+			}
+		}
+		set_pod_array_simd_level(supported_simd_level());
+	}
+	
+	SECTION("ndarray_view") {
+		ndarray_view<2, byte> vw1(raw1.data(), make_ndsize(50, 100));
+		ndarray_view<2, byte> vw2(raw2.data(), make_ndsize(50, 100));
+		vw2.assign(vw1, pod_array_copy_policy::streaming());
+		REQUIRE(vw2.compare(vw1));
+		
+		auto sec1 = vw1.section(make_ndptrdiff(0, 10), make_ndptrdiff(50, 90));
+		auto sec2 = vw2.section(make_ndptrdiff(0, 5), make_ndptrdiff(50, 85));
+		sec2.assign(sec1, pod_array_copy_policy::streaming());
+		REQUIRE(sec2.compare(sec1));
+	}
+}
+
+
+template<std::size_t Elem_size>
+void test_transpose_() {
+	struct elem_t {
+		std::array<byte, Elem_size> data;
+		bool operator==(const elem_t& other) const
+			{ return (data == other.data); }
+	};
+	const std::size_t n = 5 * 70 * 45;
+	std::vector<elem_t> raw1(n), raw2(n);
+	for(std::size_t i = 0; i < n; ++i) for(std::size_t j = 0; j < Elem_size; ++j) raw1[i].data[j] = (i * 7 + j) % 251;
+	ndarray_view<3, elem_t> vw1(raw1.data(), make_ndsize(5, 70, 45));
+
+	simd_level levels[] = { simd_level::none, simd_level::sse2 };
+	for(simd_level level : levels) {
+		if(level > supported_simd_level()) break;
+		set_pod_array_simd_level(level);
+
+		// 2D transpose on inner axes
+		auto src = swapaxis(vw1, 1, 2);
+		ndarray_view<3, elem_t> dst(raw2.data(), src.shape());
+		std::fill(raw2.begin(), raw2.end(), elem_t());
+		dst.assign(src);
+		REQUIRE(std::equal(dst.begin(), dst.end(), src.begin()));
+
+		// negative origin stride along the destination run
+		auto src_rev = reverse(swapaxis(vw1, 1, 2), 2);
+		std::fill(raw2.begin(), raw2.end(), elem_t());
+		dst.assign(src_rev);
+		REQUIRE(std::equal(dst.begin(), dst.end(), src_rev.begin()));
+
+		// full permutation, with reversed axis and section
+		auto src2 = reverse(swapaxis(swapaxis(vw1, 0, 2), 1, 2), 1).section(make_ndptrdiff(1, 2, 3), make_ndptrdiff(44, 5, 69));
+		ndarray_view<3, elem_t> dst2(raw2.data(), src2.shape());
+		std::fill(raw2.begin(), raw2.end(), elem_t());
+		dst2.assign(src2);
+		REQUIRE(std::equal(dst2.begin(), dst2.end(), src2.begin()));
+		REQUIRE(raw2[dst2.size()] == elem_t()); // past end of destination
+	}
+	set_pod_array_simd_level(supported_simd_level());
+}
+
+
+TEST_CASE("pod_array_strided transpose", "[nd][pod_array_format]") {
+	SECTION("int8") { test_transpose_<1>(); }
+	SECTION("int16") { test_transpose_<2>(); }
+	SECTION("int32") { test_transpose_<4>(); }
+	SECTION("int64") { test_transpose_<8>(); }
+	SECTION("irregular") { test_transpose_<13>(); }
+}
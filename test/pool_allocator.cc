@@ -0,0 +1,102 @@
+#include <catch.hpp>
+#include <thread>
+#include <vector>
+#include <cstring>
+#include "../src/allocator/pool_allocator.h"
+#include "../src/ndarray.h"
+#include "../src/opaque/ndarray_opaque.h"
+#include "../src/opaque_format/raw.h"
+#include "support/ndarray.h"
+
+using namespace tlz;
+using namespace tlz::test;
+
+TEST_CASE("pool_allocator", "[nd][pool_allocator]") {
+	pool_allocator::flush_thread_cache();
+	pool_allocator alloc;
+
+	SECTION("raw allocation") {
+		pool_allocator_stats before = pool_allocator::stats();
+		std::vector<void*> ptrs;
+		for(std::size_t size = 1; size <= 2000; size += 37) {
+			void* ptr = alloc.raw_allocate(size, 8);
+			REQUIRE(is_multiple_of(reinterpret_cast<std::uintptr_t>(ptr), 8));
+			std::memset(ptr, 0xAB, size);
+			ptrs.push_back(ptr);
+		}
+		std::size_t i = 0;
+		for(std::size_t size = 1; size <= 2000; size += 37) alloc.raw_deallocate(ptrs[i++], size);
+
+		pool_allocator_stats after = pool_allocator::stats();
+		REQUIRE(after.allocations - before.allocations == ptrs.size());
+		REQUIRE(after.deallocations - before.deallocations == ptrs.size());
+
+		// freed block gets reused from thread-local cache
+		void* ptr = alloc.raw_allocate(100);
+		alloc.raw_deallocate(ptr, 100);
+		void* ptr2 = alloc.raw_allocate(100);
+		REQUIRE(ptr2 == ptr);
+		alloc.raw_deallocate(ptr2, 100);
+		REQUIRE(pool_allocator::stats().thread_cache_hits > after.thread_cache_hits);
+	}
+
+	SECTION("alignment") {
+		for(std::size_t alignment : { 1, 16, 64, 256, 4096 }) {
+			void* ptr = alloc.raw_allocate(24, alignment);
+			REQUIRE(is_multiple_of(reinterpret_cast<std::uintptr_t>(ptr), alignment));
+			alloc.raw_deallocate(ptr, 24);
+		}
+		REQUIRE_THROWS(alloc.raw_allocate(24, 2 * pool_allocator::max_block_size()));
+	}
+
+	SECTION("large allocation") {
+		std::size_t large_allocations = pool_allocator::stats().large_allocations;
+		std::size_t size = 2 * pool_allocator::max_block_size();
+		void* ptr = alloc.raw_allocate(size, 64);
+		REQUIRE(is_multiple_of(reinterpret_cast<std::uintptr_t>(ptr), 64));
+		std::memset(ptr, 0, size);
+		alloc.raw_deallocate(ptr, size);
+		REQUIRE(pool_allocator::stats().large_allocations == large_allocations + 1);
+	}
+
+	SECTION("depot") {
+		// many blocks overflow the thread-local cache into the depot, another thread gets them from there
+		constexpr std::size_t n = 10000;
+		std::vector<void*> ptrs(n);
+		for(void*& ptr : ptrs) ptr = alloc.raw_allocate(48);
+		for(void* ptr : ptrs) alloc.raw_deallocate(ptr, 48);
+		pool_allocator::flush_thread_cache();
+		std::size_t slab_allocations = pool_allocator::stats().slab_allocations;
+
+		std::thread thread([&] {
+			for(void*& ptr : ptrs) ptr = alloc.raw_allocate(40);
+			for(void* ptr : ptrs) alloc.raw_deallocate(ptr, 40);
+		});
+		thread.join();
+		pool_allocator_stats st = pool_allocator::stats();
+		REQUIRE(st.slab_allocations == slab_allocations);
+		REQUIRE(st.depot_transfers > 0);
+		REQUIRE(st.allocations == st.deallocations);
+	}
+
+	SECTION("ndarray") {
+		ndarray<2, int, pool_allocator> arr(make_ndsize(10, 10));
+		REQUIRE(arr.allocated_byte_size() == 100 * sizeof(int));
+		for(auto coord : make_ndspan(arr.shape())) arr.at(coord) = coord[0] * 10 + coord[1];
+		ndarray<2, int, pool_allocator> arr2 = arr;
+		REQUIRE(arr2 == arr);
+	}
+
+	SECTION("ndarray_opaque frame") {
+		opaque_raw_format frm(sizeof(int), 32);
+		pool_allocator_stats before = pool_allocator::stats();
+		for(int i = 0; i < 100; ++i) {
+			auto frame = make_ndarray_opaque_frame(frm, pool_allocator());
+			REQUIRE(is_multiple_of(reinterpret_cast<std::uintptr_t>(frame.frame_handle().ptr()), 32));
+			*reinterpret_cast<int*>(frame.frame_handle().ptr()) = i;
+		}
+		pool_allocator_stats after = pool_allocator::stats();
+		REQUIRE(after.allocations - before.allocations == 100);
+		REQUIRE(after.thread_cache_hits - before.thread_cache_hits >= 99);
+	}
+}
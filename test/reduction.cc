@@ -0,0 +1,167 @@
+#include <catch.hpp>
+#include <cstdint>
+#include <numeric>
+#include <vector>
+#include "../src/ndarray_view.h"
+#include "../src/ndarray.h"
+#include "../src/ndarray_view_operations.h"
+#include "../src/ndarray_reduction.h"
+#include "support/ndarray.h"
+
+using namespace tlz;
+using namespace tlz::test;
+
+namespace {
+
+/// Reference reduction along \a axis, by iterating over coordinates.
+template<std::size_t Dim, typename T, typename Init, typename Func>
+auto reference_axis_reduction(const ndarray_view<Dim, T>& vw, std::ptrdiff_t axis, Init init, Func func) {
+	ndarray<Dim - 1, decltype(init)> out(vw.shape().erase(axis));
+	for(const auto& c : make_ndspan(out.shape())) {
+		auto acc = init;
+		for(std::ptrdiff_t k = 0; k < vw.shape()[axis]; ++k) {
+			ndptrdiff<Dim> coord;
+			for(std::ptrdiff_t i = 0, j = 0; i < Dim; ++i) coord[i] = (i == axis ? k : c[j++]);
+			acc = func(acc, vw.at(coord), k);
+		}
+		out.at(c) = acc;
+	}
+	return out;
+}
+
+}
+
+
+TEST_CASE("ndarray_reduction", "[nd][ndarray_reduction]") {
+	auto shape = make_ndsize(7, 9, 37);
+	ndarray<3, int> arr(shape);
+	int i = 0;
+	for(int& v : arr) v = ((i++) * 7919) % 1009 - 500;
+	auto vw = arr.cview();
+	std::vector<int> values(arr.begin(), arr.end());
+
+	SECTION("whole view") {
+		REQUIRE(sum(vw) == std::accumulate(values.begin(), values.end(), 0));
+		REQUIRE(min(vw) == *std::min_element(values.begin(), values.end()));
+		REQUIRE(max(vw) == *std::max_element(values.begin(), values.end()));
+		REQUIRE(mean(vw) == Approx(double(sum(vw)) / values.size()));
+		REQUIRE(count(vw) == values.size() - std::count(values.begin(), values.end(), 0));
+		REQUIRE(any(vw));
+		REQUIRE_FALSE(all(vw));
+
+		auto amin = argmin(vw);
+		REQUIRE(vw.at(amin) == min(vw));
+		REQUIRE(vw.coordinates_to_index(amin) == std::min_element(values.begin(), values.end()) - values.begin());
+		auto amax = argmax(vw);
+		REQUIRE(vw.coordinates_to_index(amax) == std::max_element(values.begin(), values.end()) - values.begin());
+
+		// first occurence, also on strided view with reordered axes
+		auto swp = reverse(swapaxis(vw, 0, 2), 1);
+		std::vector<int> swp_values(swp.begin(), swp.end());
+		REQUIRE(sum(swp) == sum(vw));
+		REQUIRE(swp.coordinates_to_index(argmin(swp)) == std::min_element(swp_values.begin(), swp_values.end()) - swp_values.begin());
+		REQUIRE(swp.coordinates_to_index(argmax(swp)) == std::max_element(swp_values.begin(), swp_values.end()) - swp_values.begin());
+	}
+
+	SECTION("small types") {
+		ndarray<2, std::uint8_t> bytes(make_ndsize(100, 100));
+		for(auto& b : bytes) b = 200;
+		REQUIRE(sum(bytes.cview()) == 200 * 100 * 100);
+		REQUIRE(mean(bytes.cview()) == Approx(200.0));
+
+		// total exceeds INT_MAX
+		ndarray<2, std::uint8_t> large(make_ndsize(4096, 4096));
+		for(auto& b : large) b = 255;
+		REQUIRE(sum(large.cview()) == std::uint64_t(255) * 4096 * 4096);
+		REQUIRE(sum(large.cview()(1, 4095)) == std::uint64_t(255) * 4094 * 4096);
+		ndarray<2, std::int8_t> signed_large(make_ndsize(4096, 4096));
+		for(auto& b : signed_large) b = -127;
+		signed_large[0][0] = -128;
+		REQUIRE(sum(signed_large.cview()) == std::int64_t(-127) * 4096 * 4096 - 1);
+
+		ndarray<1, bool> flags(make_ndsize(10));
+		for(auto& f : flags) f = true;
+		REQUIRE(all(flags.cview()));
+		flags[7] = false;
+		REQUIRE_FALSE(all(flags.cview()));
+		REQUIRE(any(flags.cview()));
+		REQUIRE(count(flags.cview()) == 9);
+	}
+
+	SECTION("empty") {
+		ndarray_view<3, const int> empty(vw.start(), make_ndsize(0, 9, 37));
+		REQUIRE(sum(empty) == 0);
+		REQUIRE(count(empty) == 0);
+		REQUIRE_FALSE(any(empty));
+		REQUIRE(all(empty));
+		REQUIRE_THROWS_AS(min(empty), const failed_assertion&);
+		REQUIRE_THROWS_AS(argmax(empty), const failed_assertion&);
+		REQUIRE_THROWS_AS(mean(empty), const failed_assertion&);
+	}
+
+	SECTION("along axis") {
+		auto swp = reverse(swapaxis(vw, 0, 2), 0);
+		for(std::ptrdiff_t axis = 0; axis < 3; ++axis) {
+			auto s = sum(vw, axis);
+			REQUIRE(s.shape() == shape.erase(axis));
+			REQUIRE(s.view() == reference_axis_reduction(vw, axis, 0, [](int a, int x, std::ptrdiff_t) { return a + x; }).view());
+			REQUIRE(sum(swp, axis).view() == reference_axis_reduction(swp, axis, 0, [](int a, int x, std::ptrdiff_t) { return a + x; }).view());
+
+			auto mn = min(vw, axis);
+			REQUIRE(mn.view() == reference_axis_reduction(vw, axis, 1000, [](int a, int x, std::ptrdiff_t) { return std::min(a, x); }).view());
+			auto mx = max(swp, axis);
+			REQUIRE(mx.view() == reference_axis_reduction(swp, axis, -1000, [](int a, int x, std::ptrdiff_t) { return std::max(a, x); }).view());
+
+			int best = 0;
+			auto am = argmin(vw, axis);
+			auto am_expected = reference_axis_reduction(vw, axis, std::ptrdiff_t(0), [&](std::ptrdiff_t a, int x, std::ptrdiff_t k) {
+				if(k == 0 || x < best) { best = x; return k; }
+				else return a;
+			});
+			REQUIRE(am.view() == am_expected.view());
+
+			auto cnt = count(vw, axis);
+			REQUIRE(cnt.view() == reference_axis_reduction(vw, axis, std::size_t(0), [](std::size_t a, int x, std::ptrdiff_t) { return a + (x != 0); }).view());
+
+			auto mn_d = mean(vw, axis);
+			for(const auto& c : make_ndspan(mn_d.shape())) REQUIRE(mn_d.at(c) == Approx(double(s.at(c)) / shape[axis]));
+		}
+
+		ndarray<2, bool> flags(make_ndsize(3, 4));
+		for(auto& f : flags) f = false;
+		flags[1][2] = true;
+		auto any0 = any(flags.cview(), 0);
+		auto all1 = all(flags.cview(), 1);
+		REQUIRE(any0[2]);
+		REQUIRE_FALSE(any0[1]);
+		REQUIRE_FALSE(all1[1]);
+	}
+
+	SECTION("parallel") {
+		thread_pool pool(3);
+		auto pol = execution::par.on(pool).with_min_block_size(64);
+		REQUIRE(sum(pol, vw) == sum(vw));
+		REQUIRE(min(pol, vw) == min(vw));
+		REQUIRE(max(execution::seq, vw) == max(vw));
+		REQUIRE(argmin(pol, vw) == argmin(vw));
+		REQUIRE(argmax(pol, vw) == argmax(vw));
+		REQUIRE(count(pol, vw) == count(vw));
+		REQUIRE(any(pol, vw));
+		REQUIRE_FALSE(all(pol, vw));
+		for(std::ptrdiff_t axis = 0; axis < 3; ++axis) {
+			REQUIRE(sum(pol, vw, axis).view() == sum(vw, axis).view());
+			REQUIRE(argmax(pol, vw, axis).view() == argmax(vw, axis).view());
+		}
+
+		// floating point sum is reproducible with deterministic policy, on any pool
+		ndarray<2, float> f(make_ndsize(300, 301));
+		i = 0;
+		for(float& v : f) v = 1.0f / (1 + (i++ % 97));
+		thread_pool pool1(1);
+		auto det = execution::par.with_min_block_size(1024).deterministic();
+		float s1 = sum(det.on(pool1), f.cview());
+		float s3 = sum(det.on(pool), f.cview());
+		REQUIRE(s1 == s3);
+		REQUIRE(s1 == Approx(sum(f.cview())));
+	}
+}
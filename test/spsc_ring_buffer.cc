@@ -0,0 +1,138 @@
+#include <catch.hpp>
+#include <cstdint>
+#include <thread>
+#include "../src/opaque/spsc_ring_buffer.h"
+#include "../src/opaque/ndarray_wraparound_opaque_view_cast.h"
+#include "../src/opaque_format/ndarray.h"
+#include "../src/opaque_format/raw.h"
+#include "support/ndarray.h"
+
+using namespace tlz;
+using namespace tlz::test;
+
+namespace {
+
+int& frame_value(const ndarray_wraparound_opaque_view<1, true, opaque_raw_format>& vw, std::ptrdiff_t i) {
+	return *reinterpret_cast<int*>(vw[i].start());
+}
+
+int frame_value(const ndarray_wraparound_opaque_view<1, false, opaque_raw_format>& vw, std::ptrdiff_t i) {
+	return *reinterpret_cast<const int*>(vw[i].start());
+}
+
+}
+
+
+TEST_CASE("spsc_ring_buffer", "[nd][spsc_ring_buffer]") {
+	opaque_raw_format frm(sizeof(int), alignof(int));
+
+	SECTION("single thread") {
+		spsc_ring_buffer<opaque_raw_format> ring(frm, 10);
+		REQUIRE(ring.capacity() == 10);
+		REQUIRE(ring.writable_frames() == 10);
+		REQUIRE(ring.readable_frames() == 0);
+		REQUIRE(ring.try_begin_read(1).is_null());
+
+		auto w = ring.begin_write(7);
+		REQUIRE(w.start_time() == 0);
+		REQUIRE(w.duration() == 7);
+		for(int i = 0; i < 7; ++i) frame_value(w.view(), i) = i;
+		ring.end_write(7);
+		REQUIRE(ring.write_time() == 7);
+		REQUIRE(ring.readable_frames() == 7);
+		REQUIRE(ring.try_begin_write(4).is_null());
+
+		auto r = ring.begin_read(5);
+		REQUIRE(r.span().begin == 0);
+		REQUIRE(r.span().end == 5);
+		for(int i = 0; i < 5; ++i) REQUIRE(frame_value(r.view(), i) == i);
+		ring.end_read(5);
+		REQUIRE(ring.read_time() == 5);
+
+		// section wraps around end of buffer
+		w = ring.begin_write(6);
+		REQUIRE(w.start_time() == 7);
+		REQUIRE(axis_wraparound(w.view(), 0));
+		for(int i = 0; i < 6; ++i) frame_value(w.view(), i) = 7 + i;
+		ring.end_write(4); // only first 4 frames get readable
+		REQUIRE(ring.write_time() == 11);
+
+		r = ring.begin_read(6);
+		REQUIRE(r.start_time() == 5);
+		REQUIRE(r.end_time() == 11);
+		for(time_unit t = 5; t < 11; ++t) REQUIRE(*reinterpret_cast<const int*>(r.at_time(t).start()) == t);
+		ring.end_read(6);
+		REQUIRE(ring.readable_frames() == 0);
+		REQUIRE(ring.writable_frames() == 10);
+
+		REQUIRE_THROWS(ring.begin_write(11));
+	}
+
+	SECTION("close") {
+		spsc_ring_buffer<opaque_raw_format> ring(frm, 10);
+		ring.begin_write(3);
+		ring.end_write(3);
+		ring.close();
+		REQUIRE(ring.closed());
+		auto r = ring.begin_read(5);
+		REQUIRE(r.duration() == 3);
+		ring.end_read(3);
+		REQUIRE(ring.begin_read(5).is_null());
+	}
+
+	SECTION("concrete cast") {
+		auto frame_shape = make_ndsize(2, 3);
+		opaque_ndarray_format nd_frm = default_opaque_ndarray_format<float>(frame_shape);
+		spsc_ring_buffer<opaque_ndarray_format> ring(nd_frm, 4);
+		ring.begin_write(3); ring.end_write(3);
+		ring.begin_read(3); ring.end_read(3);
+
+		auto w = ring.begin_write(3);
+		ndarray_wraparound_view<3, float> w_c = from_opaque<3, float>(w.view());
+		REQUIRE(w_c.shape() == make_ndsize(3, 2, 3));
+		w_c[2][1][2] = 1.5f;
+		ring.end_write(3);
+
+		auto r = ring.begin_read(3);
+		REQUIRE(r.start_time() == 3);
+		ndarray_wraparound_view<3, const float> r_c = from_opaque<3, const float>(r.view());
+		REQUIRE(r_c[2][1][2] == 1.5f);
+		ring.end_read(3);
+	}
+
+	SECTION("threads") {
+		for(bool sleep : { false, true }) {
+			ring_wait_strategy strategy;
+			strategy.spin_iterations = sleep ? 0 : 100;
+			strategy.sleep = sleep;
+			spsc_ring_buffer<opaque_raw_format> ring(frm, 64, strategy);
+			constexpr int total = 20000;
+
+			std::thread producer([&] {
+				int i = 0;
+				while(i < total) {
+					std::size_t n = std::min(1 + i % 13, total - i);
+					auto w = ring.begin_write(n);
+					for(std::size_t j = 0; j < n; ++j) frame_value(w.view(), j) = i + j;
+					ring.end_write(n);
+					i += n;
+				}
+				ring.close();
+			});
+
+			bool ok = true;
+			int expected = 0;
+			for(;;) {
+				auto r = ring.begin_read(1 + expected % 7);
+				if(r.is_null()) break;
+				ok = ok && (r.start_time() == expected);
+				for(std::ptrdiff_t j = 0; j < r.duration(); ++j) ok = ok && (frame_value(r.view(), j) == expected + j);
+				expected += r.duration();
+				ring.end_read(r.duration());
+			}
+			producer.join();
+			REQUIRE(ok);
+			REQUIRE(expected == total);
+		}
+	}
+}
@@ -0,0 +1,155 @@
+#include <catch.hpp>
+#include <set>
+#include <string>
+#include "../src/ndarray_view.h"
+#include "../src/ndarray.h"
+#include "../src/ndarray_tiled.h"
+#include "../src/ndarray_view_operations.h"
+#include "support/ndarray.h"
+
+using namespace tlz;
+using namespace tlz::test;
+
+TEST_CASE("ndarray_tiled", "[nd][ndarray_tiled]") {
+	auto shape = make_ndsize(7, 10, 13);
+	auto brick_shape = make_ndsize(4, 4, 4);
+	ndarray<3, int> arr(shape);
+	int i = 0;
+	for(int& v : arr) v = i++;
+
+	SECTION("layout") {
+		using view_type = ndarray_tiled_view<3, int>;
+		REQUIRE(view_type::bricks_shape(shape, brick_shape) == make_ndsize(2, 3, 4));
+		REQUIRE(view_type::storage_length(shape, brick_shape) == 2*3*4 * 64);
+
+		std::vector<int> raw(view_type::storage_length(shape, brick_shape));
+		view_type vw(raw.data(), shape, brick_shape);
+		REQUIRE(vw.shape() == shape);
+		REQUIRE(&vw.at(make_ndptrdiff(0, 0, 0)) == raw.data());
+		REQUIRE(&vw.at(make_ndptrdiff(0, 0, 1)) == raw.data() + 1);
+		REQUIRE(&vw.at(make_ndptrdiff(0, 1, 0)) == raw.data() + 4);
+		REQUIRE(&vw.at(make_ndptrdiff(0, 0, 4)) == raw.data() + 64);
+		REQUIRE(&vw.at(make_ndptrdiff(0, 4, 0)) == raw.data() + 4*64);
+		REQUIRE(&vw.at(make_ndptrdiff(5, 6, 7)) == raw.data() + ((1*3 + 1)*4 + 1) * 64 + (1*4 + 2)*4 + 3);
+		REQUIRE_THROWS_AS(vw.at(make_ndptrdiff(7, 0, 0)), const failed_assertion&);
+
+		REQUIRE(vw.brick_position(make_ndptrdiff(5, 6, 7)) == make_ndptrdiff(1, 1, 1));
+		REQUIRE(vw.brick_span(make_ndptrdiff(1, 2, 3)) == make_ndspan(make_ndptrdiff(4, 8, 12), make_ndptrdiff(7, 10, 13)));
+		auto br = vw.brick(make_ndptrdiff(1, 2, 3));
+		REQUIRE(br.shape() == make_ndsize(3, 2, 1));
+		REQUIRE(br.strides() == make_ndptrdiff(16, 4, 1) * std::ptrdiff_t(sizeof(int)));
+	}
+
+	SECTION("assign and compare") {
+		ndarray_tiled<3, int> tiled(arr.cview(), brick_shape);
+		REQUIRE(tiled.shape() == shape);
+		for(const auto& c : make_ndspan(shape)) REQUIRE(tiled.at(c) == arr.at(c));
+		REQUIRE(tiled == arr.cview());
+		REQUIRE(tiled.view() == arr.cview());
+
+		ndarray<3, int> back(shape);
+		tiled.copy_to(back.view());
+		REQUIRE(back == arr);
+		REQUIRE(make_ndarray(tiled.cview()) == arr);
+
+		tiled.at(make_ndptrdiff(6, 9, 12)) = -1;
+		REQUIRE_FALSE(tiled == arr.cview());
+
+		// from strided view
+		auto tr = swapaxis(arr.cview(), 0, 2);
+		ndarray_tiled<3, int> tiled_tr(tr, make_ndsize(8, 2, 3));
+		REQUIRE(tiled_tr == tr);
+
+		// between different brick shapes
+		ndarray_tiled<3, int> tiled2(shape, make_ndsize(2, 8, 5));
+		tiled2.view().assign(tiled.cview());
+		REQUIRE(tiled2.cview() == tiled.cview());
+
+		tiled2.fill(3);
+		for(const auto& c : make_ndspan(shape)) REQUIRE(tiled2.at(c) == 3);
+
+		// copy and move
+		ndarray_tiled<3, int> copy = tiled;
+		REQUIRE(copy.cview() == tiled.cview());
+		ndarray_tiled<3, int> moved = std::move(copy);
+		REQUIRE(moved.cview() == tiled.cview());
+		REQUIRE(copy.view().is_null());
+
+		// assignment of smaller array reuses buffer
+		std::size_t allocated = moved.allocated_byte_size();
+		REQUIRE((allocated == ndarray_tiled_view<3, int>::storage_length(shape, brick_shape) * sizeof(int)));
+		ndarray_tiled<3, int> small(arr.cview()(1, 5)(2, 6), make_ndsize(2, 2, 2));
+		moved = small;
+		REQUIRE(moved.shape() == small.shape());
+		REQUIRE(moved.allocated_byte_size() == allocated);
+		REQUIRE(moved == arr.cview()(1, 5)(2, 6));
+		moved = tiled;
+		REQUIRE(moved.allocated_byte_size() == allocated);
+		REQUIRE(moved.cview() == tiled.cview());
+	}
+
+	SECTION("section") {
+		ndarray_tiled<3, int> tiled(arr.cview(), brick_shape);
+		auto start = make_ndptrdiff(1, 3, 2), end = make_ndptrdiff(6, 9, 11);
+		auto sec = tiled.section(start, end);
+		REQUIRE(sec.shape() == make_ndsize(5, 6, 9));
+		REQUIRE(sec == arr.cview().section(start, end));
+		for(const auto& c : make_ndspan(sec.shape())) REQUIRE(sec.at(c) == arr.at(start + ndptrdiff<3>(c)));
+
+		std::size_t n = 0;
+		sec.for_each_brick([&](const ndarray_view<3, int>& brick_sec, const ndspan<3>& span) {
+			REQUIRE(brick_sec.shape() == span.shape());
+			REQUIRE(brick_sec == arr.cview().section(start + span.start_pos(), start + span.end_pos()));
+			n += span.size();
+		});
+		REQUIRE(n == sec.size());
+
+		sec.fill(0);
+		for(const auto& c : make_ndspan(shape)) {
+			bool inside = make_ndspan(start, end).includes(c);
+			REQUIRE(tiled.at(c) == (inside ? 0 : arr.at(c)));
+		}
+	}
+
+	SECTION("iteration") {
+		ndarray_tiled<3, int> tiled(arr.cview(), brick_shape);
+		auto sec = tiled.section(make_ndptrdiff(1, 3, 2), make_ndptrdiff(6, 9, 11));
+		std::multiset<int> visited;
+		const int* prev = nullptr;
+		std::size_t backward_jumps = 0;
+		for(auto it = sec.begin(); it != sec.end(); ++it) {
+			REQUIRE(*it == sec.at(it.coordinates()));
+			visited.insert(*it);
+			if(prev != nullptr && it.ptr() < prev) ++backward_jumps;
+			prev = it.ptr();
+		}
+		REQUIRE(visited.size() == sec.size());
+		REQUIRE(std::set<int>(visited.begin(), visited.end()).size() == sec.size());
+		REQUIRE(backward_jumps == 0); // storage order
+
+		std::size_t count = 0;
+		for(int& v : tiled) { v = 1; ++count; }
+		REQUIRE(count == tiled.size());
+	}
+
+	SECTION("non-POD") {
+		ndarray<2, std::string> words(make_ndsize(5, 3));
+		for(auto& w : words) w = "w" + std::to_string(i++);
+		ndarray_tiled<2, std::string> tiled(words.cview(), make_ndsize(2, 2));
+		REQUIRE(tiled == words.cview());
+
+		int counter = obj_t::counter;
+		{
+			ndarray_tiled<2, obj_t> objs(make_ndsize(5, 3), make_ndsize(2, 2));
+			REQUIRE(obj_t::counter == counter + 3 * 2 * 4);
+			ndarray_tiled<2, obj_t> small(make_ndsize(2, 2), make_ndsize(2, 2));
+			objs = small;
+			REQUIRE(obj_t::counter == counter + 4 + 4);
+			ndarray_tiled<2, obj_t> moved = std::move(objs);
+			REQUIRE(obj_t::counter == counter + 4 + 4);
+			small = std::move(moved);
+			REQUIRE(obj_t::counter == counter + 4);
+		}
+		REQUIRE(obj_t::counter == counter);
+	}
+}
@@ -0,0 +1,141 @@
+#include <catch.hpp>
+#include <vector>
+#include <algorithm>
+#include "../src/ndarray_view.h"
+#include "../src/ndarray_view_operations.h"
+#include "../src/ndarray_traversal.h"
+#include "support/ndarray.h"
+
+using namespace tlz;
+using namespace tlz::test;
+
+
+TEST_CASE("ndarray_traversal", "[nd][ndarray_traversal]") {
+	constexpr std::ptrdiff_t l = sizeof(int);
+	auto shp = make_ndsize(4, 3, 5);
+	std::size_t len = shp.product();
+	std::vector<int> raw(len);
+	for(int i = 0; i < len; ++i) raw[i] = i;
+	ndarray_view<3, int> arr(raw.data(), shp);
+
+	SECTION("single view runs") {
+		// default strides: single run
+		int runs = 0;
+		for_each_run(arr, [&](int* ptr, std::ptrdiff_t n, std::ptrdiff_t stride) {
+			REQUIRE(ptr == raw.data());
+			REQUIRE(n == len);
+			REQUIRE(stride == l);
+			++runs;
+		});
+		REQUIRE(runs == 1);
+
+		// section on inner axis: one run per row
+		auto sec = arr.section(make_ndptrdiff(0, 0, 1), make_ndptrdiff(4, 3, 4));
+		std::vector<int> got;
+		runs = 0;
+		for_each_run(sec, [&](int* ptr, std::ptrdiff_t n, std::ptrdiff_t stride) {
+			REQUIRE(n == 3);
+			REQUIRE(stride == l);
+			for(std::ptrdiff_t i = 0; i < n; ++i) got.push_back(*advance_raw_ptr(ptr, i * stride));
+			++runs;
+		});
+		REQUIRE(runs == 4 * 3);
+		REQUIRE(got == std::vector<int>(sec.begin(), sec.end()));
+
+		// section on outer axis: still contiguous
+		auto sec2 = arr.section(make_ndptrdiff(1, 0, 0), make_ndptrdiff(3, 3, 5));
+		runs = 0;
+		for_each_run(sec2, [&](int*, std::ptrdiff_t n, std::ptrdiff_t) { REQUIRE(n == 2 * 3 * 5); ++runs; });
+		REQUIRE(runs == 1);
+
+		// stepped and reversed view, traversed in ascending memory order
+		auto sec3 = reverse(step(arr, 1, 2), 2);
+		got.clear();
+		for_each_run(sec3, [&](int* ptr, std::ptrdiff_t n, std::ptrdiff_t stride) {
+			REQUIRE(stride == l);
+			for(std::ptrdiff_t i = 0; i < n; ++i) got.push_back(*advance_raw_ptr(ptr, i * stride));
+		});
+		std::vector<int> expected(sec3.begin(), sec3.end());
+		std::sort(expected.begin(), expected.end());
+		REQUIRE(got == expected);
+	}
+
+	SECTION("canonicalization") {
+		// reordered axes: single run
+		int runs = 0;
+		auto swp = swapaxis(swapaxis(arr, 0, 2), 1, 2);
+		for_each_run(swp, [&](int* ptr, std::ptrdiff_t n, std::ptrdiff_t stride) {
+			REQUIRE(ptr == raw.data());
+			REQUIRE(n == len);
+			REQUIRE(stride == l);
+			++runs;
+		});
+		REQUIRE(runs == 1);
+
+		// reversed axes: single run
+		runs = 0;
+		for_each_run(reverse_all(arr), [&](int* ptr, std::ptrdiff_t n, std::ptrdiff_t stride) {
+			REQUIRE(ptr == raw.data());
+			REQUIRE(n == len);
+			REQUIRE(stride == l);
+			++runs;
+		});
+		REQUIRE(runs == 1);
+
+		// unit axes get dropped
+		runs = 0;
+		ndarray_view<3, int> col(raw.data(), make_ndsize(1, 6, 1), make_ndptrdiff(1000, 5 * l, 7));
+		for_each_run(col, [&](int*, std::ptrdiff_t n, std::ptrdiff_t stride) {
+			REQUIRE(n == 6);
+			REQUIRE(stride == 5 * l);
+			++runs;
+		});
+		REQUIRE(runs == 1);
+
+		// pair with different axis order
+		runs = 0;
+		std::vector<int> raw2(len, 0);
+		ndarray_view<3, int> arr2(raw2.data(), make_ndsize(5, 3, 4));
+		auto dst = swapaxis(arr2, 0, 2);
+		auto src = arr;
+		for_each_run(dst, src, [&](int*, const int*, std::ptrdiff_t, std::ptrdiff_t, std::ptrdiff_t) { ++runs; });
+		REQUIRE(runs == 5 * 3); // runs follow the first view
+		dst.assign(src);
+		REQUIRE(dst.compare(src));
+		REQUIRE(arr2[4][2][3] == arr[3][2][4]);
+	}
+
+	SECTION("early stop") {
+		int runs = 0;
+		auto sec = arr.section(make_ndptrdiff(0, 0, 1), make_ndptrdiff(4, 3, 4));
+		bool completed = for_each_run(sec, [&](int*, std::ptrdiff_t, std::ptrdiff_t) { return (++runs < 5); });
+		REQUIRE_FALSE(completed);
+		REQUIRE(runs == 5);
+	}
+
+	SECTION("paired runs") {
+		std::vector<int> raw2(len, 0);
+		ndarray_view<3, int> arr2(raw2.data(), shp);
+		auto src = swapaxis(arr.section(make_ndptrdiff(0, 0, 0), make_ndptrdiff(4, 3, 3)), 1, 2);
+		auto dst = arr2.section(make_ndptrdiff(0, 0, 0), make_ndptrdiff(4, 3, 3));
+
+		dst.assign(src);
+		REQUIRE(dst.compare(src));
+		REQUIRE(std::vector<int>(dst.begin(), dst.end()) == std::vector<int>(src.begin(), src.end()));
+		REQUIRE(raw2[3] == 0);
+
+		dst[2][1][1] = -1;
+		REQUIRE_FALSE(dst.compare(src));
+
+		dst.fill(7);
+		for(int v : dst) REQUIRE(v == 7);
+		REQUIRE(raw2[4] == 0);
+	}
+
+	SECTION("empty view") {
+		int runs = 0;
+		ndarray_view<3, int> empty(raw.data(), make_ndsize(2, 0, 3));
+		for_each_run(empty, [&](int*, std::ptrdiff_t, std::ptrdiff_t) { ++runs; });
+		REQUIRE(runs == 0);
+	}
+}
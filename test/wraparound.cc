@@ -234,3 +234,104 @@ TEST_CASE("ndarray_wraparound_view", "[nd][ndarray_wraparound_view]") {
 		}
 	}
 }
+
+
+TEST_CASE("ndarray_wraparound_view segments", "[nd][ndarray_wraparound_view]") {
+	constexpr std::size_t len = 3 * 4 * 5;
+	std::vector<int> raw(len);
+	for(int i = 0; i < len; ++i) raw[i] = i;
+	ndarray_view<3, int> arr3(raw.data(), make_ndsize(3, 4, 5));
+	
+	auto elements = [](const ndarray_wraparound_view<3, int>& vw) {
+		// reference, using coordinates_to_pointer() on each element
+		std::vector<int> elems;
+		for(std::ptrdiff_t i = 0; i < vw.size(); ++i) elems.push_back(vw.at(vw.index_to_coordinates(i)));
+		return elems;
+	};
+	
+	auto check_segments = [](const ndarray_wraparound_view<3, int>& vw, std::size_t expected_count) {
+		std::size_t count = 0, total = 0;
+		vw.for_each_segment([&](const ndptrdiff<3>& seg_start, const ndarray_view<3, int>& seg) {
+			for(std::ptrdiff_t i = 0; i < seg.size(); ++i) {
+				auto coord = seg.index_to_coordinates(i);
+				REQUIRE(&seg.at(coord) == &vw.at(seg_start + coord));
+			}
+			total += seg.size();
+			++count;
+		});
+		REQUIRE(total == vw.size());
+		REQUIRE(count == expected_count);
+	};
+	
+	SECTION("decomposition") {
+		check_segments(arr3, 1);
+		
+		auto w1 = wraparound(arr3, make_ndptrdiff(1, 2, 3), make_ndptrdiff(3, 5, 7));
+		REQUIRE_FALSE(axis_wraparound(w1, 0));
+		REQUIRE(axis_wraparound(w1, 1));
+		REQUIRE(axis_wraparound(w1, 2));
+		REQUIRE(w1.contiguous_length() == 1);
+		check_segments(w1, 4);
+		
+		auto w2 = wraparound(arr3, make_ndptrdiff(-1, 0, 0), make_ndptrdiff(2, 4, 5));
+		REQUIRE(w2.contiguous_length() == 4 * 5);
+		check_segments(w2, 2);
+		
+		auto w3 = wraparound(arr3, make_ndptrdiff(-1, 1, -2), make_ndptrdiff(5, 10, 2), make_ndptrdiff(1, 2, -1));
+		check_segments(w3, 3 * 3 * 2);
+		REQUIRE(std::vector<int>(w3.begin(), w3.end()) == elements(w3));
+		
+		auto w4 = wraparound(reverse(arr3, 2), make_ndptrdiff(0, 0, 3), make_ndptrdiff(3, 4, 7));
+		REQUIRE_FALSE(axis_wraparound(w4, 1));
+		REQUIRE(axis_wraparound(w4, 2));
+		check_segments(w4, 2);
+		check_segments(swapaxis(w4, 1, 2), 2);
+		check_segments(w4.section(make_ndptrdiff(0, 1, 1), make_ndptrdiff(2, 3, 4)), 2);
+		
+		auto w5 = wraparound(arr3, make_ndptrdiff(0, 0, 1), make_ndptrdiff(3, 4, 5), make_ndptrdiff(1, 1, 3));
+		REQUIRE(w5.shape()[2] == 2);
+		REQUIRE_FALSE(axis_wraparound(w5, 2));
+		REQUIRE(w5.contiguous_length() == 2);
+		check_segments(w5, 1);
+		
+		int count = 0;
+		bool completed = w3.for_each_segment([&](const ndptrdiff<3>&, const ndarray_view<3, int>&) { return (++count < 2); });
+		REQUIRE_FALSE(completed);
+		REQUIRE(count == 2);
+	}
+	
+	SECTION("assign, compare, fill") {
+		auto w = wraparound(arr3, make_ndptrdiff(2, -1, 3), make_ndptrdiff(5, 3, 8), make_ndptrdiff(1, 1, -1));
+		REQUIRE(w.shape() == make_ndsize(3, 4, 5));
+		std::vector<int> expected = elements(w);
+		
+		// wraparound to plain
+		std::vector<int> raw2(len, -1);
+		ndarray_view<3, int> arr3_2(raw2.data(), make_ndsize(3, 4, 5));
+		arr3_2.assign(w);
+		REQUIRE(raw2 == expected);
+		REQUIRE(arr3_2.compare(w));
+		REQUIRE(w.compare(arr3_2));
+		
+		// plain to wraparound
+		for(int& v : raw2) v = -v;
+		w.assign(arr3_2);
+		for(std::ptrdiff_t i = 0; i < len; ++i) REQUIRE(w.at(w.index_to_coordinates(i)) == -expected[i]);
+		REQUIRE(w.compare(arr3_2));
+		raw2[7] = 1000;
+		REQUIRE_FALSE(w.compare(arr3_2));
+		REQUIRE_FALSE(arr3_2.compare(w));
+		
+		// wraparound to wraparound
+		std::vector<int> raw3(len, 0);
+		ndarray_view<3, int> arr3_3(raw3.data(), make_ndsize(3, 4, 5));
+		auto w_3 = wraparound(arr3_3, make_ndptrdiff(1, 3, 0), make_ndptrdiff(4, 7, 5));
+		w_3.assign(w);
+		REQUIRE(w_3.compare(w));
+		REQUIRE(w.compare(w_3));
+		REQUIRE(elements(w_3) == elements(w));
+		
+		w.fill(3);
+		for(int v : raw) REQUIRE(v == 3);
+	}
+}